@@ -0,0 +1,30 @@
+# Particle effects, see src/fx/inc/ParticleSystem.h for the record syntax.
+# layer: name, sprite layer, texture, source rect (x y w h) in the texture
+layer blood blood assets/pictures/blood.png 0 0 16 16
+layer smoke smoke assets/pictures/khoi.png 0 0 24 24
+
+# a hit: short red spray that slows down and fades
+emitter blood_hit blood
+burst 14
+life 0.25 0.6
+speed 40 160
+angle 0 360
+size 7 3
+drag 5
+color 0 220 30 30 255
+color 0.6 150 10 10 220
+color 1 90 0 0 0
+
+# a death: grey puffs that keep coming for half a second, grow and drift up
+emitter death_smoke smoke
+burst 10
+rate 40
+duration 0.5
+life 0.6 1.2
+speed 10 45
+angle -90 120
+size 10 30
+drag 1.5
+gravity 0 -20
+color 0 200 200 200 210
+color 1 120 120 120 0
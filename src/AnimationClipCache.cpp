@@ -0,0 +1,96 @@
+#include "AnimationClipCache.h"
+#include "assets/inc/AssetPack.h"
+#include <SDL_image.h>
+#include <functional>
+
+size_t AnimationClipCache::KeyHash::operator()(const Key& key) const {
+    size_t h = std::hash<std::string>()(key.path);
+    auto mix = [&h](size_t v) { h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2); };
+    mix(std::hash<const void*>()(key.renderer));
+    mix((size_t)key.frame_width);
+    mix((size_t)key.frame_height);
+    mix((size_t)key.frame_count);
+    mix((size_t)key.columns);
+    return h;
+}
+
+std::unordered_map<AnimationClipCache::Key, AnimationClip*, AnimationClipCache::KeyHash>& AnimationClipCache::clips() {
+    static std::unordered_map<Key, AnimationClip*, KeyHash> map;
+    return map;
+}
+
+std::map<AnimationClipCache::SheetKey, SDL_Texture*>& AnimationClipCache::sheets() {
+    static std::map<SheetKey, SDL_Texture*> map;
+    return map;
+}
+
+SDL_Texture* AnimationClipCache::sheet_texture(SDL_Renderer* renderer, const std::string& sheet_path) {
+    SheetKey key(renderer, sheet_path);
+    auto it = sheets().find(key);
+    if (it != sheets().end()) return it->second;
+    // a missing sheet is cached too (nullptr), so it is not retried on every spawn
+    SDL_Texture* tex = nullptr;
+    SDL_Surface* surf = AssetPack::load_image(sheet_path);
+    if (!surf) {
+        SDL_Log("Failed to load %s: %s", sheet_path.c_str(), IMG_GetError());
+    } else {
+        tex = SDL_CreateTextureFromSurface(renderer, surf);
+        SDL_FreeSurface(surf);
+    }
+    sheets().emplace(std::move(key), tex);
+    return tex;
+}
+
+void AnimationClipCache::add_sheet(SDL_Renderer* renderer, const std::string& sheet_path, SDL_Surface* surface) {
+    SDL_Texture*& slot = sheets()[SheetKey(renderer, sheet_path)];
+    if (slot || !surface) return;
+    slot = SDL_CreateTextureFromSurface(renderer, surface);
+}
+
+bool AnimationClipCache::has_sheet(SDL_Renderer* renderer, const std::string& sheet_path) {
+    auto it = sheets().find(SheetKey(renderer, sheet_path));
+    return it != sheets().end() && it->second;
+}
+
+size_t AnimationClipCache::get_sheet_bytes(SDL_Renderer* renderer) {
+    size_t bytes = 0;
+    for (const auto& pair : sheets()) {
+        int w = 0, h = 0;
+        if (pair.first.first == renderer && pair.second && SDL_QueryTexture(pair.second, NULL, NULL, &w, &h) == 0) bytes += (size_t)w * h * 4;
+    }
+    return bytes;
+}
+
+const AnimationClip* AnimationClipCache::get(SDL_Renderer* renderer, const std::string& sheet_path,
+                                             int frame_width, int frame_height, int frame_count, int columns) {
+    if (columns < 1) columns = 1;
+    Key key{ renderer, sheet_path, frame_width, frame_height, frame_count, columns };
+    auto& map = clips();
+    auto it = map.find(key);
+    if (it != map.end()) return it->second;
+
+    AnimationClip* clip = new AnimationClip();
+    clip->frame_width = frame_width;
+    clip->frame_height = frame_height;
+
+    clip->texture = sheet_texture(renderer, sheet_path);
+
+    // Build frames row-major across columns
+    clip->frames.reserve(frame_count);
+    for (int i = 0; i < frame_count; ++i) {
+        int c = i % columns, r = i / columns;
+        clip->frames.push_back({ c * frame_width, r * frame_height, frame_width, frame_height });
+    }
+
+    map.emplace(std::move(key), clip);
+    return clip;
+}
+
+void AnimationClipCache::clear() {
+    for (auto& pair : clips()) delete pair.second;
+    clips().clear();
+    for (auto& pair : sheets()) {
+        if (pair.second) SDL_DestroyTexture(pair.second);
+    }
+    sheets().clear();
+}
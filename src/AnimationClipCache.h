@@ -0,0 +1,57 @@
+#pragma once
+#include <SDL.h>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// One loaded spritesheet cut into frames. Shared by every AnimatedSprite that
+// plays it; the cache owns the texture, the sprites only keep playback state.
+struct AnimationClip {
+    SDL_Texture* texture = nullptr; // nullptr if the sheet failed to load
+    std::vector<SDL_Rect> frames;
+    int frame_width = 0;
+    int frame_height = 0;
+};
+
+// Registry of animation clips keyed by (renderer, sheet path, frame layout), the
+// animation counterpart of ResourceManager. The first request for a clip pays
+// the IMG_Load + texture upload (unless add_sheet() already uploaded the sheet);
+// later spawns of the same effect are a lookup. Clips cut from the same sheet
+// share its texture. Everything lives until clear(), which must run before the
+// renderer is destroyed.
+class AnimationClipCache {
+public:
+    static const AnimationClip* get(SDL_Renderer* renderer, const std::string& sheet_path,
+                                    int frame_width, int frame_height, int frame_count, int columns = 1);
+    // Sheet decoded elsewhere (AssetLoader, off the render thread): uploads it so
+    // get() skips IMG_Load. Does not take ownership of `surface`.
+    static void add_sheet(SDL_Renderer* renderer, const std::string& sheet_path, SDL_Surface* surface);
+    static bool has_sheet(SDL_Renderer* renderer, const std::string& sheet_path);
+    // Texture memory of the sheets uploaded for `renderer`, 4 bytes per pixel.
+    // ResourceManager counts it toward its VRAM budget (sheets are never evicted).
+    static size_t get_sheet_bytes(SDL_Renderer* renderer);
+    static void clear();
+
+private:
+    struct Key {
+        SDL_Renderer* renderer;
+        std::string path;
+        int frame_width, frame_height, frame_count, columns;
+        bool operator==(const Key& other) const {
+            return renderer == other.renderer && path == other.path && frame_width == other.frame_width
+                && frame_height == other.frame_height && frame_count == other.frame_count && columns == other.columns;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    using SheetKey = std::pair<SDL_Renderer*, std::string>;
+
+    static std::unordered_map<Key, AnimationClip*, KeyHash>& clips();
+    // nullptr entries are sheets that failed to load, kept so they are not retried
+    static std::map<SheetKey, SDL_Texture*>& sheets();
+    static SDL_Texture* sheet_texture(SDL_Renderer* renderer, const std::string& sheet_path);
+};
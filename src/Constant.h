@@ -5,5 +5,9 @@
 #define WINDOW_H 720
 #define PI 3.14159265f
 #define BULLET_SPEED 500.0f
+#define SIM_TICK_HZ 120 // fixed simulation rate, see game/inc/FixedTimestep.h
 
 #define EXPLOSION_TEXTURE_PATH "assets/pictures/rielno.png"
+#define EFFECTS_PATH "assets/fx/effects.fx" // particle layers + emitters, see fx/inc/ParticleSystem.h
+#define ASSET_PACK_PATH "assets.gpak" // `make pack-assets`, see assets/inc/AssetPack.h; used when present
+#define IMAGE_CACHE_DIR ".imgcache" // decoded loose images, see assets/inc/ImageCache.h
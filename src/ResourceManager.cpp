@@ -0,0 +1,136 @@
+#include "ResourceManager.h"
+#include "assets/inc/AssetPack.h"
+#include "AnimationClipCache.h"
+#include <iostream>
+
+TextureRegion ResourceManager::load_texture(const std::string& id, const std::string& path) {
+    if (Entry* e = use(id)) return e->region;
+    SDL_Surface* surface = AssetPack::load_image(path);
+    if (!surface) return TextureRegion();
+    TextureRegion region = add_texture(id, surface);
+    SDL_FreeSurface(surface);
+    return region;
+}
+
+TextureRegion ResourceManager::load_sprite(const std::string& id, const std::string& path) {
+    if (Entry* e = use(id)) return e->region;
+    SDL_Surface* surface = AssetPack::load_image(path);
+    if (!surface) return TextureRegion();
+    TextureRegion region = add_sprite(id, surface);
+    SDL_FreeSurface(surface);
+    return region;
+}
+
+TextureRegion ResourceManager::add_texture(const std::string& id, SDL_Surface* surface) {
+    if (Entry* e = use(id)) return e->region;
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(_renderer, surface);
+    if (!tex) return TextureRegion();
+    return insert(id, TextureRegion(tex));
+}
+
+TextureRegion ResourceManager::add_sprite(const std::string& id, SDL_Surface* surface) {
+    if (Entry* e = use(id)) return e->region;
+    TextureRegion region = _atlas.add(surface);
+    if (!region) region = TextureRegion(SDL_CreateTextureFromSurface(_renderer, surface));
+    if (!region) return TextureRegion();
+    return insert(id, region);
+}
+
+TextureRegion ResourceManager::add_solid(const std::string& id, int w, int h, SDL_Color color) {
+    if (Entry* e = use(id)) return e->region;
+    TextureRegion region = _atlas.add_solid(w, h, color);
+    if (!region) return TextureRegion();
+    return insert(id, region);
+}
+
+bool ResourceManager::has_texture(const std::string& id) {
+    return use(id) != nullptr;
+}
+
+TextureRegion ResourceManager::get_texture(const std::string& id) {
+    Entry* e = use(id);
+    return e ? e->region : TextureRegion();
+}
+
+void ResourceManager::begin_scope() {
+    _scopes.emplace_back();
+}
+
+void ResourceManager::end_scope() {
+    if (_scopes.empty()) {
+        std::cerr << "ResourceManager: end_scope() without begin_scope()\n";
+        return;
+    }
+    for (const std::string& id : _scopes.back()) {
+        auto it = _textures.find(id);
+        if (it != _textures.end() && it->second.refs > 0) --it->second.refs;
+    }
+    _scopes.pop_back();
+    // what the scope was holding may now be over budget
+    trim();
+}
+
+int ResourceManager::get_ref_count(const std::string& id) const {
+    auto it = _textures.find(id);
+    return (it != _textures.end()) ? it->second.refs : 0;
+}
+
+size_t ResourceManager::get_bytes() const {
+    const size_t page = (size_t)TextureAtlas::PAGE_SIZE;
+    return _texture_bytes + (size_t)_atlas.get_page_count() * page * page * 4 + AnimationClipCache::get_sheet_bytes(_renderer);
+}
+
+void ResourceManager::unload_all() {
+    // atlas pages are shared by many ids; only whole textures are ours to destroy one by one
+    for (auto& pair : _textures) if (pair.second.region.is_whole()) SDL_DestroyTexture(pair.second.region.texture);
+    _textures.clear();
+    _atlas.clear();
+    _texture_bytes = 0;
+    // the references went with the entries; a reload inside an open scope takes a new one
+    for (auto& scope : _scopes) scope.clear();
+}
+
+ResourceManager::Entry* ResourceManager::use(const std::string& id) {
+    auto it = _textures.find(id);
+    if (it == _textures.end()) return nullptr;
+    Entry& e = it->second;
+    e.last_use = ++_use_clock;
+    // first use under the innermost scope takes its reference, once per scope
+    if (!_scopes.empty() && _scopes.back().insert(id).second) ++e.refs;
+    return &e;
+}
+
+TextureRegion ResourceManager::insert(const std::string& id, const TextureRegion& region) {
+    Entry& e = _textures[id];
+    e.region = region;
+    if (region.is_whole()) {
+        int w = 0, h = 0;
+        region.get_size(w, h);
+        e.bytes = (size_t)w * (size_t)h * 4;
+        _texture_bytes += e.bytes;
+    }
+    use(id);
+    // never the one being returned, referenced or not
+    trim(&e);
+    return region;
+}
+
+void ResourceManager::trim(const Entry* keep) {
+    size_t bytes = get_bytes();
+    while (bytes > _budget) {
+        // a few dozen entries at most, so a scan beats keeping an ordered list in sync
+        auto victim = _textures.end();
+        for (auto it = _textures.begin(); it != _textures.end(); ++it) {
+            const Entry& e = it->second;
+            if (e.refs > 0 || !e.region.is_whole() || &e == keep) continue;
+            if (victim == _textures.end() || e.last_use < victim->second.last_use) victim = it;
+        }
+        // everything left is in use, in the atlas or a sheet: stay over budget rather than pull it out from under a scope
+        if (victim == _textures.end()) return;
+        SDL_DestroyTexture(victim->second.region.texture);
+        _texture_bytes -= victim->second.bytes;
+        bytes -= victim->second.bytes;
+        _textures.erase(victim);
+        ++_evicted;
+    }
+}
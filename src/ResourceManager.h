@@ -1,8 +1,13 @@
 #pragma once
 #include <SDL.h>
 #include <SDL_image.h>
+#include "assets/inc/TextureAtlas.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 enum Resources {
     PLAYER_1,
@@ -16,32 +21,95 @@ const std::unordered_map<Resources, std::string> RESOURCES_NAME {
     {BULLET, "bullet"}
 };
 
+// Textures by id, kept for the whole process so going back to the menu and
+// starting another match finds everything already uploaded.
+//
+// load_texture() gives an image its own texture (backgrounds, menu art);
+// load_sprite() and add_solid() put it in the shared atlas instead, which is
+// what anything drawn many times per frame through SpriteBatch wants.
+// get_texture() returns a TextureRegion either way.
+//
+// Lifetime: whoever draws a texture holds a scope (the menu, a stage). Every
+// id loaded or looked up while a scope is open gets one reference from it,
+// dropped when the scope ends. Unreferenced textures stay cached, and only
+// when the estimated VRAM use goes over the budget are the least recently
+// used of them destroyed. Atlas sprites are never evicted one by one: they
+// share pages, which stay until unload_all(). Animation sheets are not
+// evicted either (AnimationClipCache owns them and its clips point straight at
+// the textures), but their bytes count toward the budget, so a large sheet
+// pushes cached textures out instead of going unaccounted.
 class ResourceManager {
 public:
-    ResourceManager(SDL_Renderer* renderer) : _renderer(renderer) {}
+    static constexpr size_t DEFAULT_BUDGET_BYTES = (size_t)256 << 20;
+
+    // RAII begin_scope() / end_scope()
+    class Scope {
+    public:
+        explicit Scope(ResourceManager& rm) : _rm(rm) { _rm.begin_scope(); }
+        ~Scope() { _rm.end_scope(); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        ResourceManager& _rm;
+    };
+
+    explicit ResourceManager(SDL_Renderer* renderer, size_t budget_bytes = DEFAULT_BUDGET_BYTES)
+        : _renderer(renderer), _atlas(renderer), _budget(budget_bytes) {}
     ~ResourceManager() { unload_all(); }
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+
+    TextureRegion load_texture(const std::string& id, const std::string& path);
+    // Atlas-backed; an image too large for a page falls back to its own texture
+    TextureRegion load_sprite(const std::string& id, const std::string& path);
+    // Same as load_texture / load_sprite for an image decoded elsewhere (AssetLoader).
+    // Upload only; the surface stays the caller's.
+    TextureRegion add_texture(const std::string& id, SDL_Surface* surface);
+    TextureRegion add_sprite(const std::string& id, SDL_Surface* surface);
+    // Solid-color w x h sprite in the atlas (placeholders, walls)
+    TextureRegion add_solid(const std::string& id, int w, int h, SDL_Color color);
+
+    // Cached under `id` (counts as a use, like get_texture)
+    bool has_texture(const std::string& id);
+    TextureRegion get_texture(const std::string& id);
+
+    // Nested scopes are fine; each holds its own references
+    void begin_scope();
+    void end_scope();
+    int get_ref_count(const std::string& id) const;
 
-    SDL_Texture* load_texture(const std::string& id, const std::string& path) {
-        if (_textures.count(id)) return _textures[id];
-        SDL_Surface* surface = IMG_Load(path.c_str());
-        if (!surface) return nullptr;
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(_renderer, surface);
-        SDL_FreeSurface(surface);
-        if (tex) _textures[id] = tex;
-        return tex;
-    }
-
-    SDL_Texture* get_texture(const std::string& id) const {
-        auto it = _textures.find(id);
-        return (it != _textures.end()) ? it->second : nullptr;
-    }
-
-    void unload_all() {
-        for (auto& pair : _textures) SDL_DestroyTexture(pair.second);
-        _textures.clear();
-    }
+    // Estimated VRAM: own textures at 4 bytes per pixel, every atlas page, and the
+    // animation sheets in AnimationClipCache
+    size_t get_bytes() const;
+    size_t get_budget() const { return _budget; }
+    void set_budget(size_t bytes) { _budget = bytes; trim(); }
+    size_t get_evicted_count() const { return _evicted; }
+    const TextureAtlas& get_atlas() const { return _atlas; }
+
+    void unload_all();
 
 private:
+    struct Entry {
+        TextureRegion region;
+        size_t bytes = 0;          // own texture only; atlas sprites are counted with their page
+        int refs = 0;
+        uint64_t last_use = 0;
+    };
+
+    // Looks up `id`, marking it used and referenced by the open scope; nullptr if absent
+    Entry* use(const std::string& id);
+    TextureRegion insert(const std::string& id, const TextureRegion& region);
+    // Evicts unreferenced own textures, least recently used first, until under budget
+    void trim(const Entry* keep = nullptr);
+
     SDL_Renderer* _renderer;
-    std::unordered_map<std::string, SDL_Texture*> _textures;
+    TextureAtlas _atlas;
+    std::unordered_map<std::string, Entry> _textures;
+    size_t _budget;
+    size_t _texture_bytes = 0;
+    size_t _evicted = 0;
+    uint64_t _use_clock = 0;
+
+    // ids each open scope holds a reference to, innermost last
+    std::vector<std::unordered_set<std::string>> _scopes;
 };
@@ -0,0 +1,109 @@
+#include "inc/AssetLoader.h"
+#include "inc/AssetPack.h"
+#include "ResourceManager.h"
+#include "AnimationClipCache.h"
+#include <SDL_image.h>
+#include <algorithm>
+#include <iostream>
+
+unsigned AssetLoader::default_thread_count() {
+    unsigned hw = std::thread::hardware_concurrency();
+    return std::clamp(hw > 1 ? hw - 1 : 1u, 1u, 4u);
+}
+
+AssetLoader::AssetLoader(SDL_Renderer* renderer, ResourceManager& rm, unsigned threads)
+    : _renderer(renderer), _rm(rm) {
+    if (threads == 0) threads = 1;
+    for (unsigned i = 0; i < threads; ++i) _threads.emplace_back(&AssetLoader::decode_main, this);
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _wake.notify_all();
+    for (auto& t : _threads) t.join();
+    for (auto& d : _decoded) {
+        if (d.second) SDL_FreeSurface(d.second);
+    }
+}
+
+void AssetLoader::queue_texture(const std::string& id, const std::string& path) {
+    if (!_rm.has_texture(id)) queue(Kind::TEXTURE, id, path);
+}
+
+void AssetLoader::queue_sprite(const std::string& id, const std::string& path) {
+    if (!_rm.has_texture(id)) queue(Kind::SPRITE, id, path);
+}
+
+void AssetLoader::queue_sheet(const std::string& path) {
+    if (!AnimationClipCache::has_sheet(_renderer, path)) queue(Kind::SHEET, path, path);
+}
+
+void AssetLoader::queue(Kind kind, const std::string& id, const std::string& path) {
+    _requests.push_back({ kind, id, path });
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _paths.push_back(path);
+    }
+    _wake.notify_one();
+}
+
+void AssetLoader::decode_main() {
+    std::string path;
+    for (;;) {
+        size_t index;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [this] { return _quit || _next_decode < _paths.size(); });
+            if (_quit) return;
+            index = _next_decode++;
+            path = _paths[index];
+        }
+        // the slow part: inflate + convert to the format the atlas and textures use, no SDL render calls
+        // (neither for a pre-decoded image from the asset pack)
+        SDL_Surface* surface = AssetPack::load_image(path);
+        if (surface && surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+            SDL_Surface* argb = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            if (argb) {
+                SDL_FreeSurface(surface);
+                surface = argb;
+            }
+        }
+        if (!surface) std::cerr << "AssetLoader: cannot decode " << path << ": " << IMG_GetError() << "\n";
+        std::lock_guard<std::mutex> lock(_mutex);
+        _decoded.emplace_back(index, surface);
+    }
+}
+
+bool AssetLoader::pump(double budget_ms) {
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const double ticks_per_ms = (double)SDL_GetPerformanceFrequency() / 1000.0;
+    while (!is_done()) {
+        std::pair<size_t, SDL_Surface*> item;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_decoded.empty()) break;
+            item = _decoded.front();
+            _decoded.erase(_decoded.begin());
+        }
+        const Request& req = _requests[item.first];
+        SDL_Surface* surface = item.second;
+        if (surface) {
+            bool ok = true;
+            switch (req.kind) {
+                case Kind::TEXTURE: ok = (bool)_rm.add_texture(req.id, surface); break;
+                case Kind::SPRITE: ok = (bool)_rm.add_sprite(req.id, surface); break;
+                case Kind::SHEET: AnimationClipCache::add_sheet(_renderer, req.path, surface); break;
+            }
+            if (!ok) ++_failed;
+            SDL_FreeSurface(surface);
+        } else {
+            ++_failed;
+        }
+        ++_uploaded;
+        if ((double)(SDL_GetPerformanceCounter() - start) / ticks_per_ms >= budget_ms) break;
+    }
+    return is_done();
+}
@@ -0,0 +1,183 @@
+#include "inc/AssetPack.h"
+#include "inc/ImageCache.h"
+#include <SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+static const char PACK_MAGIC[4] = { 'G', 'P', 'A', 'K' };
+
+// the header and table are read straight out of the mapping
+static_assert(std::is_trivially_copyable<AssetPackHeader>::value && sizeof(AssetPackHeader) == 32, "AssetPackHeader layout");
+static_assert(std::is_trivially_copyable<AssetPackEntry>::value && sizeof(AssetPackEntry) == 48, "AssetPackEntry layout");
+
+static size_t align_up(size_t n, size_t a) {
+    return (n + a - 1) & ~(a - 1);
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    if (!_file.open(path)) {
+        std::cerr << "AssetPack: cannot map " << path << "\n";
+        return false;
+    }
+    const uint8_t* data = _file.data();
+    const size_t size = _file.size();
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(data);
+    if (size < sizeof(AssetPackHeader) || std::memcmp(header->magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header->version != VERSION) {
+        std::cerr << "AssetPack: " << path << " is not a version " << VERSION << " asset pack\n";
+        _file.close();
+        return false;
+    }
+    const uint64_t toc_end = sizeof(AssetPackHeader) + (uint64_t)header->entry_count * sizeof(AssetPackEntry);
+    bool ok = toc_end <= header->names_offset && (uint64_t)header->names_offset + header->names_size <= size;
+    const AssetPackEntry* entries = reinterpret_cast<const AssetPackEntry*>(data + sizeof(AssetPackHeader));
+    for (uint32_t i = 0; ok && i < header->entry_count; ++i) {
+        const AssetPackEntry& e = entries[i];
+        ok = (uint64_t)e.name_offset + e.name_size <= header->names_size
+          && e.offset % ALIGNMENT == 0 && e.offset + e.size <= size && e.offset + e.size >= e.offset;
+        if (ok && e.kind == AssetPackKind::PIXELS) {
+            ok = e.width > 0 && e.height > 0 && e.pitch >= (uint64_t)e.width * 4 && (uint64_t)e.pitch * e.height <= e.size;
+        }
+    }
+    if (!ok) {
+        std::cerr << "AssetPack: " << path << " has a corrupt table\n";
+        _file.close();
+        return false;
+    }
+    _header = header;
+    _entries = entries;
+    _names = reinterpret_cast<const char*>(data + header->names_offset);
+    return true;
+}
+
+const AssetPackEntry* AssetPack::find(const std::string& name) const {
+    if (!_header) return nullptr;
+    const AssetPackEntry* end = _entries + _header->entry_count;
+    const AssetPackEntry* it = std::lower_bound(_entries, end, name, [this](const AssetPackEntry& e, const std::string& n) {
+        return std::string_view(_names + e.name_offset, e.name_size) < n;
+    });
+    if (it == end || std::string_view(_names + it->name_offset, it->name_size) != name) return nullptr;
+    return it;
+}
+
+SDL_RWops* AssetPack::open_rw(const std::string& name) const {
+    const AssetPackEntry* e = find(name);
+    if (!e) return nullptr;
+    return SDL_RWFromConstMem(get_data(*e), (int)e->size);
+}
+
+SDL_Surface* AssetPack::load_surface(const std::string& name) const {
+    const AssetPackEntry* e = find(name);
+    if (!e) return nullptr;
+    if (e->kind == AssetPackKind::PIXELS) {
+        // SDL only reads a surface's pixels when uploading or converting it
+        void* pixels = const_cast<uint8_t*>(get_data(*e));
+        return SDL_CreateRGBSurfaceWithFormatFrom(pixels, e->width, e->height, 32, (int)e->pitch, e->format);
+    }
+    SDL_RWops* rw = SDL_RWFromConstMem(get_data(*e), (int)e->size);
+    return rw ? IMG_Load_RW(rw, 1) : nullptr;
+}
+
+bool AssetPack::write(const std::string& path, std::vector<Source>& sources) {
+    std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) { return a.name < b.name; });
+
+    AssetPackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = VERSION;
+    header.entry_count = (uint32_t)sources.size();
+    header.names_offset = (uint32_t)(sizeof(AssetPackHeader) + sources.size() * sizeof(AssetPackEntry));
+
+    std::vector<AssetPackEntry> entries(sources.size());
+    std::string names;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        AssetPackEntry& e = entries[i];
+        std::memset(&e, 0, sizeof(e));
+        e.name_offset = (uint32_t)names.size();
+        e.name_size = (uint32_t)sources[i].name.size();
+        e.kind = sources[i].kind;
+        e.format = sources[i].format;
+        e.width = sources[i].width;
+        e.height = sources[i].height;
+        e.pitch = (uint32_t)sources[i].pitch;
+        e.size = sources[i].bytes.size();
+        names += sources[i].name;
+    }
+    header.names_size = (uint32_t)names.size();
+    size_t offset = align_up((size_t)header.names_offset + names.size(), ALIGNMENT);
+    for (AssetPackEntry& e : entries) {
+        e.offset = offset;
+        offset = align_up(offset + (size_t)e.size, ALIGNMENT);
+    }
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "AssetPack: cannot write " << path << "\n";
+        return false;
+    }
+    static const uint8_t zeros[ALIGNMENT] = {};
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = ok && (entries.empty() || std::fwrite(entries.data(), sizeof(AssetPackEntry), entries.size(), f) == entries.size());
+    ok = ok && std::fwrite(names.data(), 1, names.size(), f) == names.size();
+    size_t at = (size_t)header.names_offset + names.size();
+    for (size_t i = 0; ok && i < entries.size(); ++i) {
+        ok = std::fwrite(zeros, 1, entries[i].offset - at, f) == entries[i].offset - at;
+        ok = ok && std::fwrite(sources[i].bytes.data(), 1, sources[i].bytes.size(), f) == sources[i].bytes.size();
+        at = entries[i].offset + sources[i].bytes.size();
+    }
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok) std::cerr << "AssetPack: failed writing " << path << "\n";
+    return ok;
+}
+
+// mounted once at startup, before any loader thread exists; read-only afterwards
+static std::unique_ptr<AssetPack> g_mounted;
+
+bool AssetPack::mount(const std::string& path) {
+    std::unique_ptr<AssetPack> pack(new AssetPack());
+    if (!pack->open(path)) return false;
+    g_mounted = std::move(pack);
+    return true;
+}
+
+void AssetPack::unmount() {
+    g_mounted.reset();
+}
+
+const AssetPack* AssetPack::mounted() {
+    return g_mounted.get();
+}
+
+SDL_Surface* AssetPack::load_image(const std::string& path) {
+    if (g_mounted) {
+        if (SDL_Surface* surface = g_mounted->load_surface(path)) return surface;
+    }
+    return ImageCache::load(path);
+}
+
+SDL_RWops* AssetPack::open_file(const std::string& path) {
+    if (g_mounted) {
+        if (SDL_RWops* rw = g_mounted->open_rw(path)) return rw;
+    }
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+bool AssetPack::read_file(const std::string& path, std::string& out) {
+    if (g_mounted) {
+        if (const AssetPackEntry* e = g_mounted->find(path)) {
+            out.assign(reinterpret_cast<const char*>(g_mounted->get_data(*e)), (size_t)e->size);
+            return true;
+        }
+    }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
@@ -0,0 +1,144 @@
+#include "inc/ImageCache.h"
+#include "io/inc/MappedFile.h"
+#include "Constant.h"
+#include <SDL_image.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+static const char CACHE_MAGIC[4] = { 'G', 'P', 'I', 'C' };
+static const size_t PIXELS_ALIGNMENT = 64;
+
+static_assert(std::is_trivially_copyable<ImageCacheHeader>::value && sizeof(ImageCacheHeader) == 64, "ImageCacheHeader layout");
+
+static std::string g_directory = IMAGE_CACHE_DIR;
+static std::atomic<size_t> g_hits{ 0 };
+static std::atomic<size_t> g_misses{ 0 };
+
+void ImageCache::set_directory(const std::string& dir) {
+    g_directory = dir;
+}
+
+const std::string& ImageCache::get_directory() {
+    return g_directory;
+}
+
+size_t ImageCache::get_hit_count() {
+    return g_hits.load();
+}
+
+size_t ImageCache::get_miss_count() {
+    return g_misses.load();
+}
+
+// FNV-1a: stable across runs and platforms, which std::hash is not required to be
+static std::string entry_path(const std::string& source) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : source) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx.img", (unsigned long long)h);
+    return g_directory + name;
+}
+
+// Copies the entry's pixels into a new surface; nullptr if it is missing, stale or not ours
+static SDL_Surface* read_entry(const std::string& file, const std::string& source, const struct stat& st) {
+    MappedFile map;
+    if (!map.open(file) || map.size() < sizeof(ImageCacheHeader)) return nullptr;
+    const ImageCacheHeader* h = reinterpret_cast<const ImageCacheHeader*>(map.data());
+    if (std::memcmp(h->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || h->version != ImageCache::VERSION) return nullptr;
+    if (h->source_size != (uint64_t)st.st_size || h->source_mtime != (int64_t)st.st_mtime) return nullptr;
+    // only what write_entry() produces; anything else is decoded again rather than trusted
+    if (h->format != SDL_PIXELFORMAT_ARGB8888 || h->width <= 0 || h->height <= 0 || h->pitch != (uint32_t)h->width * 4) return nullptr;
+    if (sizeof(ImageCacheHeader) + (uint64_t)h->path_size > map.size() || h->path_size != source.size()
+        || std::memcmp(map.data() + sizeof(ImageCacheHeader), source.data(), source.size()) != 0) return nullptr;
+    if ((uint64_t)h->pixels_offset + (uint64_t)h->pitch * h->height > map.size()) return nullptr;
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, h->width, h->height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) return nullptr;
+    const uint8_t* src = map.data() + h->pixels_offset;
+    uint8_t* dst = static_cast<uint8_t*>(surface->pixels);
+    if ((uint32_t)surface->pitch == h->pitch) {
+        std::memcpy(dst, src, (size_t)h->pitch * h->height);
+    } else {
+        for (int y = 0; y < h->height; ++y) std::memcpy(dst + (size_t)y * surface->pitch, src + (size_t)y * h->pitch, h->pitch);
+    }
+    return surface;
+}
+
+// Best effort: a failed write only means the next start decodes again
+static void write_entry(const std::string& file, const std::string& source, const struct stat& st, SDL_Surface* argb) {
+#ifdef _WIN32
+    _mkdir(g_directory.c_str());
+#else
+    mkdir(g_directory.c_str(), 0755);
+#endif
+    ImageCacheHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    h.version = ImageCache::VERSION;
+    h.source_size = (uint64_t)st.st_size;
+    h.source_mtime = (int64_t)st.st_mtime;
+    h.format = SDL_PIXELFORMAT_ARGB8888;
+    h.width = argb->w;
+    h.height = argb->h;
+    h.pitch = (uint32_t)argb->w * 4;
+    h.path_size = (uint32_t)source.size();
+    h.pixels_offset = (uint32_t)((sizeof(h) + source.size() + PIXELS_ALIGNMENT - 1) & ~(PIXELS_ALIGNMENT - 1));
+
+    // written next to the entry and renamed over it, so a reader never maps half a file
+    const std::string tmp = file + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return;
+    static const uint8_t zeros[PIXELS_ALIGNMENT] = {};
+    const size_t pad = h.pixels_offset - sizeof(h) - source.size();
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1
+           && std::fwrite(source.data(), 1, source.size(), f) == source.size()
+           && std::fwrite(zeros, 1, pad, f) == pad;
+    const uint8_t* rows = static_cast<const uint8_t*>(argb->pixels);
+    for (int y = 0; ok && y < argb->h; ++y) ok = std::fwrite(rows + (size_t)y * argb->pitch, 1, h.pitch, f) == h.pitch;
+    ok = std::fclose(f) == 0 && ok;
+    if (ok) {
+        std::remove(file.c_str()); // rename() does not replace on Windows
+        ok = std::rename(tmp.c_str(), file.c_str()) == 0;
+    }
+    if (!ok) {
+        std::remove(tmp.c_str());
+        std::cerr << "ImageCache: cannot write " << file << "\n";
+    }
+}
+
+SDL_Surface* ImageCache::load(const std::string& path) {
+    struct stat st;
+    if (g_directory.empty() || stat(path.c_str(), &st) != 0) return IMG_Load(path.c_str());
+
+    const std::string file = entry_path(path);
+    if (SDL_Surface* cached = read_entry(file, path, st)) {
+        ++g_hits;
+        return cached;
+    }
+
+    SDL_Surface* surface = IMG_Load(path.c_str());
+    if (!surface) return nullptr;
+    // store what every consumer converts to anyway, and hand that back
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* argb = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!argb) return surface;
+        SDL_FreeSurface(surface);
+        surface = argb;
+    }
+    ++g_misses;
+    if (SDL_MUSTLOCK(surface)) SDL_LockSurface(surface);
+    write_entry(file, path, st, surface);
+    if (SDL_MUSTLOCK(surface)) SDL_UnlockSurface(surface);
+    return surface;
+}
@@ -0,0 +1,107 @@
+#include "inc/TextureAtlas.h"
+#include <algorithm>
+#include <iostream>
+
+TextureRegion TextureAtlas::add(SDL_Surface* surface) {
+    if (!surface || !_renderer || !fits(surface->w, surface->h)) return TextureRegion();
+
+    // pages are ARGB8888; convert anything else (paletted PNG, RGB JPG) first
+    SDL_Surface* argb = surface;
+    if (surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        argb = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        if (!argb) {
+            std::cerr << "TextureAtlas: cannot convert surface: " << SDL_GetError() << "\n";
+            return TextureRegion();
+        }
+    }
+
+    TextureRegion region;
+    int page;
+    SDL_Rect at;
+    if (place(argb->w + 2 * PADDING, argb->h + 2 * PADDING, page, at)) {
+        if (SDL_MUSTLOCK(argb)) SDL_LockSurface(argb);
+        region = upload(page, at, static_cast<const Uint32*>(argb->pixels), argb->w, argb->h, argb->pitch / 4);
+        if (SDL_MUSTLOCK(argb)) SDL_UnlockSurface(argb);
+    }
+    if (argb != surface) SDL_FreeSurface(argb);
+    return region;
+}
+
+TextureRegion TextureAtlas::add_solid(int w, int h, SDL_Color color) {
+    if (!_renderer || w <= 0 || h <= 0 || !fits(w, h)) return TextureRegion();
+    int page;
+    SDL_Rect at;
+    if (!place(w + 2 * PADDING, h + 2 * PADDING, page, at)) return TextureRegion();
+    Uint32 argb = ((Uint32)color.a << 24) | ((Uint32)color.r << 16) | ((Uint32)color.g << 8) | color.b;
+    // one row repeated: pitch 0 reads the same w pixels for every line
+    std::vector<Uint32> row((size_t)w, argb);
+    return upload(page, at, row.data(), w, h, 0);
+}
+
+void TextureAtlas::clear() {
+    for (Page& p : _pages) {
+        if (p.texture) SDL_DestroyTexture(p.texture);
+    }
+    _pages.clear();
+    _sprites = 0;
+}
+
+bool TextureAtlas::place(int w, int h, int& page, SDL_Rect& at) {
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t p = 0; p < _pages.size(); ++p) {
+            Page& pg = _pages[p];
+            // best fit: the lowest shelf that is tall enough and still has the width
+            Shelf* best = nullptr;
+            for (Shelf& s : pg.shelves) {
+                if (s.height >= h && _page_size - s.used_w >= w && (!best || s.height < best->height)) best = &s;
+            }
+            // a much taller shelf wastes its height; open a new one if there is room
+            if ((!best || best->height > h * 2) && pg.used_h + h <= _page_size) {
+                pg.shelves.push_back({ pg.used_h, h, 0 });
+                pg.used_h += h;
+                best = &pg.shelves.back();
+            }
+            if (!best) continue;
+            at = { best->used_w, best->y, w, h };
+            best->used_w += w;
+            page = (int)p;
+            return true;
+        }
+        // every page is full: open one and try again
+        if (pass == 0 && !add_page()) return false;
+    }
+    return false;
+}
+
+bool TextureAtlas::add_page() {
+    SDL_Texture* tex = SDL_CreateTexture(_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, _page_size, _page_size);
+    if (!tex) {
+        std::cerr << "TextureAtlas: cannot create a " << _page_size << "x" << _page_size << " page: " << SDL_GetError() << "\n";
+        return false;
+    }
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    // texture memory starts undefined; the gaps between sprites must be transparent
+    std::vector<Uint32> zero((size_t)_page_size * _page_size, 0);
+    SDL_UpdateTexture(tex, NULL, zero.data(), _page_size * 4);
+    Page page;
+    page.texture = tex;
+    _pages.push_back(std::move(page));
+    return true;
+}
+
+TextureRegion TextureAtlas::upload(int page, const SDL_Rect& at, const Uint32* pixels, int w, int h, int pitch) {
+    // clamp-to-edge copy: the padding ring repeats the sprite's border pixels
+    const int pw = w + 2 * PADDING, ph = h + 2 * PADDING;
+    _scratch.resize((size_t)pw * ph);
+    for (int y = 0; y < ph; ++y) {
+        const Uint32* src_row = pixels + (size_t)std::clamp(y - PADDING, 0, h - 1) * pitch;
+        Uint32* dst_row = _scratch.data() + (size_t)y * pw;
+        for (int x = 0; x < pw; ++x) dst_row[x] = src_row[std::clamp(x - PADDING, 0, w - 1)];
+    }
+    if (SDL_UpdateTexture(_pages[page].texture, &at, _scratch.data(), pw * 4) != 0) {
+        std::cerr << "TextureAtlas: upload failed: " << SDL_GetError() << "\n";
+        return TextureRegion();
+    }
+    ++_sprites;
+    return TextureRegion(_pages[page].texture, SDL_Rect{ at.x + PADDING, at.y + PADDING, w, h });
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <SDL.h>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ResourceManager;
+
+// Streams images in without freezing the window. Decoding (IMG_Load + the
+// conversion to ARGB8888) runs on a few background threads; SDL render calls
+// are only legal on the render thread, so the upload happens in pump(), which
+// the menu calls once per frame with a time budget and which stops as soon as
+// the budget is spent. Progress is uploaded / queued.
+//
+// Each request ends up where the synchronous path would have put it
+// (ResourceManager texture or atlas sprite, AnimationClipCache sheet), so later
+// load_texture / load_sprite / AnimatedSprite calls for the same asset are plain
+// lookups, and anything that was not queued still loads the old way.
+class AssetLoader {
+public:
+    static constexpr double DEFAULT_BUDGET_MS = 4.0;
+
+    // hardware threads minus the render thread, at least 1, at most 4
+    static unsigned default_thread_count();
+
+    AssetLoader(SDL_Renderer* renderer, ResourceManager& rm, unsigned threads = default_thread_count());
+    // Stops the decoders; whatever was not uploaded yet is dropped
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // ResourceManager::load_texture / load_sprite / AnimationClipCache sheet, in the background.
+    // Ids already in `rm` (and sheets already cached) are skipped.
+    void queue_texture(const std::string& id, const std::string& path);
+    void queue_sprite(const std::string& id, const std::string& path);
+    void queue_sheet(const std::string& path);
+
+    // Render thread: uploads decoded images until `budget_ms` has passed
+    // (at least one per call). true once every queued request is done.
+    bool pump(double budget_ms = DEFAULT_BUDGET_MS);
+
+    bool is_done() const { return _uploaded == _requests.size(); }
+    float get_progress() const { return _requests.empty() ? 1.0f : (float)_uploaded / (float)_requests.size(); }
+    size_t get_failed_count() const { return _failed; }
+
+private:
+    enum class Kind { TEXTURE, SPRITE, SHEET };
+
+    struct Request {
+        Kind kind;
+        std::string id;
+        std::string path;
+    };
+
+    void queue(Kind kind, const std::string& id, const std::string& path);
+    void decode_main();
+
+    SDL_Renderer* _renderer;
+    ResourceManager& _rm;
+
+    // render thread only
+    std::vector<Request> _requests;
+    size_t _uploaded = 0;
+    size_t _failed = 0;
+
+    // shared with the decoders, guarded by _mutex
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::vector<std::string> _paths; // copy of each request's path for the decoders, queue order
+    size_t _next_decode = 0;         // first path no decoder has taken yet
+    std::vector<std::pair<size_t, SDL_Surface*>> _decoded; // (request, surface), nullptr = decode failed
+    bool _quit = false;
+
+    std::vector<std::thread> _threads;
+};
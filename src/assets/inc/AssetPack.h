@@ -0,0 +1,106 @@
+#pragma once
+
+#include "io/inc/MappedFile.h"
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Every asset in one file (tools/asset_pack, `make pack-assets`), so a cold
+// start costs one open + one mmap instead of an open per PNG and per font
+// candidate. Layout:
+//
+//   AssetPackHeader
+//   AssetPackEntry[entry_count]   sorted by name, for binary search
+//   names                         entry names, not NUL-terminated
+//   blobs                         each ALIGNMENT-aligned
+//
+// A blob is either the file's bytes as they were (fonts, effect files, images
+// packed without --decode) or an image already decoded to ARGB8888, the format
+// the atlas and textures use, so loading it is neither inflate nor conversion.
+// Names are the paths the game asks for ("assets/pictures/bulletA.png").
+// Native-endian, like cooked arenas.
+struct AssetPackHeader {
+    char magic[4]; // "GPAK"
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t names_offset;
+    uint32_t names_size;
+    uint32_t reserved[3];
+};
+
+enum class AssetPackKind : uint32_t {
+    FILE = 0, // raw bytes of the source file
+    PIXELS,   // width x height pixels of `format`, `pitch` bytes per row
+};
+
+struct AssetPackEntry {
+    uint32_t name_offset; // into the names block
+    uint32_t name_size;
+    AssetPackKind kind;
+    uint32_t format; // SDL_PixelFormatEnum for PIXELS, 0 for FILE
+    uint64_t offset; // bytes from the start of the pack
+    uint64_t size;
+    int32_t width, height;
+    uint32_t pitch;
+    uint32_t reserved;
+};
+
+class AssetPack {
+public:
+    static constexpr uint32_t VERSION = 1;
+    // blob alignment: whole cache lines, and enough for any SIMD load of the pixels
+    static constexpr size_t ALIGNMENT = 64;
+
+    // One asset for write(); bytes are FILE contents or PIXELS rows
+    struct Source {
+        std::string name;
+        AssetPackKind kind = AssetPackKind::FILE;
+        uint32_t format = 0;
+        int width = 0, height = 0, pitch = 0;
+        std::vector<uint8_t> bytes;
+    };
+
+    AssetPack() = default;
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // Maps the pack and checks its header and table; false (and a message) otherwise
+    bool open(const std::string& path);
+    void close() { _file.close(); _header = nullptr; _entries = nullptr; _names = nullptr; }
+    bool is_open() const { return _header != nullptr; }
+
+    const AssetPackEntry* find(const std::string& name) const;
+    const uint8_t* get_data(const AssetPackEntry& entry) const { return _file.data() + entry.offset; }
+    size_t get_entry_count() const { return _header ? _header->entry_count : 0; }
+
+    // Read-only SDL_RWops over the entry, no copy. nullptr if `name` is not packed.
+    SDL_RWops* open_rw(const std::string& name) const;
+    // PIXELS entries come back as a surface over the mapped pixels (no copy; must
+    // not be written to, valid while the pack is open), FILE entries go through
+    // IMG_Load_RW. nullptr if `name` is not packed or cannot be decoded.
+    SDL_Surface* load_surface(const std::string& name) const;
+
+    // Sorts `sources` by name and writes the pack
+    static bool write(const std::string& path, std::vector<Source>& sources);
+
+    // The pack the game runs from, if any. The helpers below try it first and
+    // fall back to the loose file, so without a pack nothing changes.
+    static bool mount(const std::string& path);
+    static void unmount();
+    static const AssetPack* mounted();
+
+    // IMG_Load(path): packed copy first, then the decoded copy in ImageCache
+    static SDL_Surface* load_image(const std::string& path);
+    // SDL_RWFromFile(path, "rb"), packed copy first (fonts: TTF_OpenFontRW(rw, 1, size))
+    static SDL_RWops* open_file(const std::string& path);
+    // Whole file as text (effect definitions)
+    static bool read_file(const std::string& path, std::string& out);
+
+private:
+    MappedFile _file;
+    const AssetPackHeader* _header = nullptr;
+    const AssetPackEntry* _entries = nullptr;
+    const char* _names = nullptr;
+};
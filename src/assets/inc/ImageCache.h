@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Decoded copies of loose images on disk, so a restart skips PNG inflate.
+// Each source image gets one file in the cache directory, named after a hash
+// of its path:
+//
+//   ImageCacheHeader
+//   source path                   path_size bytes, checked on load (hash collisions)
+//   pixels                        at pixels_offset (64-aligned), tightly packed rows
+//
+// An entry is fresh while the source's size and mtime match the header; a
+// fresh load is one mmap and one copy into the surface. Anything else (no
+// entry, stale, unreadable) decodes the source with IMG_Load and rewrites the
+// entry, so deleting the directory is always safe.
+//
+// Pixels are ARGB8888 with straight alpha, the format the atlas, textures and
+// asset pack already use.
+struct ImageCacheHeader {
+    char magic[4]; // "GPIC"
+    uint32_t version;
+    uint64_t source_size;
+    int64_t source_mtime; // seconds
+    uint32_t format;      // SDL_PixelFormatEnum
+    int32_t width, height;
+    uint32_t pitch;
+    uint32_t path_size;
+    uint32_t pixels_offset;
+    uint32_t reserved[4];
+};
+
+class ImageCache {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // Where entries live, created on first write; "" turns the cache off.
+    // Set before any loading starts (the AssetLoader threads read it).
+    static void set_directory(const std::string& dir);
+    static const std::string& get_directory();
+
+    // IMG_Load(path) through the cache. The surface is the caller's to free.
+    static SDL_Surface* load(const std::string& path);
+
+    // Loads served from / written to the cache since startup
+    static size_t get_hit_count();
+    static size_t get_miss_count();
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "TextureRegion.h"
+#include <SDL.h>
+#include <vector>
+
+// Packs small sprites (bullet sheet, buff icons, particle textures, solid
+// colors) into a few large pages at load time, so the batch sees one texture
+// where it used to see a dozen.
+//
+// Packing is shelf-based and incremental: each page is cut into horizontal
+// shelves, a sprite goes on the best-fitting shelf with room left (or opens a
+// new shelf, or a new page), and its pixels are uploaded right away with
+// SDL_UpdateTexture. So regions are valid as soon as add() returns and adding
+// more sprites later never moves the ones already handed out.
+//
+// Every sprite is surrounded by PADDING pixels copied from its own edge, so
+// linear filtering and sub-pixel positions never pull in a neighbour's pixels.
+class TextureAtlas {
+public:
+    static constexpr int PAGE_SIZE = 1024;
+    static constexpr int PADDING = 1;
+
+    explicit TextureAtlas(SDL_Renderer* renderer, int page_size = PAGE_SIZE)
+        : _renderer(renderer), _page_size(page_size) {}
+    ~TextureAtlas() { clear(); }
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Copies `surface` into a page. Empty region if it is larger than a page
+    // (the caller should give it its own texture) or nothing could be uploaded.
+    // The surface stays owned by the caller.
+    TextureRegion add(SDL_Surface* surface);
+    // w x h of one color (placeholder sprites, walls stretched over their hitbox)
+    TextureRegion add_solid(int w, int h, SDL_Color color);
+    bool fits(int w, int h) const { return w + 2 * PADDING <= _page_size && h + 2 * PADDING <= _page_size; }
+
+    // Destroys every page; regions handed out so far become dangling
+    void clear();
+    int get_page_count() const { return (int)_pages.size(); }
+    int get_sprite_count() const { return _sprites; }
+
+private:
+    struct Shelf {
+        int y, height;
+        int used_w;
+    };
+    struct Page {
+        SDL_Texture* texture = nullptr;
+        std::vector<Shelf> shelves;
+        int used_h = 0;
+    };
+
+    // Finds room for a w x h block (padding included); false if no page can take it
+    bool place(int w, int h, int& page, SDL_Rect& at);
+    bool add_page();
+    // Uploads w x h ARGB8888 pixels (`pitch` in pixels) into the block at `at`, padding included
+    TextureRegion upload(int page, const SDL_Rect& at, const Uint32* pixels, int w, int h, int pitch);
+
+    SDL_Renderer* _renderer;
+    int _page_size;
+    std::vector<Page> _pages;
+    std::vector<Uint32> _scratch; // padded copy of the sprite being uploaded
+    int _sprites = 0;
+};
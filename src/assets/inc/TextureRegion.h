@@ -0,0 +1,37 @@
+#pragma once
+
+#include <SDL_render.h>
+
+// What ResourceManager hands out for a sprite: a texture plus the rectangle of
+// it that holds the image. Small sprites share atlas pages, so two regions
+// with the same texture can be drawn in the same SpriteBatch call.
+// A plain SDL_Texture* converts to a region covering the whole texture
+// (rect.w == 0), so code that makes its own textures keeps working.
+struct TextureRegion {
+    SDL_Texture* texture = nullptr;
+    SDL_Rect rect = { 0, 0, 0, 0 }; // w == 0: the whole texture
+
+    TextureRegion() = default;
+    TextureRegion(SDL_Texture* whole_texture) : texture(whole_texture) {}
+    TextureRegion(SDL_Texture* page, const SDL_Rect& sub_rect) : texture(page), rect(sub_rect) {}
+
+    explicit operator bool() const { return texture != nullptr; }
+    bool is_whole() const { return rect.w == 0; }
+    // src argument for SDL_RenderCopy / SpriteBatch::draw
+    const SDL_Rect* get_src() const { return is_whole() ? nullptr : &rect; }
+    // Sprite size in pixels; false if there is no texture
+    bool get_size(int& w, int& h) const {
+        w = h = 0;
+        if (!texture) return false;
+        if (!is_whole()) {
+            w = rect.w;
+            h = rect.h;
+            return true;
+        }
+        return SDL_QueryTexture(texture, NULL, NULL, &w, &h) == 0;
+    }
+    // `sub` (in sprite pixels) moved into texture space, e.g. one frame of a sheet
+    SDL_Rect to_texture(const SDL_Rect& sub) const {
+        return is_whole() ? sub : SDL_Rect{ rect.x + sub.x, rect.y + sub.y, sub.w, sub.h };
+    }
+};
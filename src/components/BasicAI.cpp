@@ -1,36 +1,65 @@
 #include "inc/BasicAI.h"
 #include "inc/Character.h"
-#include "inc/Bullet.h"
-#include "ResourceManager.h"
+#include "inc/BulletSystem.h"
 #include <cmath>
 #include <iostream>
 
-BasicAI::BasicAI(Character* ai_char, Character* player, std::vector<Bullet*>* bullets, ResourceManager* rm)
-    : _ai_char(ai_char), _player(player), _bullets(bullets), _rm(rm), _shoot_timer(0.0f) {
+BasicAI::BasicAI(Character* ai_char, Character* player, BulletSystem* bullets)
+    : _ai_char(ai_char), _player(player), _bullets(bullets), _shoot_timer(0.0f) {
     std::random_device rd;
     _rng.seed(rd());
 }
 
+BasicAI::BasicAI(Character* ai_char, Character* player, BulletSystem* bullets, uint32_t seed)
+    : _ai_char(ai_char), _player(player), _bullets(bullets), _shoot_timer(0.0f), _rng(seed) {}
+
+void BasicAI::save_state(ByteWriter& out) const {
+    out.put(_shoot_timer);
+    out.put(_rng.get_seed());
+    out.put(_rng.get_draws());
+}
+
+void BasicAI::load_state(ByteReader& in) {
+    in.get(_shoot_timer);
+    SimRng::result_type seed = in.get<SimRng::result_type>();
+    uint64_t draws = in.get<uint64_t>();
+    if (in.ok()) _rng.restore(seed, draws);
+}
+
 void BasicAI::update(float delta_time) {
+    think(delta_time);
+    act();
+}
+
+void BasicAI::think(float delta_time) {
+    _decided = false;
+    _wants_shoot = false;
     if (!_ai_char || !_player) return;
+    _decided = true;
     Vector2 dir = _player->get_position() - _ai_char->get_position();
     float len2 = dir.x*dir.x + dir.y*dir.y;
     if (len2 > 1.0f) {
         float len = std::sqrt(len2);
         dir.x /= len; dir.y /= len;
-        _ai_char->set_direction(dir);
+        _move_dir = dir;
     } else {
-        _ai_char->set_direction(Vector2(0,0));
+        _move_dir = Vector2(0,0);
     }
 
     // Shooting: slower cooldown for PVE AI
     _shoot_timer -= delta_time;
     if (_shoot_timer <= 0.0f) {
-        // ask character to shoot (uses ResourceManager to create bullet texture)
-        if (_bullets && _rm) {
-            _ai_char->shoot(*_bullets, *_rm);
-        }
+        _wants_shoot = _bullets != nullptr;
         // slower base cooldown (2s) plus some randomness
         _shoot_timer = 2.0f + (std::uniform_real_distribution<float>(0.0f, 1.5f)(_rng));
     }
 }
+
+void BasicAI::act() {
+    if (!_decided) return;
+    _ai_char->set_direction(_move_dir);
+    // ask character to shoot into the shared bullet system
+    if (_wants_shoot) _ai_char->shoot(*_bullets);
+    _decided = false;
+    _wants_shoot = false;
+}
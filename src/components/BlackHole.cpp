@@ -1,14 +1,15 @@
 #include "inc/BlackHole.h"
 #include "inc/Character.h"
-#include "inc/Bullet.h"
+#include "inc/BulletSystem.h"
 #include "inc/Circle.h"
+#include "inc/SpriteBatch.h"
 #include <SDL_render.h>
 #include <iostream>
 
 // Constructor
 BlackHole::BlackHole(Vector2 pos, SDL_Texture* sprite, float outer_radius, float inner_radius,
                      float dps_outer, float dps_inner)
-    : Obstacle(pos, sprite, {}), // Call base with empty hitbox list
+    : Obstacle(CollidableKind::BLACKHOLE, pos, sprite, {}), // Call base with empty hitbox list
       _outer_radius(outer_radius),
       _inner_radius(inner_radius),
       _dps_outer(dps_outer),
@@ -30,12 +31,12 @@ BlackHole::~BlackHole() {
 void BlackHole::collide(ICollidable* object) {
     // Define constants for the effect strength.
     const float SUCK_IN_FORCE = 50.0f;
-    const float BSUCK_IN_FORCE = 200.0f;
     const float OUTER_DAMAGE = 0.2f;
     const float INNER_DAMAGE = 0.8f;
 
     // --- Character Collision ---
-    if (Character* character = dynamic_cast<Character*>(object)) {
+    if (object->get_kind() == CollidableKind::CHARACTER) {
+        Character* character = static_cast<Character*>(object);
         bool inner_collision = false;
         bool outer_collision = false;
 
@@ -67,23 +68,23 @@ void BlackHole::collide(ICollidable* object) {
         }
         return; // Done with this object
     }
+}
+
+void BlackHole::collide_bullet(BulletSystem& bullets, size_t index) {
+    const float BSUCK_IN_FORCE = 200.0f;
 
-    // --- Bullet Collision ---
-    if (Bullet* bullet = dynamic_cast<Bullet*>(object)) {
-        for (auto* bh_hb : this->get_hitboxes()) {
-            for (auto* bullet_hb : bullet->get_hitboxes()) {
-                if (bh_hb->is_collide(*bullet_hb)) {
-                    // If a bullet hits any part of the black hole, suck it in.
-                    Vector2 pull_direction = _position - bullet->get_position();
-                    if (pull_direction.length_squared() > 0) {
-                        bullet->add_force(pull_direction.normalize() * BSUCK_IN_FORCE);
-                    }
-                    if (_hitbox_list[1]->is_collide(*bullet_hb)) {
-                        bullet->set_destroyed(true);
-                    }
-                    return; // Apply force once per bullet per frame
-                }
+    OBB& bullet_hb = bullets.get_hitbox(index);
+    for (auto* bh_hb : this->get_hitboxes()) {
+        if (bh_hb->is_collide(bullet_hb)) {
+            // If a bullet hits any part of the black hole, suck it in.
+            Vector2 pull_direction = _position - bullets.get_position(index);
+            if (pull_direction.length_squared() > 0) {
+                bullets.add_force(index, pull_direction.normalize() * BSUCK_IN_FORCE);
+            }
+            if (_hitbox_list[1]->is_collide(bullet_hb)) {
+                bullets.set_destroyed(index);
             }
+            return; // Apply force once per bullet per frame
         }
     }
 }
@@ -104,13 +105,21 @@ void BlackHole::render(SDL_Renderer* renderer) {
     if (!_sprite) return;
 
     int w, h;
-    SDL_QueryTexture(_sprite, NULL, NULL, &w, &h);
+    _sprite.get_size(w, h);
     SDL_Rect dst_rect = {
         (int)(_position.x - w / 2.0f),
         (int)(_position.y - h / 2.0f),
         w,
         h
     };
-    SDL_RenderCopy(renderer, _sprite, NULL, &dst_rect);
+    SDL_RenderCopy(renderer, _sprite.texture, _sprite.get_src(), &dst_rect);
+}
+
+void BlackHole::render(SpriteBatch& batch) {
+    if (_anim) {
+        _anim->render(batch, (int)_position.x - 213, (int)_position.y - 205, 2, 0.0);
+        return;
+    }
+    batch.draw_centered(_sprite, _position);
 }
 
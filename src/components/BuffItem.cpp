@@ -2,17 +2,21 @@
 #include <SDL_timer.h>
 #include "inc/BuffItem.h"
 #include "inc/OBB.h"
+#include "inc/SpriteBatch.h"
 #include "inc/Character.h"
-#include <typeinfo>
 
 
-BuffItem::BuffItem(Vector2 position, SDL_Texture *sprite, std::variant<CharBuffType, BulletBuffType> buff_type) : Obstacle(position, sprite, {}), _buff_type(buff_type) {
+BuffItem::BuffItem(Vector2 position, TextureRegion sprite, std::variant<CharBuffType, BulletBuffType> buff_type) : Obstacle(CollidableKind::BUFF_ITEM, position, sprite, {}), _buff_type(buff_type) {
     int w, h;
-    SDL_QueryTexture(_sprite, NULL, NULL, &w, &h);
+    _sprite.get_size(w, h);
     OBB* buff_item_hitbox = new OBB(position, Vector2(w / 2.0f, h / 2.0f), 0.0f);
     this->_hitbox_list.push_back(buff_item_hitbox);
 }
 
+BuffItem::BuffItem(Vector2 position, Vector2 half_size, TextureRegion sprite, std::variant<CharBuffType, BulletBuffType> buff_type) : Obstacle(CollidableKind::BUFF_ITEM, position, sprite, {}), _buff_type(buff_type) {
+    this->_hitbox_list.push_back(new OBB(position, half_size, 0.0f));
+}
+
 BuffItem::~BuffItem() {
     for (HitBox* hitbox : _hitbox_list) {
         delete hitbox;
@@ -24,19 +28,23 @@ void BuffItem::render(SDL_Renderer* renderer) {
     if (!_sprite) return;
 
     int w, h;
-    SDL_QueryTexture(_sprite, NULL, NULL, &w, &h);
+    _sprite.get_size(w, h);
     SDL_Rect dst_rect = {
         (int)(_position.x - w / 2.0f),
         (int)(_position.y - h / 2.0f),
         w,
         h
     };
-    SDL_RenderCopy(renderer, _sprite, NULL, &dst_rect);
+    SDL_RenderCopy(renderer, _sprite.texture, _sprite.get_src(), &dst_rect);
+}
+
+void BuffItem::render(SpriteBatch& batch) {
+    batch.draw_centered(_sprite, _position);
 }
 
 void BuffItem::collide(ICollidable* object) {
     // Only characters can consume buff items
-    if (typeid(*object) == typeid(Character)) {
+    if (object->get_kind() == CollidableKind::CHARACTER) {
         for (auto* buff_hb : this->_hitbox_list) {
             for (auto* char_hb : object->get_hitboxes()) {
                 if (buff_hb->is_collide(*char_hb)) {
@@ -0,0 +1,295 @@
+#include "inc/BulletSystem.h"
+#include "inc/BlackHole.h"
+#include "inc/Character.h"
+#include "inc/Explosion.h"
+#include "inc/ICollidable.h"
+#include "inc/SpriteBatch.h"
+#include "Constant.h"
+#include "jobs/inc/JobSystem.h"
+#include "memory/inc/ObjectPool.h"
+#include <SDL_render.h>
+#include <cmath>
+
+// hitbox 15x8, sprite 24x24 (src rect lấy phần đạn trong sheet)
+static const Vector2 HITBOX_HALF_SIZE(15 / 2.0f, 8 / 2.0f);
+static const SDL_Rect SPRITE_SRC = {4, 0, 20, 24};
+static const int SPRITE_SIZE = 24;
+// khoảng hở sau khi chạm tường, chỉ để sweep tick sau không bắt đầu đúng trên mặt tường
+static const float CONTACT_SKIN = 0.01f;
+
+BulletSystem::BulletSystem(size_t capacity) {
+    _position.reserve(capacity);
+    _prev_position.reserve(capacity);
+    _direction.reserve(capacity);
+    _force.reserve(capacity);
+    _angle.reserve(capacity);
+    _life.reserve(capacity);
+    _hitbox.reserve(capacity);
+    _damage.reserve(capacity);
+    _team.reserve(capacity);
+    _buff.reserve(capacity);
+    _destroyed.reserve(capacity);
+}
+
+size_t BulletSystem::spawn(Vector2 position, Vector2 direction, float damage, BulletBuffType buff, int team_id) {
+    // Góc ban đầu theo hướng bay của đạn
+    float angle = std::atan2(direction.y, direction.x);
+
+    _position.push_back(position);
+    _prev_position.push_back(position);
+    _direction.push_back(direction);
+    _force.push_back(ZERO);
+    _angle.push_back(angle);
+    _life.push_back(LIFE_TIME);
+    _hitbox.emplace_back(position, HITBOX_HALF_SIZE, angle);
+    _damage.push_back(damage);
+    _team.push_back(team_id);
+    _buff.push_back(buff);
+    _destroyed.push_back(0);
+    return _position.size() - 1;
+}
+
+void BulletSystem::update(float delta_time, JobSystem* jobs) {
+    parallel_for(jobs, _position.size(), UPDATE_GRAIN, [this, delta_time](size_t begin, size_t end) {
+        update_range(delta_time, begin, end);
+    });
+}
+
+void BulletSystem::update_range(float delta_time, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        _life[i] -= delta_time;
+        if (_life[i] <= 0) _destroyed[i] = 1;
+
+        Vector2 velocity = _direction[i] * BULLET_SPEED + _force[i];
+        _prev_position[i] = _position[i];
+        _position[i] += velocity * delta_time;
+        _force[i] = ZERO;
+
+        // angle unchanged -> set_transform only moves the cached corners
+        _hitbox[i].set_transform(_position[i], _angle[i]);
+    }
+}
+
+void BulletSystem::collide(size_t index, ICollidable* object) {
+    if (!object || _destroyed[index]) return;
+
+    switch (object->get_kind()) {
+    case CollidableKind::WALL:
+        collide_walls(index, &object, 1);
+        break;
+    case CollidableKind::CHARACTER:
+        static_cast<Character*>(object)->collide_bullet(*this, index);
+        break;
+    case CollidableKind::BLACKHOLE:
+        static_cast<BlackHole*>(object)->collide_bullet(*this, index);
+        break;
+    case CollidableKind::EXPLOSION:
+        static_cast<Explosion*>(object)->collide_bullet(*this, index);
+        break;
+    default:
+        break;
+    }
+}
+
+void BulletSystem::collide_walls(size_t index, const std::vector<ICollidable*>& walls) {
+    collide_walls(index, walls.data(), walls.size());
+}
+
+void BulletSystem::collide_walls(size_t i, ICollidable* const* walls, size_t count) {
+    if (count == 0 || _destroyed[i] || _buff[i] == BulletBuffType::PIERCING) return; // piercing passes through
+
+    // Sweep the hitbox from where it started this tick instead of testing only
+    // the end position, so a fast bullet (or a big black hole pull) cannot skip
+    // over a 16 px wall.
+    Vector2 start = _prev_position[i];
+    Vector2 delta = _position[i] - start;
+    OBB& box = _hitbox[i];
+
+    for (int bounce = 0; ; ++bounce) {
+        box.set_transform(start, _angle[i]);
+
+        SweepHit best;
+        bool found = false;
+        for (size_t w = 0; w < count; ++w) {
+            for (auto* hb : walls[w]->get_hitboxes()) {
+                if (hb->get_kind() != ShapeKind::OBB) continue;
+                SweepHit hit;
+                if (!static_cast<OBB*>(hb)->sweep(box, delta, hit)) continue;
+                // đang rời khỏi tường (vừa bounce xong, hoặc spawn sát tường) -> bỏ qua
+                if (_buff[i] == BulletBuffType::BOUNCING && Vector2::dot(delta, hit.normal) >= 0.0f) continue;
+                if (!found || hit.toi < best.toi) {
+                    best = hit;
+                    found = true;
+                }
+            }
+        }
+        if (!found) break;
+
+        Vector2 contact = start + delta * best.toi;
+        if (_buff[i] != BulletBuffType::BOUNCING) {
+            // Normal bullet: destroy at the wall surface (explosions spawn there too)
+            _destroyed[i] = 1;
+            start = contact;
+            delta = ZERO;
+            break;
+        }
+        if (bounce == MAX_BOUNCES_PER_STEP) {
+            // kẹt trong góc: dừng ở điểm chạm, tick sau sweep tiếp từ đây
+            start = contact + best.normal * CONTACT_SKIN;
+            delta = ZERO;
+            break;
+        }
+
+        // reflect the actual motion about the contact normal: r = v - 2*(v·n)*n
+        float travel = delta.length();
+        Vector2 reflected = delta - best.normal * (2.0f * Vector2::dot(delta, best.normal));
+        if (reflected.length_squared() > 0.0f) {
+            reflected.normalize();
+            _direction[i] = reflected;
+        } else {
+            _direction[i] = best.normal;
+        }
+        _angle[i] = std::atan2(_direction[i].y, _direction[i].x);
+        // reset transient forces so next frame uses only the new direction
+        _force[i] = ZERO;
+
+        // spend the rest of this tick's travel along the new direction
+        start = contact + best.normal * CONTACT_SKIN;
+        delta = _direction[i] * (travel * (1.0f - best.toi));
+    }
+
+    _position[i] = start + delta;
+    box.set_transform(_position[i], _angle[i]);
+}
+
+AABB BulletSystem::get_swept_bounds(size_t i) const {
+    AABB bounds = _hitbox[i].get_bounds();
+    Vector2 back = _prev_position[i] - _position[i];
+    return bounds.merge(AABB(bounds.min + back, bounds.max + back));
+}
+
+void BulletSystem::collide_bullets(size_t a, size_t b) {
+    if (_destroyed[a] || _destroyed[b]) return;
+    if (_team[a] == _team[b]) return;
+    if (_hitbox[a].is_collide(_hitbox[b])) {
+        _destroyed[a] = 1;
+        _destroyed[b] = 1;
+    }
+}
+
+void BulletSystem::remove(size_t i) {
+    size_t last = _position.size() - 1;
+    if (i != last) {
+        _position[i] = _position[last];
+        _prev_position[i] = _prev_position[last];
+        _direction[i] = _direction[last];
+        _force[i] = _force[last];
+        _angle[i] = _angle[last];
+        _life[i] = _life[last];
+        _hitbox[i] = _hitbox[last];
+        _damage[i] = _damage[last];
+        _team[i] = _team[last];
+        _buff[i] = _buff[last];
+        _destroyed[i] = _destroyed[last];
+    }
+    _position.pop_back();
+    _prev_position.pop_back();
+    _direction.pop_back();
+    _force.pop_back();
+    _angle.pop_back();
+    _life.pop_back();
+    _hitbox.pop_back();
+    _damage.pop_back();
+    _team.pop_back();
+    _buff.pop_back();
+    _destroyed.pop_back();
+}
+
+void BulletSystem::flush_destroyed(ObjectPool<Explosion>& explosions) {
+    size_t i = 0;
+    while (i < _position.size()) {
+        if (!_destroyed[i]) { ++i; continue; }
+        if (_buff[i] == BulletBuffType::EXPLODING) {
+            explosions.spawn(_position[i], 25.0f, _team[i]);
+        }
+        // the last bullet moves into slot i, so re-check i
+        remove(i);
+    }
+}
+
+void BulletSystem::clear() {
+    _position.clear();
+    _prev_position.clear();
+    _direction.clear();
+    _force.clear();
+    _angle.clear();
+    _life.clear();
+    _hitbox.clear();
+    _damage.clear();
+    _team.clear();
+    _buff.clear();
+    _destroyed.clear();
+}
+
+void BulletSystem::save_state(ByteWriter& out) const {
+    out.put((uint32_t)_position.size());
+    for (size_t i = 0; i < _position.size(); ++i) {
+        out.put(_position[i]);
+        out.put(_prev_position[i]);
+        out.put(_direction[i]);
+        out.put(_force[i]);
+        out.put(_angle[i]);
+        out.put(_life[i]);
+        out.put(_damage[i]);
+        out.put(_team[i]);
+        out.put(_buff[i]);
+        out.put(_destroyed[i]);
+    }
+}
+
+bool BulletSystem::load_state(ByteReader& in) {
+    clear();
+    uint32_t count = 0;
+    if (!in.get(count)) return false;
+    for (uint32_t i = 0; i < count && in.ok(); ++i) {
+        _position.push_back(in.get<Vector2>());
+        _prev_position.push_back(in.get<Vector2>());
+        _direction.push_back(in.get<Vector2>());
+        _force.push_back(in.get<Vector2>());
+        _angle.push_back(in.get<float>());
+        _life.push_back(in.get<float>());
+        _damage.push_back(in.get<float>());
+        _team.push_back(in.get<int>());
+        _buff.push_back(in.get<BulletBuffType>());
+        _destroyed.push_back(in.get<uint8_t>());
+        _hitbox.emplace_back(_position.back(), HITBOX_HALF_SIZE, _angle.back());
+    }
+    if (!in.ok()) clear();
+    return in.ok();
+}
+
+void BulletSystem::render(SDL_Renderer* renderer, const TextureRegion& sheet, float alpha) const {
+    if (!sheet) return;
+    const SDL_Rect src = sheet.to_texture(SPRITE_SRC);
+    const int w = SPRITE_SIZE, h = SPRITE_SIZE;
+    for (size_t i = 0; i < _position.size(); ++i) {
+        Vector2 pos = _prev_position[i] + (_position[i] - _prev_position[i]) * alpha;
+        SDL_Rect dst = { (int)pos.x - w/2, (int)pos.y - h/2, w, h };
+        SDL_RenderCopyEx(renderer, sheet.texture, &src, &dst, _angle[i] * 180.0f / PI, NULL, SDL_FLIP_NONE);
+    }
+}
+
+void BulletSystem::render(SpriteBatch& batch, const TextureRegion& sheet, float alpha) const {
+    if (!sheet) return;
+    const SDL_Rect src = sheet.to_texture(SPRITE_SRC);
+    const int w = SPRITE_SIZE, h = SPRITE_SIZE;
+    for (size_t i = 0; i < _position.size(); ++i) {
+        Vector2 pos = _prev_position[i] + (_position[i] - _prev_position[i]) * alpha;
+        SDL_FRect dst = { (float)((int)pos.x - w/2), (float)((int)pos.y - h/2), (float)w, (float)h };
+        batch.draw(sheet.texture, &src, dst, _angle[i] * 180.0f / PI);
+    }
+}
+
+void BulletSystem::debug_draw(SDL_Renderer* renderer, SDL_Color color) {
+    for (auto& hb : _hitbox) hb.debug_draw(renderer, color);
+}
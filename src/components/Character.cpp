@@ -1,6 +1,5 @@
 #include "inc/Character.h"
-#include "ResourceManager.h"
-#include "inc/Bullet.h"
+#include "inc/BulletSystem.h"
 #include "inc/CharBuff.h"
 #include "inc/Explosion.h"
 #include "inc/Wall.h"
@@ -11,11 +10,10 @@
 #include <algorithm>
 #include <iostream>
 #include <vector>
-#include <typeinfo>
 #include "Constant.h"
 #include "inc/OBB.h"
 
-Character::Character(Vector2 position, SDL_Texture* sprite, float speed, float health) : Entity(position, sprite, speed), _health(health) {
+Character::Character(Vector2 position, TextureRegion sprite, float speed, float health) : Entity(CollidableKind::CHARACTER, position, sprite, speed), _health(health) {
     // Ensure health is capped at 100
     if (this->_health > 100.0f) this->_health = 100.0f;
     // init buff_list
@@ -41,14 +39,16 @@ void Character::set_input_set(int input_set) {
 // Private helper to update hitbox positions
 void update_character_hitboxes(Character* character) {
     for (auto* hitbox : character->get_hitboxes()) {
-        if (auto* obb = dynamic_cast<OBB*>(hitbox)) {
+        if (hitbox->get_kind() == ShapeKind::OBB) {
             // The character's position is its center, which is also the OBB's center.
-            obb->set_transform(character->get_position(), 0.0f);
+            static_cast<OBB*>(hitbox)->set_transform(character->get_position(), 0.0f);
         }
     }
 }
 
 void Character::update(float delta_time) {
+    _prev_position = _position;
+
     // Dead logic: no movement, no shooting, play dead animation
     if (_health <= 0.0f) {
         _direction = Vector2{0,0};
@@ -70,8 +70,8 @@ void Character::update(float delta_time) {
     _last_move_vec = velocity * delta_time;
     _position += _last_move_vec;
     for (auto* hb : _hitbox_list) {
-        if (auto* obb = dynamic_cast<OBB*>(hb)) {
-            obb->set_transform(_position, _angle); // cập nhật center và góc
+        if (hb->get_kind() == ShapeKind::OBB) {
+            static_cast<OBB*>(hb)->set_transform(_position, _angle); // cập nhật center và góc
         }
     }
 
@@ -130,31 +130,9 @@ void Character::add_force(Vector2 force) {
 }
 
 void Character::collide(ICollidable* object) {
-    if (typeid(*object) == typeid(Bullet)) {
-        Bullet* bullet = dynamic_cast<Bullet*>(object);
-        if (!bullet || bullet->get_team_id() == this->_input_set) {
-            return; // Not a bullet or friendly fire
-        }
-
-        for (auto* char_hb : this->get_hitboxes()) {
-            for (auto* bullet_hb : object->get_hitboxes()) {
-                if (char_hb->is_collide(*bullet_hb)) {
-                    // Collision detected, apply damage and exit
-                    this->_health -= bullet->get_damage();
-                    if (this->_health <= 0.0f) {
-                        std::cout << "player dead\n";
-                    }
-                    this->_health = std::max(this->_health, 0.0f);
-                    bullet->set_destroyed(true);
-                    return;
-                }
-            }
-        }
-    }
-    else if (typeid(*object) == typeid(Wall)) {
-        Wall* wall = dynamic_cast<Wall*>(object);
-        if (!wall) return;
-
+    // Dispatch on the collidable's kind tag (no RTTI); the tag guarantees the static_cast
+    switch (object->get_kind()) {
+    case CollidableKind::WALL: {
         for (auto* char_hb : this->get_hitboxes()) {
             for (auto* wall_hb : object->get_hitboxes()) {
                 if (char_hb->is_collide(*wall_hb)) {
@@ -165,10 +143,10 @@ void Character::collide(ICollidable* object) {
                 }
             }
         }
+        break;
     }
-    else if (typeid(*object) == typeid(BuffItem)) {
-        BuffItem* buff_item = dynamic_cast<BuffItem*>(object);
-        if (!buff_item) return;
+    case CollidableKind::BUFF_ITEM: {
+        BuffItem* buff_item = static_cast<BuffItem*>(object);
 
         for (auto* char_hb : this->get_hitboxes()) {
             for (auto* buff_hb : object->get_hitboxes()) {
@@ -194,8 +172,10 @@ void Character::collide(ICollidable* object) {
                 }
             }
         }
+        break;
     }
-    else if (Explosion *explosion = dynamic_cast<Explosion*>(object)) {
+    case CollidableKind::EXPLOSION: {
+        Explosion* explosion = static_cast<Explosion*>(object);
         // Delegate damage handling to Explosion::collide which tracks per-character hits
         for (auto* char_hb : this->get_hitboxes()) {
             for (auto* e_hb : object->get_hitboxes()) {
@@ -206,6 +186,30 @@ void Character::collide(ICollidable* object) {
                 }
             }
         }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void Character::collide_bullet(BulletSystem& bullets, size_t index) {
+    if (bullets.get_team_id(index) == this->_input_set) {
+        return; // friendly fire
+    }
+
+    OBB& bullet_hb = bullets.get_hitbox(index);
+    for (auto* char_hb : this->get_hitboxes()) {
+        if (char_hb->is_collide(bullet_hb)) {
+            // Collision detected, apply damage and exit
+            this->_health -= bullets.get_damage(index);
+            if (this->_health <= 0.0f) {
+                std::cout << "player dead\n";
+            }
+            this->_health = std::max(this->_health, 0.0f);
+            bullets.set_destroyed(index);
+            return;
+        }
     }
 }
 
@@ -220,73 +224,105 @@ void Character::remove_buff(CharBuffType buff_type) {
     }
 }
 
-std::vector<CharBuffType> Character::get_active_char_buffs() const {
-    std::vector<CharBuffType> active;
+std::pmr::vector<CharBuffType> Character::get_active_char_buffs(std::pmr::memory_resource* memory) const {
+    std::pmr::vector<CharBuffType> active(memory);
     for (const CharBuff& cb : _buff_list) {
         if (cb._activated) active.push_back(cb.get_type());
     }
     return active;
 }
 
-void Character::shoot(std::vector<Bullet*>& bullet_list, ResourceManager& resource_manager) {
+void Character::save_state(ByteWriter& out) const {
+    out.put(_position);
+    out.put(_prev_position);
+    out.put(_speed);
+    out.put(_force);
+    out.put(_health);
+    out.put(_shoot_delay);
+    out.put(_activated);
+    out.put(_gun_type);
+    out.put(_direction);
+    out.put(_last_direction);
+    out.put(_last_move_vec);
+    out.put(_angle);
+    out.put(_shoot_timer);
+    _gun_buffed.save_state(out);
+    for (const CharBuff& cb : _buff_list) cb.save_state(out);
+}
+
+void Character::load_state(ByteReader& in) {
+    in.get(_position);
+    in.get(_prev_position);
+    in.get(_speed);
+    in.get(_force);
+    in.get(_health);
+    in.get(_shoot_delay);
+    in.get(_activated);
+    in.get(_gun_type);
+    in.get(_direction);
+    in.get(_last_direction);
+    in.get(_last_move_vec);
+    in.get(_angle);
+    in.get(_shoot_timer);
+    _gun_buffed.load_state(in);
+    for (CharBuff& cb : _buff_list) cb.load_state(in);
+    for (auto* hb : _hitbox_list) {
+        if (hb->get_kind() == ShapeKind::OBB) static_cast<OBB*>(hb)->set_transform(_position, _angle);
+    }
+}
+
+void Character::shoot(BulletSystem& bullets) {
     if (_health <= 0.0f) return; // dead can't shoot
     if (this->_shoot_delay > 0) return;
 
-
-    SDL_Texture* bullet_sprite = resource_manager.get_texture("bullet");
     // Create a bullet at the character's position, facing _direction
     Vector2 bullet_dir = (_direction.length_squared() > 0) ? _direction : _last_direction;
     Vector2 bullet_pos = {_position.x,_position.y };
-    std::cout << "input_set when shoot " << this->_input_set << "\n";
-    Bullet* bullet = new Bullet(bullet_pos, bullet_sprite, BULLET_SPEED, 10.0f, bullet_dir, _gun_buffed.getType(), this->_input_set);
-    int hb_width = 15;
-    int hb_height = 8;
-
-    // Center the hitbox at the bullet spawn position
-    float hb_x = bullet_pos.x;
-    float hb_y = bullet_pos.y;
-
-    // halfSize = (width/2, height/2)
-    Vector2 halfSize(hb_width / 2.0f, hb_height / 2.0f);
-
-    // Góc ban đầu theo hướng bay của đạn
-    float angle = std::atan2(bullet_dir.y, bullet_dir.x);
-
-    // Tạo OBB hitbox
-    OBB* bulletHitbox = new OBB(Vector2(hb_x, hb_y), halfSize, angle);
-    bullet->add_hitbox(bulletHitbox);
+    bullets.spawn(bullet_pos, bullet_dir, BulletSystem::DAMAGE, _gun_buffed.getType(), this->_input_set);
 
-    // Push bullet vào danh sách
-    bullet_list.push_back(bullet);
     _shoot_timer = _shoot_duration;
     // set shot cooldown based on current gun type
     _shoot_delay = SHOOT_DELAY_MAP.at(this->_gun_type);
 }
 
 void Character::render(SDL_Renderer* renderer) {
-    // TODO: implement
+    render(renderer, 1.0f);
+}
+
+void Character::render(SDL_Renderer* renderer, float alpha) {
+    Vector2 pos = get_render_position(alpha);
     if (_current_anim) {
-    Vector2 pos = get_position();
-    double angle_deg = _angle * 180.0 / M_PI;
-    _current_anim->render(renderer, (int)pos.x - 12, (int)pos.y - 8, 1,angle_deg);
+        double angle_deg = _angle * 180.0 / M_PI;
+        _current_anim->render(renderer, (int)pos.x - 12, (int)pos.y - 8, 1,angle_deg);
     }
 
-    if (this->_activated) this->render_activated_circle(renderer);
+    if (this->_activated) this->render_activated_circle(renderer, pos);
+}
+
+void Character::render(SpriteBatch& batch, float alpha) {
+    if (!_current_anim) return;
+    Vector2 pos = get_render_position(alpha);
+    double angle_deg = _angle * 180.0 / M_PI;
+    _current_anim->render(batch, (int)pos.x - 12, (int)pos.y - 8, 1, angle_deg);
+}
+
+void Character::render_overlay(SDL_Renderer* renderer, float alpha) {
+    if (this->_activated) this->render_activated_circle(renderer, get_render_position(alpha));
 }
 
-void Character::render_activated_circle(SDL_Renderer *renderer) {
+void Character::render_activated_circle(SDL_Renderer *renderer, Vector2 center) {
     if (_input_set == 0) {
         SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red
     } else {
         SDL_SetRenderDrawColor(renderer, 0, 0, 255, 255); // Blue
     }
 
-    int center_x = _position.x;
-    int center_y = _position.y;
+    int center_x = center.x;
+    int center_y = center.y;
 
    int w, h;
 
-    if (SDL_QueryTexture(this->_sprite, nullptr, nullptr, &w, &h)) {
+    if (!this->_sprite.get_size(w, h)) {
         std::cerr << "Fail to get sprite texture size: " << SDL_GetError();
     }
     const int sprite_radius = std::max(w, h);
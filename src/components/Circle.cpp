@@ -15,17 +15,6 @@ bool Circle::is_collide(OBB& obb) {
     return obb.is_collide(*this);
 }
 
-// Dynamic dispatch
-bool Circle::is_collide(HitBox& hitbox) {
-    if (auto* c = dynamic_cast<Circle*>(&hitbox)) {
-        return is_collide(*c);
-    }
-    else if (auto* o = dynamic_cast<OBB*>(&hitbox)) {
-        return is_collide(*o);
-    }
-    return false;
-}
-
 // Debug draw circle
 void Circle::debug_draw(SDL_Renderer* renderer, SDL_Color color) {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
@@ -1,50 +1,64 @@
 #include "inc/Explosion.h"
+#include "inc/SpriteBatch.h"
 #include "inc/Character.h"
-#include "inc/Bullet.h"
+#include "inc/BulletSystem.h"
 #include "inc/Circle.h"
 #include "inc/Obstacle.h"
 #include <SDL.h>
-#include <unordered_set>
+#include <algorithm>
 
 Explosion::Explosion(SDL_Renderer* renderer, const std::string& sheetPath, Vector2 pos,
                      int frameW, int frameH, int frameCount, int frameTime, int columns, float damage, int owner_team)
-    : Obstacle(pos, nullptr, {}), elapsed(0.0f), finished(false), _damage(damage), _owner_team(owner_team) {
-    anim = new AnimatedSprite(renderer, sheetPath, frameW, frameH, frameCount, frameTime, columns);
+    : Obstacle(CollidableKind::EXPLOSION, pos, nullptr, {}),
+      // no renderer (headless): keep the timing/hitbox, skip the animation
+      anim(renderer ? AnimatedSprite(renderer, sheetPath, frameW, frameH, frameCount, frameTime, columns) : AnimatedSprite(nullptr, frameTime)),
+      // circular hitbox with radius equal to half the frame size
+      _blast(pos, std::min(frameW, frameH) / 2.0f),
+      elapsed(0.0f), finished(false), _damage(damage), _owner_team(owner_team) {
     totalDurationMs = frameCount * frameTime;
-    // Add a circular hitbox with radius equal to half the frame size
-    Circle* hb = new Circle(_position, std::min(frameW, frameH) / 2.0f);
-    _hitbox_list.push_back(hb);
+    _hitbox_list.push_back(&_blast);
 }
 
-Explosion::~Explosion() {
-    delete anim;
-    for (auto* hb : _hitbox_list) delete hb;
-    _hitbox_list.clear();
+void Explosion::reset(Vector2 pos, float damage, int owner_team) {
+    _position = pos;
+    _blast.set_center(pos);
+    anim.restart();
+    elapsed = 0.0f;
+    finished = false;
+    _damage = damage;
+    _owner_team = owner_team;
+    _damaged.clear();
 }
 
 void Explosion::update(float dt) {
     if (finished) return;
     elapsed += dt * 1000.0f;
-    anim->update(dt);
+    anim.update(dt);
     if (elapsed >= totalDurationMs) finished = true;
 }
 
 void Explosion::render(SDL_Renderer* renderer) {
     if (finished) return;
-    anim->render(renderer, (int)_position.x - 30, (int)_position.y - 26, 1, 0.0);
+    anim.render(renderer, (int)_position.x - 30, (int)_position.y - 26, 1, 0.0);
+}
+
+void Explosion::render(SpriteBatch& batch) {
+    if (finished) return;
+    anim.render(batch, (int)_position.x - 30, (int)_position.y - 26, 1, 0.0);
 }
 
 void Explosion::collide(ICollidable* object) {
     // If object is a Character, apply damage once per-character
-    if (Character* ch = dynamic_cast<Character*>(object)) {
+    if (object->get_kind() == CollidableKind::CHARACTER) {
+        Character* ch = static_cast<Character*>(object);
         // if we've already damaged this character, skip
-        if (_damaged.find(ch) == _damaged.end()) {
+        if (std::find(_damaged.begin(), _damaged.end(), ch) == _damaged.end()) {
             for (auto* ch_hb : ch->get_hitboxes()) {
                 for (auto* ex_hb : _hitbox_list) {
                     if (ex_hb->is_collide(*ch_hb)) {
                         float dmg = _damage;
                         ch->take_damage(dmg);
-                        _damaged.insert(ch);
+                        _damaged.push_back(ch);
                         // only damage once per character
                         return;
                     }
@@ -52,16 +66,35 @@ void Explosion::collide(ICollidable* object) {
             }
         }
     }
+}
 
-    // If object is a Bullet, destroy or apply force
-    if (Bullet* b = dynamic_cast<Bullet*>(object)) {
-        for (auto* b_hb : b->get_hitboxes()) {
-            for (auto* ex_hb : _hitbox_list) {
-                if (ex_hb->is_collide(*b_hb)) {
-                    // apply damage (we'll remove bullet externally)
-                    b->set_destroyed(true);
-                }
-            }
+void Explosion::save_state(ByteWriter& out, const std::vector<Character*>& roster) const {
+    out.put(elapsed);
+    out.put(finished);
+    out.put((uint32_t)_damaged.size());
+    // roster order, not hit order, so equal states write equal bytes
+    for (uint32_t r = 0; r < (uint32_t)roster.size(); ++r) {
+        if (std::find(_damaged.begin(), _damaged.end(), roster[r]) != _damaged.end()) out.put(r);
+    }
+}
+
+void Explosion::load_state(ByteReader& in, const std::vector<Character*>& roster) {
+    in.get(elapsed);
+    in.get(finished);
+    _damaged.clear();
+    uint32_t count = in.get<uint32_t>();
+    for (uint32_t i = 0; i < count && in.ok(); ++i) {
+        uint32_t r = in.get<uint32_t>();
+        if (r < roster.size() && std::find(_damaged.begin(), _damaged.end(), roster[r]) == _damaged.end()) _damaged.push_back(roster[r]);
+    }
+}
+
+void Explosion::collide_bullet(BulletSystem& bullets, size_t index) {
+    // bullets caught in the blast are destroyed (removed externally)
+    for (auto* ex_hb : _hitbox_list) {
+        if (ex_hb->is_collide(bullets.get_hitbox(index))) {
+            bullets.set_destroyed(index);
+            return;
         }
     }
 }
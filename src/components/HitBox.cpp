@@ -1,5 +1,6 @@
 #include "inc/Rect.h"
 #include "inc/Circle.h"
+#include "inc/OBB.h"
 #include <cmath>
 
 // Helper: clamp value between min and max
@@ -31,3 +32,27 @@ bool Rect::is_collide(Circle& circle) {
 
 
 
+// --- Shape-pair dispatch table ---
+// Indexed by [ShapeKind][ShapeKind]; the tag is checked by the table index so static_cast is safe.
+using CollideFn = bool (*)(HitBox&, HitBox&);
+
+static bool collide_rect_rect(HitBox& a, HitBox& b) { return static_cast<Rect&>(a).is_collide(static_cast<Rect&>(b)); }
+static bool collide_rect_circle(HitBox& a, HitBox& b) { return static_cast<Rect&>(a).is_collide(static_cast<Circle&>(b)); }
+static bool collide_circle_rect(HitBox& a, HitBox& b) { return static_cast<Rect&>(b).is_collide(static_cast<Circle&>(a)); }
+static bool collide_circle_circle(HitBox& a, HitBox& b) { return static_cast<Circle&>(a).is_collide(static_cast<Circle&>(b)); }
+static bool collide_circle_obb(HitBox& a, HitBox& b) { return static_cast<OBB&>(b).is_collide(static_cast<Circle&>(a)); }
+static bool collide_obb_circle(HitBox& a, HitBox& b) { return static_cast<OBB&>(a).is_collide(static_cast<Circle&>(b)); }
+static bool collide_obb_obb(HitBox& a, HitBox& b) { return static_cast<OBB&>(a).is_collide(static_cast<OBB&>(b)); }
+// Rect vs OBB has no narrowphase yet
+static bool collide_none(HitBox&, HitBox&) { return false; }
+
+static constexpr CollideFn COLLIDE_TABLE[(size_t)ShapeKind::NUM][(size_t)ShapeKind::NUM] = {
+    //             RECT                 CIRCLE                 OBB
+    /* RECT   */ { collide_rect_rect,   collide_rect_circle,   collide_none       },
+    /* CIRCLE */ { collide_circle_rect, collide_circle_circle, collide_circle_obb },
+    /* OBB    */ { collide_none,        collide_obb_circle,    collide_obb_obb    },
+};
+
+bool HitBox::is_collide(HitBox& other) {
+    return COLLIDE_TABLE[(size_t)_kind][(size_t)other._kind](*this, other);
+}
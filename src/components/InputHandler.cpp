@@ -30,69 +30,51 @@ void InputHandler::on_character_death(IInputObject* dead) {
     }
 }
 
-void InputHandler::handle_event(SDL_Event& event, std::vector<Bullet*>& bullet_list, ResourceManager& resource_manager) {
-    if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
-        bool key_down = (event.type == SDL_KEYDOWN);
+void InputHandler::swap_characters() {
+    if (!_unactivated_char) return; // nothing to swap with
+    if (this->_activated_char) {
+        this->_activated_char->set_activate(false);
+        this->_activated_char->set_direction(ZERO);
+    }
+    IInputObject* tmp_char = _activated_char;
+    _activated_char = _unactivated_char;
+    _unactivated_char = tmp_char;
+    if (this->_activated_char) this->_activated_char->set_activate(true);
+}
+
+void InputHandler::handle_event(SDL_Event& event) {
+    if (event.type != SDL_KEYDOWN && event.type != SDL_KEYUP) return;
+    bool key_down = (event.type == SDL_KEYDOWN);
 
-        switch (_input_set) {
-            case INPUT_1:
-                switch (event.key.keysym.sym) {
-                    case SDLK_w: _up = key_down; break;
-                    case SDLK_s: _down = key_down; break;
-                    case SDLK_a: _left = key_down; break;
-                    case SDLK_d: _right = key_down; break;
-                    case SDLK_LSHIFT:
-                        if (key_down) {
-                            if (!_unactivated_char) break; // nothing to swap with
-                            if (this->_activated_char) {
-                                this->_activated_char->set_activate(false);
-                                this->_activated_char->set_direction(ZERO);
-                            }
-                            IInputObject* tmp_char = _activated_char;
-                            _activated_char = _unactivated_char;
-                            _unactivated_char = tmp_char;
-                            if (this->_activated_char) this->_activated_char->set_activate(true);
-                        }
-                        break;
-                    case SDLK_SPACE:
-                        if (key_down) { _activated_char->shoot(bullet_list, resource_manager); }
-                        break;
-                }
-                break;
-            case INPUT_2:
-                switch (event.key.keysym.sym) {
-                    case SDLK_UP: _up = key_down; break;
-                    case SDLK_DOWN: _down = key_down; break;
-                    case SDLK_LEFT: _left = key_down; break;
-                    case SDLK_RIGHT: _right = key_down; break;
-                    case SDLK_RSHIFT:
-                        if (key_down) {
-                                if (!_unactivated_char) break; // nothing to swap with
-                                if (this->_activated_char) {
-                                    this->_activated_char->set_activate(false);
-                                    this->_activated_char->set_direction(ZERO);
-                                }
-                                IInputObject* tmp_char = _activated_char;
-                                _activated_char = _unactivated_char;
-                                _unactivated_char = tmp_char;
-                                if (this->_activated_char) this->_activated_char->set_activate(true);
-                        }
-                        break;
-                    case SDLK_RETURN: // Enter key
-                        if (key_down) { _activated_char->shoot(bullet_list, resource_manager); }
-                        break;
-                }
-                break;
-        }
+    // (up, down, left, right, swap, shoot) keys of each input set
+    static const SDL_Keycode KEYS[2][6] = {
+        { SDLK_w, SDLK_s, SDLK_a, SDLK_d, SDLK_LSHIFT, SDLK_SPACE },
+        { SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RIGHT, SDLK_RSHIFT, SDLK_RETURN },
+    };
+    static const uint8_t BITS[6] = { INPUT_BIT_UP, INPUT_BIT_DOWN, INPUT_BIT_LEFT, INPUT_BIT_RIGHT, INPUT_BIT_SWAP, INPUT_BIT_SHOOT };
+
+    const SDL_Keycode* keys = KEYS[_input_set == INPUT_1 ? 0 : 1];
+    for (int k = 0; k < 6; ++k) {
+        if (event.key.keysym.sym != keys[k]) continue;
+        if (key_down) _state |= BITS[k];
+        // swap / shoot presses stay latched until apply_actions(), only directions are "held"
+        else if (BITS[k] != INPUT_BIT_SWAP && BITS[k] != INPUT_BIT_SHOOT) _state &= (uint8_t)~BITS[k];
+        break;
     }
 }
 
+void InputHandler::apply_actions(BulletSystem& bullets) {
+    if (_state & INPUT_BIT_SWAP) swap_characters();
+    if ((_state & INPUT_BIT_SHOOT) && _activated_char) _activated_char->shoot(bullets);
+    _state &= (uint8_t)~(INPUT_BIT_SWAP | INPUT_BIT_SHOOT);
+}
+
 void InputHandler::update(float delta_time) {
     Vector2 direction = ZERO;
-    if (_up) { direction.y -= 1; }
-    if (_down) { direction.y += 1; }
-    if (_left) { direction.x -= 1; }
-    if (_right) { direction.x += 1; }
+    if (_state & INPUT_BIT_UP) { direction.y -= 1; }
+    if (_state & INPUT_BIT_DOWN) { direction.y += 1; }
+    if (_state & INPUT_BIT_LEFT) { direction.x -= 1; }
+    if (_state & INPUT_BIT_RIGHT) { direction.x += 1; }
 
     if (direction.length_squared() > 0) {
         direction.normalize();
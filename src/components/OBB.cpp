@@ -1,93 +1,72 @@
 #include "inc/OBB.h"
 #include "inc/Circle.h"
 #include <cmath>
+#include <limits>
+#include <utility>
 
 // Constructor
 OBB::OBB(Vector2 center, Vector2 halfSize, float angle)
-    : HitBox(center), _center(center), _halfSize(halfSize), _angle(angle) {}
+    : HitBox(center, ShapeKind::OBB), _center(center), _halfSize(halfSize), _angle(angle) {
+    update_axes();
+    update_corners();
+}
+
+void OBB::update_axes() {
+    float cosA = std::cos(_angle);
+    float sinA = std::sin(_angle);
+    _axes[0] = Vector2(cosA, sinA);
+    _axes[1] = Vector2(-sinA, cosA);
+}
+
+void OBB::update_corners() {
+    Vector2 ex = _axes[0] * _halfSize.x;
+    Vector2 ey = _axes[1] * _halfSize.y;
+    _corners[0] = _center - ex - ey;
+    _corners[1] = _center + ex - ey;
+    _corners[2] = _center + ex + ey;
+    _corners[3] = _center - ex + ey;
+}
 
 // Update position + angle
 void OBB::set_transform(const Vector2& center, float angle) {
+    // only pay for cos/sin when the rotation actually changed (bullets keep theirs)
+    if (angle != _angle) {
+        _angle = angle;
+        update_axes();
+    }
     _center = center;
-    _angle = angle;
     _local_pos = center;
-}
-
-// Lấy 4 đỉnh của OBB sau khi xoay
-std::vector<Vector2> OBB::get_corners() const {
-    std::vector<Vector2> corners;
-    corners.reserve(4);
-
-    std::vector<Vector2> localCorners = {
-        {-_halfSize.x, -_halfSize.y},
-        { _halfSize.x, -_halfSize.y},
-        { _halfSize.x,  _halfSize.y},
-        {-_halfSize.x,  _halfSize.y}
-    };
-
-    float cosA = cos(_angle);
-    float sinA = sin(_angle);
-
-    for (auto& c : localCorners) {
-        float x = c.x * cosA - c.y * sinA;
-        float y = c.x * sinA + c.y * cosA;
-        corners.push_back(Vector2(x, y) + _center);
-    }
-
-    return corners;
+    update_corners();
 }
 
 // Debug draw
 void OBB::debug_draw(SDL_Renderer* renderer, SDL_Color color) {
-    auto corners = get_corners();
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
 
     for (int i = 0; i < 4; i++) {
-        Vector2 p1 = corners[i];
-        Vector2 p2 = corners[(i + 1) % 4];
+        Vector2 p1 = _corners[i];
+        Vector2 p2 = _corners[(i + 1) % 4];
         SDL_RenderDrawLine(renderer, (int)p1.x, (int)p1.y, (int)p2.x, (int)p2.y);
     }
 }
 
-static void project_onto_axis(const std::vector<Vector2>& corners, const Vector2& axis, float& min, float& max) {
-    min = max = Vector2::dot(axis,corners[0]);
-    for (size_t i = 1; i < corners.size(); ++i) {
-        float p = Vector2::dot(axis,corners[i]);
-        if (p < min) min = p;
-        if (p > max) max = p;
-    }
+// Bán kính projection của OBB lên trục `axis`
+static inline float projected_radius(const std::array<Vector2, 2>& axes, const Vector2& half, const Vector2& axis) {
+    return half.x * std::fabs(Vector2::dot(axes[0], axis)) +
+           half.y * std::fabs(Vector2::dot(axes[1], axis));
 }
 
 // Kiểm tra OBB vs OBB bằng SAT
+// Mỗi OBB chỉ có 2 trục normal khác nhau (2 cạnh còn lại song song), nên chỉ cần test 4 trục.
 bool OBB::is_collide(OBB& other) {
-    std::vector<Vector2> cornersA = get_corners();
-    std::vector<Vector2> cornersB = other.get_corners();
-
-    // Lấy các edge làm trục (normal)
-    std::vector<Vector2> axes;
-    for (int i = 0; i < 4; i++) {
-        Vector2 edge = cornersA[(i + 1) % 4] - cornersA[i];
-        axes.push_back(Vector2(-edge.y, edge.x)); // normal
-    }
-    for (int i = 0; i < 4; i++) {
-        Vector2 edge = cornersB[(i + 1) % 4] - cornersB[i];
-        axes.push_back(Vector2(-edge.y, edge.x));
-    }
-
-    // Chuẩn hóa axis
-    for (auto& axis : axes) {
-        float len = std::sqrt(axis.x * axis.x + axis.y * axis.y);
-        if (len > 0) axis = axis * (1.0f / len);
-    }
-
-    // Kiểm tra projection
-    for (auto& axis : axes) {
-        float minA, maxA, minB, maxB;
-        project_onto_axis(cornersA, axis, minA, maxA);
-        project_onto_axis(cornersB, axis, minB, maxB);
+    Vector2 d = other._center - _center;
+    const Vector2* axes[4] = { &_axes[0], &_axes[1], &other._axes[0], &other._axes[1] };
 
+    for (const Vector2* axis : axes) {
+        float rA = projected_radius(_axes, _halfSize, *axis);
+        float rB = projected_radius(other._axes, other._halfSize, *axis);
         // Nếu không giao nhau trên trục này -> không va chạm
-        if (maxA < minB || maxB < minA)
+        if (std::fabs(Vector2::dot(d, *axis)) > rA + rB)
             return false;
     }
 
@@ -95,26 +74,13 @@ bool OBB::is_collide(OBB& other) {
     return true;
 }
 
-// override HitBox
-bool OBB::is_collide(HitBox& other) {
-    if (auto* obb = dynamic_cast<OBB*>(&other))
-        return is_collide(*obb);
-    if (auto* circle = dynamic_cast<Circle*>(&other))
-        return is_collide(*circle);
-    return false; // future: có thể thêm Circle vs OBB
-}
-
 bool OBB::is_collide(Circle& circle) {
     // Vector từ OBB center tới Circle center
     Vector2 d = circle.get_center() - _center;
 
-    // Tính cos & sin của -_angle để đưa về local space
-    float c = std::cos(-_angle);
-    float s = std::sin(-_angle);
-
-    // Circle center trong local space của OBB
-    float localX = d.x * c - d.y * s;
-    float localY = d.x * s + d.y * c;
+    // Circle center trong local space của OBB (dùng trục đã cache)
+    float localX = Vector2::dot(d, _axes[0]);
+    float localY = Vector2::dot(d, _axes[1]);
 
     // Clamp vào box [-halfSize, halfSize]
     float closestX = std::max(-_halfSize.x, std::min(localX, _halfSize.x));
@@ -125,4 +91,81 @@ bool OBB::is_collide(Circle& circle) {
     float dy = localY - closestY;
 
     return (dx * dx + dy * dy) <= (circle.get_radius() * circle.get_radius());
-}
\ No newline at end of file
+}
+
+AABB OBB::get_bounds() const {
+    // Extents of the rotated box projected onto the world axes
+    Vector2 extents(projected_radius(_axes, _halfSize, Vector2(1.0f, 0.0f)),
+                    projected_radius(_axes, _halfSize, Vector2(0.0f, 1.0f)));
+    return AABB::from_center(_center, extents);
+}
+
+// Một trục của swept test: khoảng [t_enter, t_exit] mà hai hình chiếu chồng nhau.
+// s = khoảng cách tâm chiếu lên trục, v = vận tốc chiếu lên trục, r = tổng bán kính.
+namespace {
+struct SweepSpan {
+    float t_enter = -std::numeric_limits<float>::infinity();
+    float t_exit = std::numeric_limits<float>::infinity();
+    Vector2 enter_normal;
+    float min_depth = std::numeric_limits<float>::infinity();
+    Vector2 depth_normal;
+
+    // false = tách rời trên trục này suốt cả đoạn -> không chạm
+    bool clip(const Vector2& axis, float r, float s, float v) {
+        float depth = r - std::fabs(s);
+        if (depth < min_depth) {
+            min_depth = depth;
+            depth_normal = s >= 0.0f ? axis : -axis;
+        }
+        if (v == 0.0f) return std::fabs(s) < r; // song song: chạm thì chỉ có thể từ đầu
+
+        float t0 = (-r - s) / v;
+        float t1 = (r - s) / v;
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > t_enter) {
+            t_enter = t0;
+            enter_normal = v > 0.0f ? -axis : axis;
+        }
+        if (t1 < t_exit) t_exit = t1;
+        return t_enter < t_exit;
+    }
+
+    bool finish(SweepHit& hit) const {
+        // đã rời nhau trước t = 0, hoặc chỉ chạm sau khi hết đoạn
+        if (t_exit <= 0.0f || t_enter > 1.0f) return false;
+        if (t_enter < 0.0f) {
+            hit.toi = 0.0f;
+            hit.normal = depth_normal;
+        } else {
+            hit.toi = t_enter;
+            hit.normal = enter_normal;
+        }
+        return true;
+    }
+};
+} // namespace
+
+bool OBB::sweep(const OBB& moving, const Vector2& delta, SweepHit& hit) const {
+    Vector2 d = moving._center - _center;
+    const Vector2* axes[4] = { &_axes[0], &_axes[1], &moving._axes[0], &moving._axes[1] };
+
+    SweepSpan span;
+    for (const Vector2* axis : axes) {
+        float r = projected_radius(_axes, _halfSize, *axis) +
+                  projected_radius(moving._axes, moving._halfSize, *axis);
+        if (!span.clip(*axis, r, Vector2::dot(d, *axis), Vector2::dot(delta, *axis)))
+            return false;
+    }
+    return span.finish(hit);
+}
+
+bool OBB::raycast(const Vector2& origin, const Vector2& delta, SweepHit& hit) const {
+    Vector2 d = origin - _center;
+
+    SweepSpan span;
+    if (!span.clip(_axes[0], _halfSize.x, Vector2::dot(d, _axes[0]), Vector2::dot(delta, _axes[0])))
+        return false;
+    if (!span.clip(_axes[1], _halfSize.y, Vector2::dot(d, _axes[1]), Vector2::dot(delta, _axes[1])))
+        return false;
+    return span.finish(hit);
+}
@@ -1,20 +1,18 @@
 #include "inc/Rect.h"
 #include "inc/Circle.h"
 #include "SDL.h"
+#include <cmath>
 
-// Implement the dispatcher for is_collide
-bool Rect::is_collide(HitBox& hitbox) {
-    // Try dynamic_cast to Rect
-    if (auto* rect = dynamic_cast<Rect*>(&hitbox)) {
-        return is_collide(*rect);
-    }
-    // Try dynamic_cast to Circle
-    if (auto* circle = dynamic_cast<Circle*>(&hitbox)) {
-        return is_collide(*circle);
-    }
-    // Unknown type, no collision
-    return false;
+AABB Rect::get_bounds() const {
+    // _angle is in degrees and rotates around the rect center (same as debug_draw)
+    float rad = _angle * M_PI / 180.0f;
+    float c = std::fabs(std::cos(rad));
+    float s = std::fabs(std::sin(rad));
+    Vector2 half(_rect.w / 2.0f, _rect.h / 2.0f);
+    Vector2 center(_rect.x + half.x, _rect.y + half.y);
+    return AABB::from_center(center, Vector2(half.x * c + half.y * s, half.x * s + half.y * c));
 }
+
 void Rect::debug_draw(SDL_Renderer* renderer, SDL_Color color) {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
 
@@ -0,0 +1,114 @@
+#include "inc/SpriteBatch.h"
+#include "Constant.h"
+#include <cmath>
+
+void SpriteBatch::begin() {
+    for (int l = 0; l < (int)SpriteLayer::NUM; ++l) {
+        for (size_t b = 0; b < _used[l]; ++b) {
+            _buckets[l][b].vertices.clear();
+            _buckets[l][b].indices.clear();
+        }
+        _used[l] = 0;
+    }
+    _layer = 0;
+}
+
+SpriteBatch::Bucket* SpriteBatch::bucket_for(SDL_Texture* texture) {
+    std::vector<Bucket>& buckets = _buckets[_layer];
+    size_t& used = _used[_layer];
+    // a layer holds a handful of textures, a linear scan beats hashing
+    for (size_t b = 0; b < used; ++b) {
+        if (buckets[b].texture == texture) return &buckets[b];
+    }
+    if (used == buckets.size()) buckets.emplace_back();
+    Bucket* bucket = &buckets[used++];
+    bucket->texture = texture;
+    // re-queried every frame: a destroyed texture's pointer may come back with another size
+    if (SDL_QueryTexture(texture, NULL, NULL, &bucket->width, &bucket->height) != 0) {
+        bucket->width = bucket->height = 0;
+    }
+    return bucket;
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect& dst, double angle, const SDL_FPoint* center) {
+    if (!texture) return;
+    Bucket* bucket = bucket_for(texture);
+    if (bucket->width <= 0 || bucket->height <= 0) return;
+
+    SDL_Rect s = src ? *src : SDL_Rect{ 0, 0, bucket->width, bucket->height };
+    float u0 = (float)s.x / bucket->width, v0 = (float)s.y / bucket->height;
+    float u1 = (float)(s.x + s.w) / bucket->width, v1 = (float)(s.y + s.h) / bucket->height;
+
+    // corners relative to the pivot, then rotated (clockwise on screen, like RenderCopyEx)
+    float cx = center ? center->x : dst.w * 0.5f;
+    float cy = center ? center->y : dst.h * 0.5f;
+    float px = dst.x + cx, py = dst.y + cy;
+    float xs[4] = { -cx, dst.w - cx, dst.w - cx, -cx };
+    float ys[4] = { -cy, -cy, dst.h - cy, dst.h - cy };
+    float us[4] = { u0, u1, u1, u0 };
+    float vs[4] = { v0, v0, v1, v1 };
+    float c = 1.0f, sn = 0.0f;
+    if (angle != 0.0) {
+        float rad = (float)(angle * PI / 180.0);
+        c = std::cos(rad);
+        sn = std::sin(rad);
+    }
+
+    const SDL_Color white = { 255, 255, 255, 255 };
+    int base = (int)bucket->vertices.size();
+    for (int k = 0; k < 4; ++k) {
+        SDL_Vertex v;
+        v.position.x = px + xs[k] * c - ys[k] * sn;
+        v.position.y = py + xs[k] * sn + ys[k] * c;
+        v.color = white;
+        v.tex_coord.x = us[k];
+        v.tex_coord.y = vs[k];
+        bucket->vertices.push_back(v);
+    }
+    bucket->indices.insert(bucket->indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+}
+
+void SpriteBatch::draw_centered(const TextureRegion& sprite, Vector2 position) {
+    if (!sprite) return;
+    int w, h;
+    if (sprite.is_whole()) {
+        Bucket* bucket = bucket_for(sprite.texture);
+        w = bucket->width;
+        h = bucket->height;
+    } else {
+        w = sprite.rect.w;
+        h = sprite.rect.h;
+    }
+    SDL_FRect dst = { (float)(int)(position.x - w / 2.0f), (float)(int)(position.y - h / 2.0f), (float)w, (float)h };
+    draw(sprite.texture, sprite.get_src(), dst);
+}
+
+SDL_Vertex* SpriteBatch::add_quads(SDL_Texture* texture, size_t count) {
+    if (!texture || count == 0) return nullptr;
+    Bucket* bucket = bucket_for(texture);
+    size_t first = bucket->vertices.size();
+    bucket->vertices.resize(first + 4 * count);
+    size_t first_index = bucket->indices.size();
+    bucket->indices.resize(first_index + 6 * count);
+    int* idx = bucket->indices.data() + first_index;
+    for (size_t q = 0; q < count; ++q, idx += 6) {
+        int base = (int)(first + 4 * q);
+        idx[0] = base; idx[1] = base + 1; idx[2] = base + 2;
+        idx[3] = base; idx[4] = base + 2; idx[5] = base + 3;
+    }
+    return bucket->vertices.data() + first;
+}
+
+void SpriteBatch::flush() {
+    _draw_calls = 0;
+    for (int l = 0; l < (int)SpriteLayer::NUM; ++l) {
+        for (size_t b = 0; b < _used[l]; ++b) {
+            Bucket& bucket = _buckets[l][b];
+            if (bucket.indices.empty()) continue;
+            SDL_RenderGeometry(_renderer, bucket.texture, bucket.vertices.data(), (int)bucket.vertices.size(),
+                               bucket.indices.data(), (int)bucket.indices.size());
+            ++_draw_calls;
+        }
+    }
+    begin();
+}
@@ -1,16 +1,17 @@
 #include "inc/Wall.h"
 #include "inc/OBB.h"
+#include "inc/SpriteBatch.h"
 #include <SDL_render.h>
 #include <SDL_error.h>
 #include <iostream>
 
 // Constructor: Automatically creates a hitbox based on the sprite's dimensions.
-Wall::Wall(Vector2 position, SDL_Texture* sprite)
-    : Obstacle(position, sprite, {}) { // Call base with an empty hitbox list initially.
+Wall::Wall(Vector2 position, TextureRegion sprite)
+    : Obstacle(CollidableKind::WALL, position, sprite, {}) { // Call base with an empty hitbox list initially.
     
     if (sprite) {
         int w, h;
-        if (SDL_QueryTexture(sprite, NULL, NULL, &w, &h) != 0) {
+        if (!sprite.get_size(w, h)) {
             std::cerr << "Failed to query wall texture: " << SDL_GetError() << std::endl;
             return;
         }
@@ -21,6 +22,11 @@ Wall::Wall(Vector2 position, SDL_Texture* sprite)
     }
 }
 
+Wall::Wall(Vector2 position, Vector2 half_size, TextureRegion sprite)
+    : Obstacle(CollidableKind::WALL, position, sprite, {}) {
+    this->_hitbox_list.push_back(new OBB(_position, half_size, 0.0f));
+}
+
 // Destructor: Cleans up the hitboxes created in the constructor.
 Wall::~Wall() {
     for (auto* hitbox : _hitbox_list) {
@@ -29,7 +35,7 @@ Wall::~Wall() {
     _hitbox_list.clear();
 }
 
-// Delegate collision handling to the other object (Character, Bullet, etc.)
+// Delegate collision handling to the other object (Character, etc.); bullets go through BulletSystem::collide
 void Wall::collide(ICollidable* object) {
     if (object) {
         object->collide(this);
@@ -46,17 +52,34 @@ void Wall::render(SDL_Renderer* renderer) {
     if (!_sprite) return;
 
     int w, h;
-    SDL_QueryTexture(_sprite, NULL, NULL, &w, &h);
+    _sprite.get_size(w, h);
+    if (!_hitbox_list.empty()) { // stretched over the hitbox, like the batched path
+        Vector2 half = static_cast<OBB*>(_hitbox_list[0])->get_halfSize();
+        w = (int)(half.x * 2.0f);
+        h = (int)(half.y * 2.0f);
+    }
     SDL_Rect dst_rect = {
         (int)(_position.x - w / 2.0f),
         (int)(_position.y - h / 2.0f),
         w,
         h
     };
-    SDL_RenderCopy(renderer, _sprite, NULL, &dst_rect);
+    SDL_RenderCopy(renderer, _sprite.texture, _sprite.get_src(), &dst_rect);
 
     // Always draw hitbox outline for debugging (thin green rectangle)
     for (auto* hb : this->get_hitboxes()) {
         hb->debug_draw(renderer, {0, 255, 0, 255});
     }
 }
+
+// Sprite only; callers draw the hitbox outline themselves once the batch is flushed.
+void Wall::render(SpriteBatch& batch) {
+    if (!_sprite) return;
+    if (_hitbox_list.empty()) {
+        batch.draw_centered(_sprite, _position);
+        return;
+    }
+    Vector2 half = static_cast<OBB*>(_hitbox_list[0])->get_halfSize();
+    SDL_FRect dst = { (float)(int)(_position.x - half.x), (float)(int)(_position.y - half.y), half.x * 2.0f, half.y * 2.0f };
+    batch.draw(_sprite.texture, _sprite.get_src(), dst);
+}
@@ -1,27 +1,32 @@
 #pragma once
 
 #include <SDL.h>
-#include <SDL_image.h>
 #include <vector>
 #include <string>
 
+struct AnimationClip;
+class SpriteBatch;
+
+// Playback state (frame + timer) over a shared AnimationClip. Cheap to create:
+// the spritesheet is loaded once per (path, layout) by AnimationClipCache.
 class AnimatedSprite {
 public:
     AnimatedSprite(SDL_Renderer* renderer, const std::string& spritesheet,
                    int frameWidth, int frameHeight, int frameCount, int frameTime, int columns = 1);
-    ~AnimatedSprite();
+    AnimatedSprite(const AnimationClip* clip, int frameTime);
 
     void update(float deltaTime);
     void render(SDL_Renderer* renderer, int x, int y, int scale = 1, double angle = 0.0);
-    SDL_Texture* get_texture() const { return texture; }
+    // same placement as above, queued into the batch's current layer
+    void render(SpriteBatch& batch, int x, int y, int scale = 1, double angle = 0.0);
+    SDL_Texture* get_texture() const;
+    // back to the first frame, for a pooled effect that is spawned again
+    void restart() { currentFrame = 0; timer = 0.0f; }
 
 
 private:
-    SDL_Texture* texture;
-    std::vector<SDL_Rect> clips;
+    const AnimationClip* clip; // not owned
     int currentFrame;
     int frameTime;      // thời gian mỗi frame (ms)
     float timer;     
-    Uint32 lastUpdate;
-    int frameWidth, frameHeight;
 };
@@ -1,24 +1,41 @@
 #pragma once
 
 #include "IUpdatable.h"
-#include <random>
+#include "io/inc/ByteStream.h"
+#include "math/SimRng.h"
+#include "math/Vector2.h"
+#include <cstdint>
 #include <vector>
 
 // Forward declarations
 class Character;
-class Bullet;
-class ResourceManager;
+class BulletSystem;
 
 class BasicAI : public IUpdatable {
 private:
     Character* _ai_char;
     Character* _player;
-    std::vector<Bullet*>* _bullets;
-    ResourceManager* _rm;
+    BulletSystem* _bullets;
     float _shoot_timer;
-    std::mt19937 _rng;
+    SimRng _rng;
+    // think() -> act() hand-off, only valid within one tick
+    bool _decided = false;
+    bool _wants_shoot = false;
+    Vector2 _move_dir;
 public:
-    BasicAI(Character* ai_char, Character* player, std::vector<Bullet*>* bullets, ResourceManager* rm);
-    void update(float delta_time) override;
+    BasicAI(Character* ai_char, Character* player, BulletSystem* bullets);
+    // Seeded variant so simulated matches are reproducible
+    BasicAI(Character* ai_char, Character* player, BulletSystem* bullets, uint32_t seed);
+    Character* get_character() const { return _ai_char; }
+    void set_target(Character* target) { _player = target; }
+    void update(float delta_time) override; // think() + act()
+    // Decision only: reads the world, writes nothing but this AI's own state,
+    // so every AI of a tick can think in parallel
+    void think(float delta_time);
+    // Applies the decision (direction, shot into the bullet system); serial, in a fixed order
+    void act();
+    // cooldown + RNG position; the target is picked again every tick
+    void save_state(ByteWriter& out) const;
+    void load_state(ByteReader& in);
     ~BasicAI() = default;
 };
@@ -5,6 +5,7 @@
 
 // Forward declaration
 class Character;
+class BulletSystem;
 
 class BlackHole : public Obstacle {
 private:
@@ -24,10 +25,12 @@ public:
     ~BlackHole();
 
     void collide(ICollidable* object) override;
+    void collide_bullet(BulletSystem& bullets, size_t index);
     void set_animation(AnimatedSprite* anim) { _anim = anim; }
 
     void update(float delta_time) override;
     void render(SDL_Renderer* renderer) override;
+    void render(SpriteBatch& batch);
 
     // getter to debug draw hitbox
     float get_outer_radius() const { return _outer_radius; }
@@ -1,13 +1,14 @@
 #pragma once
 
 #include "IUpdatable.h"
+#include "io/inc/ByteStream.h"
 #include <algorithm>
 
 class Buff : public IUpdatable {
 protected:
     bool is_activated = false;
     float _duration;
-    float _timer;
+    float _timer = 0.0f;
 public:
     Buff(float duration) : _duration(duration) {}
     virtual ~Buff() = default;
@@ -26,4 +27,16 @@ public:
         is_activated = true;
     }
     virtual void timer_end() = 0;
+
+    // Snapshot of the timer state (see Match::save_state)
+    virtual void save_state(ByteWriter& out) const {
+        out.put(is_activated);
+        out.put(_duration);
+        out.put(_timer);
+    }
+    virtual void load_state(ByteReader& in) {
+        in.get(is_activated);
+        in.get(_duration);
+        in.get(_timer);
+    }
 };
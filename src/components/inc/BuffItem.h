@@ -3,23 +3,34 @@
 #include "Obstacle.h"
 #include "CharBuff.h"
 #include "BulletBuff.h"
+#include "io/inc/ByteStream.h"
 #include <SDL_render.h>
 #include <variant>
 
 // forward decl
 
+class SpriteBatch;
+
 class BuffItem : public Obstacle {
 private:
     std::variant<CharBuffType, BulletBuffType> _buff_type;
     bool _is_consumed = false;
     float _life_timer = 20.0f; // seconds before auto-disappear
 public:
-    BuffItem(Vector2 position, SDL_Texture *sprite, std::variant<CharBuffType, BulletBuffType> buff_type);
+    static constexpr float DEFAULT_HALF_SIZE = 8.0f; // buff icons are 16x16
+
+    BuffItem(Vector2 position, TextureRegion sprite, std::variant<CharBuffType, BulletBuffType> buff_type);
+    // Explicit hitbox size so the simulation does not depend on textures
+    BuffItem(Vector2 position, Vector2 half_size, TextureRegion sprite, std::variant<CharBuffType, BulletBuffType> buff_type);
     ~BuffItem();
     std::variant<CharBuffType, BulletBuffType> get_buff_type() { return this->_buff_type; }
     bool is_consumed() const { return _is_consumed; }
     void consume() { _is_consumed = true; }
+    // position and type are constructor arguments; this is what changes afterwards
+    void save_state(ByteWriter& out) const { out.put(_is_consumed); out.put(_life_timer); }
+    void load_state(ByteReader& in) { in.get(_is_consumed); in.get(_life_timer); }
     void collide(ICollidable* object) override;
     void update(float delta_time) override; // concrete override so vtable exists
     void render(SDL_Renderer* renderer) override;
+    void render(SpriteBatch& batch);
 };
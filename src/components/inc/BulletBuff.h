@@ -12,7 +12,6 @@ enum class BulletBuffType {
     NUM = 4,
 };
 
-class Bullet;
 class BulletBuff : public Buff {
 private:
     BulletBuffType _type;
@@ -28,4 +27,6 @@ public:
     void timer_end() override;
     BulletBuffType getType() const { return _type; }
     void set_type(BulletBuffType type);
+    void save_state(ByteWriter& out) const override { Buff::save_state(out); out.put(_type); }
+    void load_state(ByteReader& in) override { Buff::load_state(in); in.get(_type); }
 };
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "BulletBuff.h"
+#include "OBB.h"
+#include "io/inc/ByteStream.h"
+#include "math/Vector2.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class ICollidable;
+class Explosion;
+struct SDL_Renderer;
+struct TextureRegion;
+class SpriteBatch;
+class JobSystem;
+template <typename T> class ObjectPool;
+
+// Every live bullet in one structure-of-arrays. Bullets are addressed by index
+// (stable until the next flush_destroyed()), so the update loop walks a few
+// contiguous arrays instead of chasing one heap object + heap OBB per bullet.
+// Dead bullets are removed with swap-and-pop; the arrays keep their capacity,
+// so steady-state shooting does not allocate.
+class BulletSystem {
+public:
+    static constexpr float LIFE_TIME = 10.0f;
+    static constexpr float DAMAGE = 10.0f;
+    static constexpr size_t DEFAULT_CAPACITY = 512;
+    // bouncing bullet trúng nhiều tường trong cùng một tick (góc tường) thì dừng sau ngần này lần
+    static constexpr int MAX_BOUNCES_PER_STEP = 4;
+    // bullets per job when update() is spread over a JobSystem
+    static constexpr size_t UPDATE_GRAIN = 256;
+
+    explicit BulletSystem(size_t capacity = DEFAULT_CAPACITY);
+
+    // Spawns a bullet flying along `direction` (expected normalized). Returns its index.
+    size_t spawn(Vector2 position, Vector2 direction, float damage, BulletBuffType buff, int team_id);
+
+    // Integrates every bullet: life timer, velocity + accumulated force, hitbox transform.
+    // Each bullet only touches its own slots, so with `jobs` the range is split across threads.
+    void update(float delta_time, JobSystem* jobs = nullptr);
+
+    // Narrowphase between bullet `index` and a world object; dispatches on the object's kind.
+    void collide(size_t index, ICollidable* object);
+    // Swept test against every candidate wall at once: the bullet stops (or bounces)
+    // at the earliest time of impact along its path this tick, not at its end position.
+    void collide_walls(size_t index, const std::vector<ICollidable*>& walls);
+    // Bullets of different teams destroy each other.
+    void collide_bullets(size_t a, size_t b);
+
+    // Removes destroyed bullets (swap-and-pop). EXPLODING bullets leave an explosion behind.
+    void flush_destroyed(ObjectPool<Explosion>& explosions);
+    void clear();
+
+    // Every live bullet, for Match snapshots. load_state() replaces the current set.
+    void save_state(ByteWriter& out) const;
+    bool load_state(ByteReader& in);
+
+    // alpha: interpolation between the previous and current simulation tick
+    // `sheet` is the bullet sheet (its own texture or an atlas region)
+    void render(SDL_Renderer* renderer, const TextureRegion& sheet, float alpha = 1.0f) const;
+    void render(SpriteBatch& batch, const TextureRegion& sheet, float alpha = 1.0f) const;
+    void debug_draw(SDL_Renderer* renderer, SDL_Color color);
+
+    size_t size() const { return _position.size(); }
+    bool empty() const { return _position.empty(); }
+
+    Vector2 get_position(size_t i) const { return _position[i]; }
+    Vector2 get_direction(size_t i) const { return _direction[i]; }
+    float get_damage(size_t i) const { return _damage[i]; }
+    int get_team_id(size_t i) const { return _team[i]; }
+    BulletBuffType get_buff(size_t i) const { return _buff[i]; }
+    OBB& get_hitbox(size_t i) { return _hitbox[i]; }
+    // hitbox bounds covering the whole path of the last update (for the wall broadphase)
+    AABB get_swept_bounds(size_t i) const;
+    bool is_destroyed(size_t i) const { return _destroyed[i] != 0; }
+    void set_destroyed(size_t i) { _destroyed[i] = 1; }
+    void add_force(size_t i, Vector2 force) { _force[i] += force; }
+
+private:
+    void collide_walls(size_t i, ICollidable* const* walls, size_t count);
+    void update_range(float delta_time, size_t begin, size_t end);
+    void remove(size_t i);
+
+    // hot: touched every update
+    std::vector<Vector2> _position;
+    std::vector<Vector2> _prev_position; // before the last update: render interpolation + wall sweep start
+    std::vector<Vector2> _direction;
+    std::vector<Vector2> _force;
+    std::vector<float> _angle;   // radians, cached from _direction (changes only on bounce)
+    std::vector<float> _life;
+    std::vector<OBB> _hitbox;
+    // cold: only read by collision / flush
+    std::vector<float> _damage;
+    std::vector<int> _team;
+    std::vector<BulletBuffType> _buff;
+    std::vector<uint8_t> _destroyed;
+};
@@ -27,4 +27,6 @@ public:
     void timer_end() override;
     void timer_start() { this->_activated = true; Buff::timer_start(); }
     CharBuffType get_type() const { return _type; }
+    void save_state(ByteWriter& out) const override { Buff::save_state(out); out.put(_activated); }
+    void load_state(ByteReader& in) override { Buff::load_state(in); in.get(_activated); }
 };
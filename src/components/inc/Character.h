@@ -5,13 +5,15 @@
 #include "CharBuff.h"
 #include "IInputObject.h"
 #include "IRenderable.h"
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 #include "AnimatedSprite.h"
 
 
 // forward decl
-class ResourceManager;
+class BulletSystem;
+class SpriteBatch;
 
 enum class GunType {
     PISTOL = 1,
@@ -52,20 +54,27 @@ private:
 
 
 public:
-    Character(Vector2 position, SDL_Texture *sprite, float speed, float health);
+    Character(Vector2 position, TextureRegion sprite, float speed, float health);
     float get_health() const { return this->_health; }
     BulletBuffType get_gun_buff_type() const { return _gun_buffed.getType(); }
     HitBox* get_collision();
     std::vector<HitBox*>& get_hitboxes() override { return _hitbox_list; }
-    void shoot(std::vector<Bullet*>& bullet_list, ResourceManager& resource_manager) override;
+    void shoot(BulletSystem& bullets) override;
     void set_activate(bool activated) override;
     void set_input_set(int input_set) override;
     void set_direction(Vector2 direction) override;
     void update(float delta_time) override;
     void collide(ICollidable* object) override;
+    // Bullets are not ICollidables; BulletSystem::collide routes here
+    void collide_bullet(BulletSystem& bullets, size_t index);
     void remove_buff(CharBuffType buff_type) override;
     void render(SDL_Renderer *renderer) override;
-    void render_activated_circle(SDL_Renderer *renderer);
+    // alpha: interpolation between the previous and current simulation tick
+    void render(SDL_Renderer *renderer, float alpha);
+    // sprite only; the activation circle is drawn by render_overlay() after the batch is flushed
+    void render(SpriteBatch& batch, float alpha);
+    void render_overlay(SDL_Renderer *renderer, float alpha);
+    void render_activated_circle(SDL_Renderer *renderer, Vector2 center);
 
     bool is_dead() const { return this->_health <= 0; }
 
@@ -89,5 +98,11 @@ public:
     void clear_bullet_buff() { _gun_buffed.set_type(BulletBuffType::NONE); }
     // Debug helpers: report active bullet buff and active char buffs
     BulletBuffType get_active_bullet_buff() const { return _gun_buffed.getType(); }
-    std::vector<CharBuffType> get_active_char_buffs() const;
+    // HUD reads this every frame: pass FrameArena::get() to keep it off the heap
+    std::pmr::vector<CharBuffType> get_active_char_buffs(std::pmr::memory_resource* memory = std::pmr::get_default_resource()) const;
+
+    // Simulation state only (no animation); load_state() expects a character
+    // built the same way, e.g. the same roster slot of a match with the same config
+    void save_state(ByteWriter& out) const;
+    void load_state(ByteReader& in);
 };
@@ -11,7 +11,7 @@ private:
     float _radius;
 
 public:
-    Circle(Vector2 local_pos, float radius) : HitBox(local_pos), _radius(radius) {}
+    Circle(Vector2 local_pos, float radius) : HitBox(local_pos, ShapeKind::CIRCLE), _radius(radius) {}
 
     float get_radius() const { return _radius; }
     void set_radius(float r) { _radius = r; }
@@ -25,5 +25,7 @@ public:
     bool is_collide(Circle& circle);
     bool is_collide(OBB& obb);
 
-    bool is_collide(HitBox& hitbox) override;
+    AABB get_bounds() const override {
+        return AABB::from_center(_local_pos, Vector2(_radius, _radius));
+    }
 };
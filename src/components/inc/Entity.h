@@ -4,24 +4,28 @@
 #include "IUpdatable.h"
 #include "math/Vector2.h"
 #include "HitBox.h"
+#include "assets/inc/TextureRegion.h"
 #include <vector>
 
-// Forward Declaration
-struct SDL_Texture;
-
 class Entity : public ICollidable, public IUpdatable {
 protected:
     Vector2 _position;
-    SDL_Texture* _sprite;
+    Vector2 _prev_position; // _position at the start of the last update, for render interpolation
+    TextureRegion _sprite;
     float _speed;
     Vector2 _force = ZERO;
     std::vector<HitBox*> _hitbox_list;
 
 public:
-    Entity(Vector2 position, SDL_Texture* sprite, float speed) : _position(position), _sprite(sprite), _speed(speed) {}
+    Entity(CollidableKind kind, Vector2 position, TextureRegion sprite, float speed) : ICollidable(kind), _position(position), _prev_position(position), _sprite(sprite), _speed(speed) {}
     virtual ~Entity() = default;
     Vector2 get_position() const { return this->_position; }
-    const SDL_Texture* get_sprite() const { return this->_sprite; }
+    // alpha = 0 -> previous tick, 1 -> current tick
+    Vector2 get_render_position(float alpha) const {
+        return this->_prev_position + (this->_position - this->_prev_position) * alpha;
+    }
+    const TextureRegion& get_sprite() const { return this->_sprite; }
+    void set_sprite(TextureRegion sprite) { this->_sprite = sprite; }
     const std::vector<HitBox*> get_collision() const {
         return this->_hitbox_list;
     }
@@ -3,31 +3,51 @@
 #include "AnimatedSprite.h"
 #include "math/Vector2.h"
 #include "Obstacle.h"
-#include <unordered_set>
+#include "io/inc/ByteStream.h"
+#include "Circle.h"
+#include <cstddef>
+#include <vector>
+
+class BulletSystem;
+class Character;
 
 class Explosion : public Obstacle {
 public:
     Explosion(SDL_Renderer* renderer, const std::string& sheetPath, Vector2 pos,
               int frameW, int frameH, int frameCount, int frameTime, int columns = 1, float damage = 25.0f, int owner_team = -1);
-    ~Explosion();
+    // hitbox points into this object
+    Explosion(const Explosion&) = delete;
+    Explosion& operator=(const Explosion&) = delete;
+
+    // Starts over at `pos` with the same sprite sheet (ObjectPool<Explosion>::spawn)
+    void reset(Vector2 pos, float damage = 25.0f, int owner_team = -1);
 
     float get_damage() const { return this->_damage; }
 
     void update(float dt) override;
     void render(SDL_Renderer* renderer) override;
+    void render(SpriteBatch& batch);
     void collide(ICollidable* object) override;
+    void collide_bullet(BulletSystem& bullets, size_t index);
 
     bool is_finished() const { return finished; }
+    int get_owner_team() const { return _owner_team; }
 
-    // explosion may damage multiple characters, but each character should be
-    // damaged at most once. The set below tracks which characters were hit.
+    // Progress + who was already hit, as indices into `roster` (Match snapshots).
+    // Position, damage and owner are constructor arguments, saved by the caller.
+    void save_state(ByteWriter& out, const std::vector<Character*>& roster) const;
+    void load_state(ByteReader& in, const std::vector<Character*>& roster);
 
 private:
-    AnimatedSprite* anim;
+    AnimatedSprite anim; // clip is null when headless
+    Circle _blast;
     float elapsed;
     float totalDurationMs;
     bool finished;
     float _damage;
     int _owner_team;
-    std::unordered_set<class Character*> _damaged;
+    // explosion may damage multiple characters, but each character should be
+    // damaged at most once. A handful of entries at most, so a flat list;
+    // its capacity survives reset(), so a recycled explosion does not allocate.
+    std::vector<Character*> _damaged;
 };
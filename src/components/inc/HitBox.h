@@ -1,17 +1,32 @@
 #pragma once
 
 #include "math/Vector2.h"
+#include "math/AABB.h"
 #include "SDL.h"
+#include <cstdint>
+
+// Compact shape tag so collision dispatch is a table lookup instead of dynamic_cast
+enum class ShapeKind : uint8_t {
+    RECT = 0,
+    CIRCLE = 1,
+    OBB = 2,
+    NUM = 3,
+};
 
 class HitBox {
 protected:
     Vector2 _local_pos;
+    ShapeKind _kind; // not const so shapes stored by value stay copy-assignable
 public:
-    HitBox(Vector2 local_pos) : _local_pos(local_pos) {}
+    HitBox(Vector2 local_pos, ShapeKind kind) : _local_pos(local_pos), _kind(kind) {}
     Vector2 get_local_pos() const {
         return this->_local_pos;
     }
+    ShapeKind get_kind() const { return _kind; }
     virtual void debug_draw(SDL_Renderer* renderer, SDL_Color color) = 0;
     virtual ~HitBox() = default;
-    virtual bool is_collide(HitBox& hitbox) = 0;
+    // Dispatches on (this kind, other kind) through a 2D function table
+    bool is_collide(HitBox& hitbox);
+    // World-space bounds, used by the broadphase to bin the hitbox into cells
+    virtual AABB get_bounds() const = 0;
 };
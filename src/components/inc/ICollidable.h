@@ -1,10 +1,26 @@
 #pragma once
 #include "HitBox.h"
+#include <cstdint>
 #include <vector>
 
+// Compact entity tag: collide() switches on it instead of typeid/dynamic_cast.
+// Bullets are not ICollidables; they live in BulletSystem and are addressed by index.
+enum class CollidableKind : uint8_t {
+    CHARACTER = 0,
+    WALL = 1,
+    BLACKHOLE = 2,
+    BUFF_ITEM = 3,
+    EXPLOSION = 4,
+    NUM = 5,
+};
+
 class ICollidable {
+private:
+    const CollidableKind _kind;
 public:
+    explicit ICollidable(CollidableKind kind) : _kind(kind) {}
     virtual ~ICollidable() = default;
+    CollidableKind get_kind() const { return _kind; }
     virtual void collide(ICollidable* object) = 0;
     virtual std::vector<HitBox*>& get_hitboxes() = 0;
 };
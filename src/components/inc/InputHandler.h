@@ -1,12 +1,12 @@
 #pragma once
 
 #include "IUpdatable.h"
+#include <cstdint>
 #include <vector>
 
 // Forward declarations
 class IInputObject;
-class Bullet;
-class ResourceManager;
+class BulletSystem;
 union SDL_Event;
 
 enum InputSet {
@@ -14,21 +14,48 @@ enum InputSet {
     INPUT_2
 };
 
+// One byte of input per tick: held directions plus the presses latched since
+// the previous tick. This is all a replay needs to reproduce a human player.
+enum InputBit : uint8_t {
+    INPUT_BIT_UP    = 1u << 0,
+    INPUT_BIT_DOWN  = 1u << 1,
+    INPUT_BIT_LEFT  = 1u << 2,
+    INPUT_BIT_RIGHT = 1u << 3,
+    INPUT_BIT_SWAP  = 1u << 4,
+    INPUT_BIT_SHOOT = 1u << 5,
+};
+
 class InputHandler : public IUpdatable {
 private:
     InputSet _input_set;
     IInputObject* _activated_char;
     IInputObject* _unactivated_char;
 
-    bool _up = false;
-    bool _down = false;
-    bool _left = false;
-    bool _right = false;
+    uint8_t _state = 0; // InputBit mask
+
+    void swap_characters();
 
 public:
-    void handle_event(SDL_Event& event, std::vector<Bullet*>& bullet_list, ResourceManager& resource_manager);
+    // Only records key state; nothing happens to the world until the next tick
+    void handle_event(SDL_Event& event);
+    // Start of a tick: runs the swap / shoot presses latched since the last tick
+    void apply_actions(BulletSystem& bullets);
+    // Moves the activated character along the held directions
     void update(float delta_time) override;
     InputHandler(InputSet input_set, IInputObject* char_, IInputObject* _unactivated_char);
     // Notify the handler that a character it references has died so it can swap control
     void on_character_death(IInputObject* dead);
+
+    // Replay hooks: read before apply_actions() when recording, overwrite it when playing back
+    uint8_t get_state() const { return _state; }
+    void set_state(uint8_t state) { _state = state; }
+    // Snapshot hooks: which character is driven right now (Match::save_state / load_state)
+    IInputObject* get_activated() const { return _activated_char; }
+    IInputObject* get_unactivated() const { return _unactivated_char; }
+    // Characters keep their own activated flag in their state, so this only rewires the pointers
+    void restore(uint8_t state, IInputObject* activated, IInputObject* unactivated) {
+        _state = state;
+        _activated_char = activated;
+        _unactivated_char = unactivated;
+    }
 };
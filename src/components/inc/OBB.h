@@ -2,22 +2,37 @@
 #include "HitBox.h"
 #include "math/Vector2.h"
 #include <SDL.h>
-#include <vector>
+#include <array>
 #include "Circle.h"
 
+// Kết quả của swept test: thời điểm chạm toi (0..1 dọc theo đoạn di chuyển)
+// và normal của mặt bị chạm, hướng ra ngoài OBB tĩnh (về phía vật đang bay tới).
+struct SweepHit {
+    float toi = 1.0f;
+    Vector2 normal;
+};
+
 class OBB : public HitBox {
 private:
     Vector2 _center;   // Tâm OBB
     Vector2 _halfSize; // Nửa kích thước (width/2, height/2)
     float _angle;      // Góc xoay (radian)
 
+    // Cache recomputed only in set_transform so collision tests never call cos/sin
+    std::array<Vector2, 2> _axes;    // trục local x/y (unit) trong world space
+    std::array<Vector2, 4> _corners; // 4 đỉnh trong world space
+
+    void update_axes();
+    void update_corners();
+
 public:
     OBB(Vector2 center, Vector2 halfSize, float angle = 0.0f);
 
     void set_transform(const Vector2& center, float angle);
 
     // Lấy ra 4 đỉnh sau khi xoay
-    std::vector<Vector2> get_corners() const;
+    const std::array<Vector2, 4>& get_corners() const { return _corners; }
+    const std::array<Vector2, 2>& get_axes() const { return _axes; }
     Vector2 get_center() const { return _center; }
     Vector2 get_halfSize() const { return _halfSize; }
     float get_angle() const { return _angle; }
@@ -25,10 +40,18 @@ public:
     // Vẽ debug
     void debug_draw(SDL_Renderer* renderer, SDL_Color color) override;
 
-    bool is_collide(HitBox& other) override;
+    using HitBox::is_collide;
+    AABB get_bounds() const override;
 
     // SAT collision check OBB-OBB
     bool is_collide(OBB& other);
 
     bool is_collide(Circle& circle);
+
+    // Swept SAT: `moving` tịnh tiến thêm `delta` (t = 0..1), OBB này đứng yên.
+    // Trả về true nếu chạm trong đoạn đó; nếu đã chồng nhau từ đầu thì toi = 0
+    // và normal là trục xuyên ít nhất.
+    bool sweep(const OBB& moving, const Vector2& delta, SweepHit& hit) const;
+    // Đoạn thẳng origin -> origin + delta (slab test trong local space của OBB)
+    bool raycast(const Vector2& origin, const Vector2& delta, SweepHit& hit) const;
 };
@@ -3,6 +3,7 @@
 #include "ICollidable.h"
 #include "IUpdatable.h"
 #include "IRenderable.h"
+#include "assets/inc/TextureRegion.h"
 #include <vector>
 
 // Forward declarations
@@ -12,15 +13,17 @@ class Vector2;
 class Obstacle : public ICollidable, public IUpdatable, public IRenderable {
 protected:
     Vector2 _position;
-    SDL_Texture* _sprite;
+    TextureRegion _sprite;
     std::vector<HitBox*> _hitbox_list;
 
 public:
-    Obstacle(Vector2 position, SDL_Texture* sprite, std::vector<HitBox*> hitbox_list) : _position(position), _sprite(sprite), _hitbox_list(hitbox_list){}
+    Obstacle(CollidableKind kind, Vector2 position, TextureRegion sprite, std::vector<HitBox*> hitbox_list) : ICollidable(kind), _position(position), _sprite(sprite), _hitbox_list(hitbox_list){}
     virtual ~Obstacle() = default;
     std::vector<HitBox*>& get_hitboxes() override { return this->_hitbox_list; }
     Vector2 get_position() const { return this->_position; }
-    const SDL_Texture* get_sprite() const { return this->_sprite; };
+    const TextureRegion& get_sprite() const { return this->_sprite; };
+    // Presentation may attach a sprite after the simulation created the object
+    void set_sprite(TextureRegion sprite) { this->_sprite = sprite; }
     virtual void update(float delta_time) override = 0;
     virtual void collide(ICollidable* object) override = 0;
     virtual void render(SDL_Renderer* renderer) override = 0;
@@ -12,7 +12,7 @@ private:
     float _angle; 
 
 public:
-    Rect(Vector2 local_pos, SDL_Rect rect, float angle = 0.0f) : HitBox(local_pos), _rect(rect), _angle(angle) {}
+    Rect(Vector2 local_pos, SDL_Rect rect, float angle = 0.0f) : HitBox(local_pos, ShapeKind::RECT), _rect(rect), _angle(angle) {}
     SDL_Rect get_rect() const {
         return this->_rect;
     }
@@ -26,5 +26,5 @@ public:
     using HitBox::is_collide;
     bool is_collide(Rect& rect);
     bool is_collide(Circle& circle);
-    bool is_collide(HitBox& hitbox) override;
+    AABB get_bounds() const override;
 };
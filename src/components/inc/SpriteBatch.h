@@ -0,0 +1,67 @@
+#pragma once
+
+#include "assets/inc/TextureRegion.h"
+#include "math/Vector2.h"
+#include <SDL_render.h>
+#include <cstddef>
+#include <vector>
+
+// Draw order of the world sprites, lowest first (same order the game loops
+// used to issue their RenderCopy calls in).
+enum class SpriteLayer {
+    WALLS,
+    CHARACTERS,
+    BULLETS,
+    EXPLOSIONS,
+    BLOOD,
+    SMOKE,
+    BUFFS,
+    BLACKHOLES,
+    NUM,
+};
+
+// Collects textured (optionally rotated) quads for a frame and submits them in
+// flush(): per layer, one SDL_RenderGeometry per texture, in the order the
+// textures first appeared in that layer. Draw calls therefore scale with the
+// number of textures, not with the number of bullets/effects on screen, and
+// sprites that share an atlas page (TextureRegion) share a draw call.
+// Each texture's size is queried once per frame when its bucket is first used.
+class SpriteBatch {
+public:
+    explicit SpriteBatch(SDL_Renderer* renderer) : _renderer(renderer) {}
+
+    void begin();
+    void set_layer(SpriteLayer layer) { _layer = (int)layer; }
+
+    // Same meaning as SDL_RenderCopyEx: src nullptr = whole texture, angle in
+    // degrees clockwise around `center` (relative to dst, nullptr = dst center).
+    void draw(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect& dst,
+              double angle = 0.0, const SDL_FPoint* center = nullptr);
+    // Sprite at its native size, centered on `position`.
+    void draw_centered(const TextureRegion& sprite, Vector2 position);
+    // Bulk path for many small quads (particles): makes room for `count` quads
+    // of `texture` in the current layer and returns their 4 * count vertices
+    // (top-left, top-right, bottom-right, bottom-left) for the caller to fill;
+    // the indices are already written. nullptr if count is 0 or no texture.
+    SDL_Vertex* add_quads(SDL_Texture* texture, size_t count);
+
+    void flush();
+    int get_draw_calls() const { return _draw_calls; } // submitted by the last flush()
+
+private:
+    struct Bucket {
+        SDL_Texture* texture = nullptr;
+        int width = 0, height = 0;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    Bucket* bucket_for(SDL_Texture* texture);
+
+    SDL_Renderer* _renderer;
+    int _layer = 0;
+    // buckets stay allocated across frames; _used[layer] is how many are live this frame
+    std::vector<Bucket> _buckets[(int)SpriteLayer::NUM];
+    size_t _used[(int)SpriteLayer::NUM] = {};
+    int _draw_calls = 0;
+};
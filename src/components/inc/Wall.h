@@ -3,11 +3,18 @@
 #include "Obstacle.h"
 #include "ICollidable.h"
 
+class SpriteBatch;
+
 class Wall : public Obstacle {
 public:
-    Wall(Vector2 position, SDL_Texture* sprite);
+    // Hitbox sized from the sprite
+    Wall(Vector2 position, TextureRegion sprite);
+    // Explicit hitbox size: no texture needed (headless simulation), sprite may be attached later
+    Wall(Vector2 position, Vector2 half_size, TextureRegion sprite = TextureRegion());
     ~Wall();
     void collide(ICollidable* object) override;
     void update(float delta_time) override;
     void render(SDL_Renderer* renderer) override;
+    // Sprite stretched over the hitbox, so one small atlas swatch can draw every wall
+    void render(SpriteBatch& batch);
 };
@@ -0,0 +1,79 @@
+#include "inc/AllocCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> s_count{ 0 };
+    std::atomic<uint64_t> s_bytes{ 0 };
+
+    void* counted_alloc(std::size_t size) {
+        s_count.fetch_add(1, std::memory_order_relaxed);
+        s_bytes.fetch_add(size, std::memory_order_relaxed);
+        // malloc(0) may return nullptr, new must not
+        return std::malloc(size ? size : 1);
+    }
+
+    void* counted_alloc_aligned(std::size_t size, std::size_t alignment) {
+        s_count.fetch_add(1, std::memory_order_relaxed);
+        s_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (alignment < sizeof(void*)) alignment = sizeof(void*);
+        void* p = nullptr;
+#if defined(_WIN32)
+        p = _aligned_malloc(size ? size : 1, alignment);
+#else
+        if (posix_memalign(&p, alignment, size ? size : 1) != 0) p = nullptr;
+#endif
+        return p;
+    }
+
+    void counted_free_aligned(void* p) {
+#if defined(_WIN32)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+uint64_t AllocCounter::get_count() { return s_count.load(std::memory_order_relaxed); }
+uint64_t AllocCounter::get_bytes() { return s_bytes.load(std::memory_order_relaxed); }
+
+// Replacements for the global allocation functions. The throwing forms throw
+// std::bad_alloc like the originals; the nothrow forms return nullptr.
+
+void* operator new(std::size_t size) {
+    if (void* p = counted_alloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = counted_alloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void* operator new(std::size_t size, std::align_val_t al) {
+    if (void* p = counted_alloc_aligned(size, (std::size_t)al)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t al) {
+    if (void* p = counted_alloc_aligned(size, (std::size_t)al)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_alloc_aligned(size, (std::size_t)al); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return counted_alloc_aligned(size, (std::size_t)al); }
+
+void operator delete(void* p, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free_aligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free_aligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { counted_free_aligned(p); }
@@ -0,0 +1,104 @@
+#include "inc/Profiler.h"
+#include "inc/AllocCounter.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+Profiler::Profiler() : _trace_origin_us(now_us()) {}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::set_enabled(bool enabled) {
+    if (enabled && !s_enabled) {
+        for (auto& frame : _frames) for (double& ms : frame) ms = 0.0;
+        _current = 0;
+        _filled = 0;
+        _alloc_mark = AllocCounter::get_count();
+    }
+    s_enabled = enabled;
+}
+
+int Profiler::register_scope(const char* name) {
+    // same name from two call sites shares one row
+    for (int i = 0; i < _scope_count; ++i) {
+        if (std::strcmp(_names[i], name) == 0) return i;
+    }
+    if (_scope_count == MAX_SCOPES) {
+        std::cerr << "Profiler: too many scopes, ignoring " << name << "\n";
+        return -1;
+    }
+    _names[_scope_count] = name;
+    return _scope_count++;
+}
+
+void Profiler::add_sample(int id, int64_t start_us, int64_t end_us) {
+    if (id < 0) return;
+    _frames[_current][id] += (end_us - start_us) / 1000.0;
+    if (_trace_enabled && _trace.size() < MAX_TRACE_EVENTS) {
+        _trace.push_back({ id, start_us - _trace_origin_us, end_us - start_us });
+    }
+}
+
+void Profiler::end_frame() {
+    if (!s_enabled) return;
+    uint64_t allocs = AllocCounter::get_count();
+    _allocs[_current] = allocs - _alloc_mark;
+    _alloc_mark = allocs;
+    _current = (_current + 1) % HISTORY;
+    if (_filled < HISTORY) ++_filled;
+    for (int i = 0; i < _scope_count; ++i) _frames[_current][i] = 0.0;
+}
+
+void Profiler::get_stats(std::vector<Stats>& out) const {
+    out.clear();
+    if (_filled == 0) return;
+    for (int s = 0; s < _scope_count; ++s) {
+        Stats st = { _names[s], 0.0, 0.0, 0.0 };
+        bool first = true;
+        // completed frames only; the slot at _current is still being written
+        for (int k = 1; k <= _filled; ++k) {
+            double ms = _frames[(_current - k + HISTORY) % HISTORY][s];
+            if (first || ms < st.min_ms) st.min_ms = ms;
+            if (first || ms > st.max_ms) st.max_ms = ms;
+            st.avg_ms += ms;
+            first = false;
+        }
+        st.avg_ms /= _filled;
+        out.push_back(st);
+    }
+}
+
+Profiler::AllocStats Profiler::get_alloc_stats() const {
+    AllocStats st = { 0, 0, 0.0 };
+    for (int k = 1; k <= _filled; ++k) {
+        uint64_t n = _allocs[(_current - k + HISTORY) % HISTORY];
+        if (k == 1 || n < st.min) st.min = n;
+        if (n > st.max) st.max = n;
+        st.avg += (double)n;
+    }
+    if (_filled > 0) st.avg /= _filled;
+    return st;
+}
+
+bool Profiler::write_chrome_trace(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        std::cerr << "Profiler: cannot write trace to " << path << "\n";
+        return false;
+    }
+    // Trace Event Format: complete ("X") events, microseconds
+    std::fprintf(f, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < _trace.size(); ++i) {
+        const TraceEvent& e = _trace[i];
+        std::fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lld,\"dur\":%lld}\n",
+                     i ? "," : "", _names[e.id], (long long)e.start_us, (long long)e.duration_us);
+    }
+    std::fprintf(f, "],\"displayTimeUnit\":\"ms\"}\n");
+    std::fclose(f);
+    if (_trace.size() >= MAX_TRACE_EVENTS) std::cerr << "Profiler: trace buffer was full, later events dropped\n";
+    std::cerr << "Profiler: wrote " << _trace.size() << " events to " << path << "\n";
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Counts every trip to the heap. AllocCounter.cpp replaces the global
+// operator new/delete for the whole program, so every container, std::string
+// and `new` in our code is counted; malloc calls made inside C libraries such
+// as SDL are not.
+// Take a reading before and after a frame to check the steady state stays at
+// zero:
+//     uint64_t before = AllocCounter::get_count();
+//     ... one frame ...
+//     uint64_t allocs = AllocCounter::get_count() - before;
+// Counters are relaxed atomics: exact, cheap, safe from job threads.
+namespace AllocCounter {
+    uint64_t get_count(); // operator new calls since start-up
+    uint64_t get_bytes(); // bytes requested by those calls
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frame profiler. Code marks phases with PROFILE_SCOPE("collide.bullets"); the
+// time spent in each named scope is summed per frame into a ring buffer of the
+// last HISTORY frames, from which the overlay reads rolling min/avg/max.
+// Each frame also records how many heap allocations it made (AllocCounter), so
+// the overlay shows whether the steady state really stays off malloc.
+// Optionally every scope is also kept as a trace event and written out as a
+// Chrome trace (chrome://tracing, Perfetto) to look at spikes offline.
+// Single-threaded: scopes must be opened and closed on the game loop thread.
+// Off by default; a disabled scope costs one branch and no clock reads, which
+// matters for the headless simulation running a million ticks per second.
+class Profiler {
+public:
+    static constexpr int HISTORY = 120;       // frames kept for min/avg/max
+    static constexpr int MAX_SCOPES = 64;
+    static constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    struct Stats {
+        const char* name;
+        double min_ms, avg_ms, max_ms;
+    };
+
+    struct AllocStats {
+        uint64_t min, max;
+        double avg;
+    };
+
+    static Profiler& instance();
+
+    static bool is_enabled() { return s_enabled; }
+    // Turning it on starts the rolling stats from scratch.
+    void set_enabled(bool enabled);
+
+    // Ids are handed out once per call site (see PROFILE_SCOPE), names must be string literals.
+    int register_scope(const char* name);
+    void add_sample(int id, int64_t start_us, int64_t end_us);
+
+    void end_frame(); // closes the current frame and moves the ring forward
+    void get_stats(std::vector<Stats>& out) const; // scopes in registration order
+    AllocStats get_alloc_stats() const;            // heap allocations per frame
+
+    void set_trace_enabled(bool enabled) { _trace_enabled = enabled; }
+    bool is_trace_enabled() const { return _trace_enabled; }
+    bool write_chrome_trace(const std::string& path) const;
+
+    static int64_t now_us() {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    Profiler();
+
+    static inline bool s_enabled = false;
+
+    struct TraceEvent {
+        int id;
+        int64_t start_us;
+        int64_t duration_us;
+    };
+
+    const char* _names[MAX_SCOPES] = {};
+    int _scope_count = 0;
+    double _frames[HISTORY][MAX_SCOPES] = {}; // ms per scope per frame
+    uint64_t _allocs[HISTORY] = {};           // operator new calls per frame
+    uint64_t _alloc_mark = 0;                 // AllocCounter at the start of the current frame
+    int _current = 0;
+    int _filled = 0; // completed frames in the ring, up to HISTORY
+
+    bool _trace_enabled = false;
+    int64_t _trace_origin_us;
+    std::vector<TraceEvent> _trace;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(int id) : _id(id), _start_us(Profiler::is_enabled() ? Profiler::now_us() : -1) {}
+    ~ProfileScope() {
+        if (_start_us >= 0) Profiler::instance().add_sample(_id, _start_us, Profiler::now_us());
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int _id;
+    int64_t _start_us;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// Times the rest of the enclosing block under `name`.
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_CONCAT(_profile_id_, __LINE__) = Profiler::instance().register_scope(name); \
+    ProfileScope PROFILE_CONCAT(_profile_scope_, __LINE__)(PROFILE_CONCAT(_profile_id_, __LINE__))
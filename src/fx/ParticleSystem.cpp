@@ -0,0 +1,301 @@
+#include "inc/ParticleSystem.h"
+#include "ResourceManager.h"
+#include "Constant.h"
+#include "jobs/inc/JobSystem.h"
+#include "assets/inc/AssetPack.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+// particles per job; below this one thread is faster than handing work out
+static const size_t PARTICLE_GRAIN = 4096;
+
+static const char* const SPRITE_LAYER_NAMES[(int)SpriteLayer::NUM] = {
+    "walls", "characters", "bullets", "explosions", "blood", "smoke", "buffs", "blackholes",
+};
+
+static bool parse_sprite_layer(const std::string& name, SpriteLayer& out) {
+    for (int l = 0; l < (int)SpriteLayer::NUM; ++l) {
+        if (name == SPRITE_LAYER_NAMES[l]) { out = (SpriteLayer)l; return true; }
+    }
+    return false;
+}
+
+static uint8_t lerp_channel(uint8_t a, uint8_t b, float f) {
+    return (uint8_t)std::lround(a + (b - a) * f);
+}
+
+// Samples the color keys into desc.lut; no keys = opaque white
+static void bake_color_lut(ParticleSystem::EmitterDesc& desc) {
+    for (int i = 0; i < ParticleSystem::COLOR_LUT_SIZE; ++i) {
+        if (desc.key_count == 0) { desc.lut[i] = { 255, 255, 255, 255 }; continue; }
+        float t = (float)i / (ParticleSystem::COLOR_LUT_SIZE - 1);
+        const ParticleSystem::ColorKey* keys = desc.keys;
+        int k = 0;
+        while (k + 1 < desc.key_count && keys[k + 1].t <= t) ++k;
+        if (k + 1 == desc.key_count || t <= keys[k].t) { desc.lut[i] = keys[k].color; continue; }
+        const SDL_Color& a = keys[k].color;
+        const SDL_Color& b = keys[k + 1].color;
+        float f = (t - keys[k].t) / (keys[k + 1].t - keys[k].t);
+        desc.lut[i] = { lerp_channel(a.r, b.r, f), lerp_channel(a.g, b.g, f), lerp_channel(a.b, b.b, f), lerp_channel(a.a, b.a, f) };
+    }
+}
+
+bool ParticleSystem::load(const std::string& path) {
+    clear();
+    _layers.clear();
+    _descs.clear();
+    std::string text;
+    if (!AssetPack::read_file(path, text)) {
+        std::cerr << "ParticleSystem: cannot open " << path << "\n";
+        return false;
+    }
+    std::istringstream in(text);
+
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream ss(line);
+        std::string keyword;
+        if (!(ss >> keyword)) continue; // blank / comment-only line
+
+        bool ok = false;
+        EmitterDesc* desc = _descs.empty() ? nullptr : &_descs.back();
+        if (keyword == "layer") {
+            Layer layer;
+            std::string sprite_layer;
+            ok = (bool)(ss >> layer.name >> sprite_layer >> layer.texture_path >> layer.src.x >> layer.src.y >> layer.src.w >> layer.src.h)
+                 && parse_sprite_layer(sprite_layer, layer.draw_layer) && layer.src.w > 0 && layer.src.h > 0;
+            if (ok) _layers.push_back(std::move(layer));
+        } else if (keyword == "emitter") {
+            EmitterDesc d;
+            std::string layer_name;
+            ok = (bool)(ss >> d.name >> layer_name);
+            d.layer = -1;
+            for (size_t l = 0; ok && l < _layers.size(); ++l) {
+                if (_layers[l].name == layer_name) d.layer = (int)l;
+            }
+            if (ok && d.layer < 0) {
+                std::cerr << path << ":" << line_no << ": unknown layer '" << layer_name << "'\n";
+                _layers.clear();
+                _descs.clear();
+                return false;
+            }
+            if (ok) _descs.push_back(d);
+        } else if (!desc) {
+            std::cerr << path << ":" << line_no << ": '" << keyword << "' before any emitter\n";
+            _layers.clear();
+            _descs.clear();
+            return false;
+        } else if (keyword == "burst") {
+            ok = (bool)(ss >> desc->burst) && desc->burst >= 0;
+        } else if (keyword == "rate") {
+            ok = (bool)(ss >> desc->rate) && desc->rate >= 0.0f;
+        } else if (keyword == "duration") {
+            ok = (bool)(ss >> desc->duration) && desc->duration >= 0.0f;
+        } else if (keyword == "life") {
+            ok = (bool)(ss >> desc->life_min >> desc->life_max) && desc->life_min > 0.0f && desc->life_max >= desc->life_min;
+        } else if (keyword == "speed") {
+            ok = (bool)(ss >> desc->speed_min >> desc->speed_max) && desc->speed_max >= desc->speed_min;
+        } else if (keyword == "angle") {
+            ok = (bool)(ss >> desc->direction >> desc->spread);
+        } else if (keyword == "size") {
+            ok = (bool)(ss >> desc->size_start >> desc->size_end) && desc->size_start >= 0.0f && desc->size_end >= 0.0f;
+        } else if (keyword == "drag") {
+            ok = (bool)(ss >> desc->drag) && desc->drag >= 0.0f;
+        } else if (keyword == "gravity") {
+            ok = (bool)(ss >> desc->gravity.x >> desc->gravity.y);
+        } else if (keyword == "color") {
+            ColorKey key;
+            int r, g, b, a;
+            ok = (bool)(ss >> key.t >> r >> g >> b >> a) && desc->key_count < MAX_COLOR_KEYS
+                 && key.t >= 0.0f && key.t <= 1.0f && (desc->key_count == 0 || key.t > desc->keys[desc->key_count - 1].t);
+            if (ok) {
+                auto channel = [](int v) { return (uint8_t)std::min(255, std::max(0, v)); };
+                key.color = { channel(r), channel(g), channel(b), channel(a) };
+                desc->keys[desc->key_count++] = key;
+            }
+        } else {
+            std::cerr << path << ":" << line_no << ": unknown record '" << keyword << "'\n";
+            _layers.clear();
+            _descs.clear();
+            return false;
+        }
+        std::string extra;
+        if (ok && (ss >> extra)) ok = false; // trailing garbage
+        if (!ok) {
+            std::cerr << path << ":" << line_no << ": malformed '" << keyword << "' record\n";
+            _layers.clear();
+            _descs.clear();
+            return false;
+        }
+    }
+
+    for (auto& d : _descs) bake_color_lut(d);
+    for (auto& layer : _layers) {
+        layer.x.resize(MAX_PARTICLES_PER_LAYER);
+        layer.y.resize(MAX_PARTICLES_PER_LAYER);
+        layer.vx.resize(MAX_PARTICLES_PER_LAYER);
+        layer.vy.resize(MAX_PARTICLES_PER_LAYER);
+        layer.age.resize(MAX_PARTICLES_PER_LAYER);
+        layer.life.resize(MAX_PARTICLES_PER_LAYER);
+        layer.desc.resize(MAX_PARTICLES_PER_LAYER);
+    }
+    _active.reserve(MAX_EMITTERS);
+    return true;
+}
+
+void ParticleSystem::load_textures(ResourceManager& rm) {
+    for (auto& layer : _layers) {
+        TextureRegion sprite = rm.load_sprite("fx:" + layer.texture_path, layer.texture_path);
+        int w = 0, h = 0;
+        if (!sprite || SDL_QueryTexture(sprite.texture, NULL, NULL, &w, &h) != 0 || w <= 0 || h <= 0) {
+            std::cerr << "ParticleSystem: cannot load " << layer.texture_path << " for layer " << layer.name << "\n";
+            layer.texture = nullptr;
+            continue;
+        }
+        // src is relative to the image; the image may sit anywhere in an atlas page
+        layer.texture = sprite.texture;
+        SDL_Rect src = sprite.to_texture(layer.src);
+        layer.u0 = (float)src.x / w;
+        layer.v0 = (float)src.y / h;
+        layer.u1 = (float)(src.x + src.w) / w;
+        layer.v1 = (float)(src.y + src.h) / h;
+    }
+}
+
+int ParticleSystem::find(const std::string& name) const {
+    for (size_t i = 0; i < _descs.size(); ++i) {
+        if (_descs[i].name == name) return (int)i;
+    }
+    return -1;
+}
+
+float ParticleSystem::random01() {
+    // xorshift32: plenty for scattering particles, and cheap
+    uint32_t s = _rng_state;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    _rng_state = s;
+    return (s >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleSystem::start(int emitter, Vector2 position, float direction) {
+    if (emitter < 0 || emitter >= (int)_descs.size()) return;
+    const EmitterDesc& d = _descs[emitter];
+    emit(emitter, position, direction, d.burst);
+    if (d.rate > 0.0f && d.duration > 0.0f && _active.size() < MAX_EMITTERS) {
+        _active.push_back({ emitter, position, direction, d.duration, 0.0f });
+    }
+}
+
+void ParticleSystem::emit(int desc_index, Vector2 position, float direction, int count) {
+    const EmitterDesc& d = _descs[desc_index];
+    Layer& layer = _layers[d.layer];
+    const float deg = PI / 180.0f;
+    for (int k = 0; k < count && layer.count < MAX_PARTICLES_PER_LAYER; ++k) {
+        size_t i = layer.count++;
+        float angle = (d.direction + direction + (random01() - 0.5f) * d.spread) * deg;
+        float speed = d.speed_min + (d.speed_max - d.speed_min) * random01();
+        layer.x[i] = position.x;
+        layer.y[i] = position.y;
+        layer.vx[i] = std::cos(angle) * speed;
+        layer.vy[i] = std::sin(angle) * speed;
+        layer.age[i] = 0.0f;
+        layer.life[i] = d.life_min + (d.life_max - d.life_min) * random01();
+        layer.desc[i] = (uint16_t)desc_index;
+    }
+}
+
+void ParticleSystem::integrate(Layer& layer, size_t begin, size_t end, float dt) const {
+    float* x = layer.x.data();
+    float* y = layer.y.data();
+    float* vx = layer.vx.data();
+    float* vy = layer.vy.data();
+    float* age = layer.age.data();
+    const uint16_t* desc = layer.desc.data();
+    for (size_t i = begin; i < end; ++i) {
+        const EmitterDesc& d = _descs[desc[i]];
+        float keep = std::max(0.0f, 1.0f - d.drag * dt);
+        vx[i] = vx[i] * keep + d.gravity.x * dt;
+        vy[i] = vy[i] * keep + d.gravity.y * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        age[i] += dt;
+    }
+}
+
+void ParticleSystem::update(float dt, JobSystem* jobs) {
+    // continuous emitters first, so new particles move this frame too
+    for (size_t e = 0; e < _active.size();) {
+        ActiveEmitter& em = _active[e];
+        float owed = _descs[em.desc].rate * std::min(dt, em.time_left) + em.carry;
+        int count = (int)owed;
+        em.carry = owed - count;
+        emit(em.desc, em.position, em.direction, count);
+        em.time_left -= dt;
+        if (em.time_left <= 0.0f) {
+            em = _active.back();
+            _active.pop_back();
+        } else {
+            ++e;
+        }
+    }
+
+    for (auto& layer : _layers) {
+        parallel_for(jobs, layer.count, PARTICLE_GRAIN, [this, &layer, dt](size_t begin, size_t end) {
+            integrate(layer, begin, end, dt);
+        });
+        // expired particles: the last one takes the slot
+        size_t i = 0;
+        while (i < layer.count) {
+            if (layer.age[i] < layer.life[i]) { ++i; continue; }
+            size_t last = --layer.count;
+            layer.x[i] = layer.x[last];
+            layer.y[i] = layer.y[last];
+            layer.vx[i] = layer.vx[last];
+            layer.vy[i] = layer.vy[last];
+            layer.age[i] = layer.age[last];
+            layer.life[i] = layer.life[last];
+            layer.desc[i] = layer.desc[last];
+        }
+    }
+}
+
+void ParticleSystem::render(SpriteBatch& batch) const {
+    for (const auto& layer : _layers) {
+        if (!layer.texture || layer.count == 0) continue;
+        batch.set_layer(layer.draw_layer);
+        SDL_Vertex* v = batch.add_quads(layer.texture, layer.count);
+        if (!v) continue;
+        for (size_t i = 0; i < layer.count; ++i, v += 4) {
+            const EmitterDesc& d = _descs[layer.desc[i]];
+            float t = std::min(1.0f, layer.age[i] / layer.life[i]);
+            float half = 0.5f * (d.size_start + (d.size_end - d.size_start) * t);
+            SDL_Color color = d.lut[(int)(t * (COLOR_LUT_SIZE - 1) + 0.5f)];
+            float x0 = layer.x[i] - half, x1 = layer.x[i] + half;
+            float y0 = layer.y[i] - half, y1 = layer.y[i] + half;
+            v[0] = { { x0, y0 }, color, { layer.u0, layer.v0 } };
+            v[1] = { { x1, y0 }, color, { layer.u1, layer.v0 } };
+            v[2] = { { x1, y1 }, color, { layer.u1, layer.v1 } };
+            v[3] = { { x0, y1 }, color, { layer.u0, layer.v1 } };
+        }
+    }
+}
+
+void ParticleSystem::clear() {
+    for (auto& layer : _layers) layer.count = 0;
+    _active.clear();
+}
+
+size_t ParticleSystem::get_particle_count() const {
+    size_t total = 0;
+    for (const auto& layer : _layers) total += layer.count;
+    return total;
+}
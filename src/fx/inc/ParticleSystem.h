@@ -0,0 +1,124 @@
+#pragma once
+
+#include "components/inc/SpriteBatch.h"
+#include "math/Vector2.h"
+#include <SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class JobSystem;
+class ResourceManager;
+
+// Particle effects (blood, smoke, and later muzzle flash, casings, debris):
+// thousands of short-lived textured quads instead of one Obstacle +
+// AnimatedSprite per effect.
+//
+// Everything comes from an effects file (assets/fx/*.fx), one record per line,
+// '#' starts a comment:
+//   layer   <name> <sprite layer> <texture> <src x> <src y> <src w> <src h>
+//   emitter <name> <layer>
+// followed by the properties of the last emitter, all optional:
+//   burst    <count>               particles at start
+//   rate     <per second>          continuous emission ...
+//   duration <seconds>             ... for this long after start
+//   life     <min> <max>           seconds
+//   speed    <min> <max>           px/s
+//   angle    <direction> <spread>  degrees, 0 = +x, clockwise; spread is centered on direction
+//   size     <start> <end>         px, linear over the particle's life
+//   drag     <per second>          fraction of the velocity lost per second
+//   gravity  <x> <y>               px/s^2
+//   color    <t> <r> <g> <b> <a>   key of the color/alpha curve, t in [0, 1], up to 4 keys
+// A layer is one texture (a sub-rect of it) drawn in one SpriteLayer, so each
+// layer is one SDL_RenderGeometry call no matter how many particles it has.
+//
+// Particles of a layer live in parallel arrays (structure of arrays) with a
+// fixed capacity, removed by swap-and-pop; the update is a straight pass over
+// floats and the emitter parameters are looked up per particle through a small
+// index. Presentation only: it has its own random generator and never touches
+// the simulation.
+class ParticleSystem {
+public:
+    static constexpr size_t MAX_PARTICLES_PER_LAYER = 65536;
+    static constexpr size_t MAX_EMITTERS = 256;
+    static constexpr int MAX_COLOR_KEYS = 4;
+    static constexpr int COLOR_LUT_SIZE = 32; // curve samples per emitter
+
+    struct ColorKey {
+        float t;
+        SDL_Color color;
+    };
+
+    struct EmitterDesc {
+        std::string name;
+        int layer = 0;
+        int burst = 0;
+        float rate = 0.0f;
+        float duration = 0.0f;
+        float life_min = 0.5f, life_max = 0.5f;
+        float speed_min = 0.0f, speed_max = 0.0f;
+        float direction = 0.0f, spread = 360.0f;
+        float size_start = 8.0f, size_end = 8.0f;
+        float drag = 0.0f;
+        Vector2 gravity;
+        ColorKey keys[MAX_COLOR_KEYS] = {};
+        int key_count = 0;
+        SDL_Color lut[COLOR_LUT_SIZE]; // the curve, sampled at load
+    };
+
+    // Replaces every layer and emitter with the contents of `path`.
+    // false on error (reason printed to stderr); the system is left empty.
+    bool load(const std::string& path);
+    // Loads the layer textures through `rm`; until then nothing is drawn (headless)
+    void load_textures(ResourceManager& rm);
+
+    // Emitter index for start(), -1 if there is no such emitter
+    int find(const std::string& name) const;
+    // Burst now, then `rate` per second for `duration` at `position`.
+    // `direction` (degrees) turns the emitter's own angle. An emitter index of -1 is a no-op.
+    void start(int emitter, Vector2 position, float direction = 0.0f);
+
+    // Moves and ages every particle; with `jobs` the integration is split across threads
+    void update(float dt, JobSystem* jobs = nullptr);
+    // One batch per layer, each in its own SpriteLayer (changes the batch's current layer)
+    void render(SpriteBatch& batch) const;
+    void clear();
+
+    size_t get_particle_count() const;
+    const EmitterDesc& get_emitter(int index) const { return _descs[index]; }
+
+private:
+    struct Layer {
+        std::string name;
+        SpriteLayer draw_layer = SpriteLayer::SMOKE;
+        std::string texture_path;
+        SDL_Rect src = { 0, 0, 0, 0 };
+        SDL_Texture* texture = nullptr;
+        float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+
+        // live particles are [0, count); the arrays are allocated once at MAX_PARTICLES_PER_LAYER
+        size_t count = 0;
+        std::vector<float> x, y, vx, vy;
+        std::vector<float> age, life;
+        std::vector<uint16_t> desc; // emitter that spawned it (drag, gravity, size, color)
+    };
+
+    // continuous emission still running
+    struct ActiveEmitter {
+        int desc;
+        Vector2 position;
+        float direction;
+        float time_left;
+        float carry; // fractional particles owed from the last update
+    };
+
+    void emit(int desc, Vector2 position, float direction, int count);
+    void integrate(Layer& layer, size_t begin, size_t end, float dt) const;
+    float random01();
+
+    std::vector<Layer> _layers;
+    std::vector<EmitterDesc> _descs;
+    std::vector<ActiveEmitter> _active; // capacity MAX_EMITTERS
+    uint32_t _rng_state = 0x9E3779B9u;
+};
@@ -0,0 +1,189 @@
+#include "inc/Arena.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+
+static const char ARENA_MAGIC[4] = { 'G', 'P', 'A', 'R' };
+
+// the cooked image is memcpy'd / mmap'd straight into these
+static_assert(std::is_trivially_copyable<ArenaRect>::value && sizeof(ArenaRect) == 16, "ArenaRect layout");
+static_assert(std::is_trivially_copyable<ArenaSpawn>::value && sizeof(ArenaSpawn) == 16, "ArenaSpawn layout");
+static_assert(std::is_trivially_copyable<ArenaHeader>::value && sizeof(ArenaHeader) == 40, "ArenaHeader layout");
+
+static bool ends_with(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+static size_t align4(size_t n) {
+    return (n + 3) & ~(size_t)3;
+}
+
+// Header + the four record arrays, each 4-aligned, in section order
+static std::vector<uint8_t> cook(const std::vector<ArenaRect>& walls, const std::vector<ArenaSpawn>& spawns,
+                                 const std::vector<ArenaRect>& buff_zones, const std::vector<ArenaRect>& blackhole_zones) {
+    const void* arrays[] = { walls.data(), spawns.data(), buff_zones.data(), blackhole_zones.data() };
+    const size_t counts[] = { walls.size(), spawns.size(), buff_zones.size(), blackhole_zones.size() };
+    const size_t sizes[] = { sizeof(ArenaRect), sizeof(ArenaSpawn), sizeof(ArenaRect), sizeof(ArenaRect) };
+
+    ArenaHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ARENA_MAGIC, sizeof(ARENA_MAGIC));
+    header.version = Arena::VERSION;
+
+    size_t offset = align4(sizeof(ArenaHeader));
+    for (size_t s = 0; s < (size_t)ArenaSection::NUM; ++s) {
+        header.sections[s].count = (uint32_t)counts[s];
+        header.sections[s].offset = (uint32_t)offset;
+        offset = align4(offset + counts[s] * sizes[s]);
+    }
+
+    std::vector<uint8_t> image(offset, 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    for (size_t s = 0; s < (size_t)ArenaSection::NUM; ++s) {
+        if (counts[s]) std::memcpy(image.data() + header.sections[s].offset, arrays[s], counts[s] * sizes[s]);
+    }
+    return image;
+}
+
+Arena* Arena::load(const std::string& path) {
+    return ends_with(path, ".arenac") ? load_cooked(path) : load_text(path);
+}
+
+Arena* Arena::load_text(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Arena: cannot open " << path << "\n";
+        return nullptr;
+    }
+
+    std::vector<ArenaRect> walls, buff_zones, blackhole_zones;
+    std::vector<ArenaSpawn> spawns;
+    std::string line;
+    int line_no = 0;
+    while (std::getline(in, line)) {
+        ++line_no;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream ss(line);
+        std::string keyword;
+        if (!(ss >> keyword)) continue; // blank / comment-only line
+
+        bool ok = false;
+        if (keyword == "wall" || keyword == "buff_zone" || keyword == "blackhole_zone") {
+            float cx, cy, w, h;
+            ok = (bool)(ss >> cx >> cy >> w >> h) && w > 0.0f && h > 0.0f;
+            if (ok) {
+                ArenaRect r = { cx, cy, w / 2.0f, h / 2.0f };
+                if (keyword == "wall") walls.push_back(r);
+                else if (keyword == "buff_zone") buff_zones.push_back(r);
+                else blackhole_zones.push_back(r);
+            }
+        } else if (keyword == "spawn") {
+            ArenaSpawn sp;
+            ok = (bool)(ss >> sp.team >> sp.slot >> sp.x >> sp.y) && sp.team >= 0 && sp.slot >= 0;
+            if (ok) spawns.push_back(sp);
+        } else {
+            std::cerr << path << ":" << line_no << ": unknown record '" << keyword << "'\n";
+            return nullptr;
+        }
+        std::string extra;
+        if (ok && (ss >> extra)) ok = false; // trailing garbage
+        if (!ok) {
+            std::cerr << path << ":" << line_no << ": malformed '" << keyword << "' record\n";
+            return nullptr;
+        }
+    }
+
+    Arena* arena = new Arena();
+    arena->_image = cook(walls, spawns, buff_zones, blackhole_zones);
+    arena->attach(arena->_image.data(), arena->_image.size(), path);
+    return arena;
+}
+
+Arena* Arena::load_cooked(const std::string& path) {
+    Arena* arena = new Arena();
+    if (!arena->_file.open(path)) {
+        std::cerr << "Arena: cannot map " << path << "\n";
+        delete arena;
+        return nullptr;
+    }
+    if (!arena->attach(arena->_file.data(), arena->_file.size(), path)) {
+        delete arena;
+        return nullptr;
+    }
+    return arena;
+}
+
+// Points the section views at `data` after checking the header; no copying
+bool Arena::attach(const uint8_t* data, size_t size, const std::string& path) {
+    if (size < sizeof(ArenaHeader)) {
+        std::cerr << "Arena: " << path << " is truncated\n";
+        return false;
+    }
+    const ArenaHeader* header = reinterpret_cast<const ArenaHeader*>(data);
+    if (std::memcmp(header->magic, ARENA_MAGIC, sizeof(ARENA_MAGIC)) != 0 || header->version != VERSION) {
+        std::cerr << "Arena: " << path << " is not a version " << VERSION << " cooked arena\n";
+        return false;
+    }
+    for (size_t s = 0; s < (size_t)ArenaSection::NUM; ++s) {
+        // every record type is 16 bytes
+        uint64_t end = (uint64_t)header->sections[s].offset + (uint64_t)header->sections[s].count * sizeof(ArenaRect);
+        if (header->sections[s].offset % 4 != 0 || end > size) {
+            std::cerr << "Arena: " << path << " has a corrupt section table\n";
+            return false;
+        }
+    }
+    _data = data;
+    _size = size;
+    _header = header;
+    return true;
+}
+
+bool Arena::write_cooked(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        std::cerr << "Arena: cannot write " << path << "\n";
+        return false;
+    }
+    bool ok = std::fwrite(_data, 1, _size, f) == _size;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok) std::cerr << "Arena: failed writing " << path << "\n";
+    return ok;
+}
+
+bool Arena::find_spawn(int team, int slot, Vector2& out) const {
+    for (const ArenaSpawn& sp : get_spawns()) {
+        if (sp.team == team && sp.slot == slot) {
+            out = Vector2(sp.x, sp.y);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Arena::sample_zone(ArenaSpan<ArenaRect> zones, SimRng& rng, Vector2& out) {
+    if (zones.empty()) return false;
+
+    float total = 0.0f;
+    for (const ArenaRect& z : zones) total += z.half_w * z.half_h;
+    std::uniform_real_distribution<float> pick(0.0f, total);
+    float at = pick(rng);
+
+    const ArenaRect* zone = &zones[zones.size() - 1];
+    for (const ArenaRect& z : zones) {
+        at -= z.half_w * z.half_h;
+        if (at <= 0.0f) { zone = &z; break; }
+    }
+    std::uniform_real_distribution<float> dx(-zone->half_w, zone->half_w);
+    std::uniform_real_distribution<float> dy(-zone->half_h, zone->half_h);
+    // two statements: argument evaluation order would make the point compiler-dependent
+    float x = zone->x + dx(rng);
+    float y = zone->y + dy(rng);
+    out = Vector2(x, y);
+    return true;
+}
@@ -0,0 +1,73 @@
+#include "inc/EntityRegistry.h"
+#include "components/inc/IUpdatable.h"
+
+EntityRegistry::~EntityRegistry() {
+    for (const Slot& s : _slots) {
+        if (s.object && s.owned) delete s.updatable;
+    }
+}
+
+EntityHandle EntityRegistry::add(IUpdatable* updatable, void* object, EntityKind kind, bool owned) {
+    uint32_t index;
+    if (!_free_slots.empty()) {
+        index = _free_slots.back();
+        _free_slots.pop_back();
+    } else {
+        index = (uint32_t)_slots.size();
+        _slots.emplace_back();
+    }
+    KindList& list = _by_kind[(int)kind];
+    Slot& s = _slots[index];
+    s.updatable = updatable;
+    s.object = object;
+    s.dense = (uint32_t)_updatables.size();
+    s.kind_dense = (uint32_t)list.objects.size();
+    s.kind = kind;
+    s.owned = owned;
+    s.pending = false;
+    _updatables.push_back(updatable);
+    _updatable_slots.push_back(index);
+    list.objects.push_back(object);
+    list.slots.push_back(index);
+    return { index, s.generation };
+}
+
+bool EntityRegistry::despawn(EntityHandle handle) {
+    if (!is_alive(handle)) return false;
+    _slots[handle.index].pending = true;
+    _pending.push_back(handle.index);
+    return true;
+}
+
+void EntityRegistry::flush() {
+    for (uint32_t slot : _pending) remove(slot);
+    _pending.clear();
+}
+
+void EntityRegistry::remove(uint32_t index) {
+    Slot& s = _slots[index];
+
+    // swap-and-pop out of the updatable list, then fix the moved entity's position
+    uint32_t last = _updatable_slots.back();
+    _updatables[s.dense] = _updatables.back();
+    _updatable_slots[s.dense] = last;
+    _slots[last].dense = s.dense;
+    _updatables.pop_back();
+    _updatable_slots.pop_back();
+
+    // same for its kind list
+    KindList& list = _by_kind[(int)s.kind];
+    uint32_t last_kind = list.slots.back();
+    list.objects[s.kind_dense] = list.objects.back();
+    list.slots[s.kind_dense] = last_kind;
+    _slots[last_kind].kind_dense = s.kind_dense;
+    list.objects.pop_back();
+    list.slots.pop_back();
+
+    if (s.owned) delete s.updatable;
+    s.updatable = nullptr;
+    s.object = nullptr;
+    s.pending = false;
+    ++s.generation; // old handles stop resolving
+    _free_slots.push_back(index);
+}
@@ -0,0 +1,611 @@
+#include "inc/Match.h"
+#include "inc/Arena.h"
+#include "components/inc/BasicAI.h"
+#include "components/inc/BlackHole.h"
+#include "components/inc/BuffItem.h"
+#include "components/inc/Character.h"
+#include "components/inc/Explosion.h"
+#include "components/inc/InputHandler.h"
+#include "components/inc/OBB.h"
+#include "components/inc/Wall.h"
+#include "Constant.h"
+#include "debug/inc/Profiler.h"
+#include "io/inc/ByteStream.h"
+#include "jobs/inc/JobSystem.h"
+#include <algorithm>
+#include <iostream>
+#include <variant>
+
+// Rule timings (match clock, ms)
+static const double BUFF_INTERVAL_MS = 10000.0;      // spawn a buff every 10s
+static const double GUN_CHANGE_MS = 30000.0;         // rotate guns every 30s
+static const double BLACKHOLE_PRECAUTION_MS = 5000.0; // 5 seconds before first spawn
+static const double BLACKHOLE_INTERVAL_MS = 30000.0;  // spawn every 30 seconds
+static const double BLACKHOLE_LIFE_MS = 15000.0;      // blackhole exists for 15 seconds
+
+static const int RANDOM_WALL_COUNT = 7;
+
+// items per job for the parallel phases; smaller counts stay on the calling thread
+static const size_t AI_GRAIN = 8;
+static const size_t EXPLOSION_GRAIN = 16;
+
+// bump when save_state() changes layout; old snapshots are refused, not misread
+static const uint32_t MATCH_STATE_VERSION = 1;
+
+static BlackHole* new_blackhole(Vector2 p) {
+    return new BlackHole(p, nullptr, 65.0f, 30.0f, 5.0f, 15.0f);
+}
+
+static BuffItem* new_buff(Vector2 p, std::variant<CharBuffType, BulletBuffType> type) {
+    const float half = BuffItem::DEFAULT_HALF_SIZE;
+    return new BuffItem(p, Vector2(half, half), nullptr, type);
+}
+
+Match::Match(const MatchConfig& config)
+    : _config(config), _rng(config.seed),
+      _explosions(MAX_EXPLOSIONS, PoolPolicy::DROP_OLDEST, config.fx_renderer, EXPLOSION_TEXTURE_PATH, Vector2(), 50, 50, 9, 40, 3) {
+    // Create four characters (two per team). Sprites/animations are attached by presentation.
+    Vector2 spawns[NUM_TEAMS * 2] = {
+        Vector2(100.0f, WORLD_H / 2.0f - 50.0f),
+        Vector2(100.0f, WORLD_H / 2.0f + 50.0f),
+        Vector2(WORLD_W - 100.0f, WORLD_H / 2.0f - 50.0f),
+        Vector2(WORLD_W - 100.0f, WORLD_H / 2.0f + 50.0f),
+    };
+    for (int i = 0; i < NUM_TEAMS * 2; ++i) {
+        // slots the arena leaves out keep the default spot
+        if (_config.arena) _config.arena->find_spawn(i / 2, i % 2, spawns[i]);
+        _roster.push_back(new Character(spawns[i], nullptr, 200.0f, 100.0f));
+    }
+    _characters = _roster;
+    for (auto* c : _roster) _prev_health.push_back(c->get_health());
+
+    // Teams: roster [0,1] = input set 0 (red), [2,3] = input set 1 (blue)
+    for (int team = 0; team < NUM_TEAMS; ++team) {
+        Character* first = _roster[team * 2];
+        Character* second = _roster[team * 2 + 1];
+        first->set_input_set(team);
+        second->set_input_set(team);
+        // Mark active players for rendering indicator
+        first->set_activate(true);
+
+        if (_config.ai_team[team]) {
+            _ais.push_back(new BasicAI(first, nullptr, &_bullets, _rng()));
+            _ais.push_back(new BasicAI(second, nullptr, &_bullets, _rng()));
+        } else {
+            _inputs[team] = new InputHandler(team == 0 ? InputSet::INPUT_1 : InputSet::INPUT_2, first, second);
+        }
+    }
+
+    build_walls();
+    for (auto* w : _walls) _wall_bvh.add(w);
+    _wall_bvh.build();
+}
+
+Match::~Match() {
+    for (auto* ai : _ais) delete ai;
+    for (auto* ih : _inputs) delete ih;
+    for (auto* c : _roster) delete c;
+    for (auto* w : _walls) delete w;
+    for (auto* bi : _buffs) delete bi;
+    for (auto& bhp : _blackholes) delete bhp.first;
+}
+
+void Match::build_walls() {
+    const float t = WALL_THICKNESS;
+    // Boundary strips: top/bottom horizontal, left/right vertical
+    _walls.push_back(new Wall(Vector2(WORLD_W / 2.0f, t / 2.0f), Vector2(WORLD_W / 2.0f, t / 2.0f)));
+    _walls.push_back(new Wall(Vector2(WORLD_W / 2.0f, WORLD_H - t / 2.0f), Vector2(WORLD_W / 2.0f, t / 2.0f)));
+    _walls.push_back(new Wall(Vector2(t / 2.0f, WORLD_H / 2.0f), Vector2(t / 2.0f, WORLD_H / 2.0f)));
+    _walls.push_back(new Wall(Vector2(WORLD_W - t / 2.0f, WORLD_H / 2.0f), Vector2(t / 2.0f, WORLD_H / 2.0f)));
+
+    if (_config.arena) {
+        for (const ArenaRect& r : _config.arena->get_walls()) {
+            _walls.push_back(new Wall(Vector2(r.x, r.y), Vector2(r.half_w, r.half_h)));
+        }
+        return;
+    }
+
+    // Random internal walls
+    std::uniform_real_distribution<float> wallX(150.0f, WORLD_W - 150.0f);
+    std::uniform_real_distribution<float> wallY(150.0f, WORLD_H - 150.0f);
+    std::uniform_int_distribution<int> wallW(64, 240);
+    std::uniform_int_distribution<int> wallH(16, 96);
+    for (int i = 0; i < RANDOM_WALL_COUNT; ++i) {
+        int w = wallW(_rng);
+        int h = wallH(_rng);
+        bool placed = false;
+        int attempts = 0;
+        Vector2 chosenPos;
+        // Try to find a position that doesn't intersect boundary walls or existing random walls
+        while (!placed && attempts < 30) {
+            Vector2 pos(wallX(_rng), wallY(_rng));
+            OBB tmp_box(pos, Vector2(w / 2.0f, h / 2.0f), 0.0f);
+            bool intersects = false;
+            for (auto* existing : _walls) {
+                for (auto* hb : existing->get_hitboxes()) {
+                    if (hb->is_collide(tmp_box)) { intersects = true; break; }
+                }
+                if (intersects) break;
+            }
+            // avoid spawning walls too close to player spawn positions
+            if (!intersects) {
+                const float min_player_clearance = 150.0f; // pixels
+                for (auto* pc : _roster) {
+                    float dx = pc->get_position().x - pos.x;
+                    float dy = pc->get_position().y - pos.y;
+                    if (dx*dx + dy*dy < min_player_clearance * min_player_clearance) { intersects = true; break; }
+                }
+            }
+            if (!intersects) {
+                placed = true;
+                chosenPos = pos;
+            } else attempts++;
+        }
+        // couldn't find a free spot after attempts; skip creating this wall
+        if (!placed) continue;
+
+        _walls.push_back(new Wall(chosenPos, Vector2(w / 2.0f, h / 2.0f)));
+    }
+}
+
+void Match::handle_event(SDL_Event& event) {
+    for (auto* ih : _inputs) {
+        if (ih) ih->handle_event(event);
+    }
+}
+
+uint8_t Match::get_input_state(int team) const {
+    return _inputs[team] ? _inputs[team]->get_state() : 0;
+}
+
+void Match::set_input_state(int team, uint8_t state) {
+    if (_inputs[team]) _inputs[team]->set_state(state);
+}
+
+// FNV-1a over the raw bits of the state that decides the outcome
+uint64_t Match::get_checksum() const {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+    };
+    mix(&_time_ms, sizeof(_time_ms));
+    for (const Character* c : _roster) {
+        Vector2 pos = c->get_position();
+        float health = c->get_health();
+        mix(&pos, sizeof(pos));
+        mix(&health, sizeof(health));
+    }
+    uint32_t counts[] = { (uint32_t)_bullets.size(), (uint32_t)_explosions.size(), (uint32_t)_buffs.size(), (uint32_t)_blackholes.size() };
+    mix(counts, sizeof(counts));
+    for (size_t i = 0; i < _bullets.size(); ++i) {
+        Vector2 pos = _bullets.get_position(i);
+        mix(&pos, sizeof(pos));
+    }
+    return h;
+}
+
+void Match::save_state(std::vector<uint8_t>& out) const {
+    out.clear();
+    ByteWriter w(out);
+    w.put(MATCH_STATE_VERSION);
+    w.put(_time_ms);
+    w.put(_over);
+    w.put(_winning_team);
+    w.put(_last_buff_spawn_ms);
+    w.put(_last_gun_change_ms);
+    w.put(_last_bh_spawn_ms);
+    w.put(_rng.get_seed());
+    w.put(_rng.get_draws());
+
+    auto roster_index = [this](const IInputObject* c) -> int32_t {
+        for (size_t r = 0; r < _roster.size(); ++r) if (_roster[r] == c) return (int32_t)r;
+        return -1;
+    };
+    w.put((uint32_t)_roster.size());
+    for (size_t r = 0; r < _roster.size(); ++r) {
+        _roster[r]->save_state(w);
+        bool alive = std::find(_characters.begin(), _characters.end(), _roster[r]) != _characters.end();
+        w.put(alive);
+        w.put(_prev_health[r]);
+    }
+    for (const InputHandler* ih : _inputs) {
+        if (!ih) continue;
+        w.put(ih->get_state());
+        w.put(roster_index(ih->get_activated()));
+        w.put(roster_index(ih->get_unactivated()));
+    }
+    for (const BasicAI* ai : _ais) ai->save_state(w);
+
+    _bullets.save_state(w);
+
+    w.put((uint32_t)_explosions.size());
+    for (const Explosion* ex : _explosions.get_active()) {
+        w.put(ex->get_position());
+        w.put(ex->get_damage());
+        w.put(ex->get_owner_team());
+        ex->save_state(w, _roster);
+    }
+    w.put((uint32_t)_buffs.size());
+    for (BuffItem* bi : _buffs) {
+        auto type = bi->get_buff_type();
+        w.put((uint8_t)type.index());
+        w.put(type.index() == 0 ? (int32_t)std::get<CharBuffType>(type) : (int32_t)std::get<BulletBuffType>(type));
+        w.put(bi->get_position());
+        bi->save_state(w);
+    }
+    w.put((uint32_t)_blackholes.size());
+    for (const auto& bhp : _blackholes) {
+        w.put(bhp.first->get_position());
+        w.put(bhp.second);
+    }
+}
+
+bool Match::load_state(const uint8_t* data, size_t size) {
+    ByteReader in(data, size);
+    if (in.get<uint32_t>() != MATCH_STATE_VERSION) {
+        std::cerr << "Match: snapshot version mismatch\n";
+        return false;
+    }
+    in.get(_time_ms);
+    in.get(_over);
+    in.get(_winning_team);
+    in.get(_last_buff_spawn_ms);
+    in.get(_last_gun_change_ms);
+    in.get(_last_bh_spawn_ms);
+    SimRng::result_type seed = in.get<SimRng::result_type>();
+    uint64_t draws = in.get<uint64_t>();
+    _rng.restore(seed, draws);
+
+    if (in.get<uint32_t>() != _roster.size()) {
+        std::cerr << "Match: snapshot is from a different roster\n";
+        return false;
+    }
+    _characters.clear();
+    for (size_t r = 0; r < _roster.size(); ++r) {
+        _roster[r]->load_state(in);
+        if (in.get<bool>()) _characters.push_back(_roster[r]);
+        in.get(_prev_health[r]);
+    }
+    auto roster_at = [this](int32_t r) -> Character* {
+        return r >= 0 && (size_t)r < _roster.size() ? _roster[r] : nullptr;
+    };
+    for (InputHandler* ih : _inputs) {
+        if (!ih) continue;
+        uint8_t state = in.get<uint8_t>();
+        Character* activated = roster_at(in.get<int32_t>());
+        Character* unactivated = roster_at(in.get<int32_t>());
+        ih->restore(state, activated, unactivated);
+    }
+    for (BasicAI* ai : _ais) ai->load_state(in);
+
+    _bullets.load_state(in);
+
+    _explosions.clear();
+    uint32_t count = in.get<uint32_t>();
+    for (uint32_t i = 0; i < count && in.ok(); ++i) {
+        Vector2 pos = in.get<Vector2>();
+        float damage = in.get<float>();
+        int owner = in.get<int>();
+        if (Explosion* ex = _explosions.spawn(pos, damage, owner)) ex->load_state(in, _roster);
+    }
+    for (auto* bi : _buffs) delete bi;
+    _buffs.clear();
+    count = in.get<uint32_t>();
+    for (uint32_t i = 0; i < count && in.ok(); ++i) {
+        uint8_t kind = in.get<uint8_t>();
+        int32_t value = in.get<int32_t>();
+        Vector2 pos = in.get<Vector2>();
+        std::variant<CharBuffType, BulletBuffType> type;
+        if (kind == 0) type = (CharBuffType)value;
+        else type = (BulletBuffType)value;
+        _buffs.push_back(new_buff(pos, type));
+        _buffs.back()->load_state(in);
+    }
+    for (auto& bhp : _blackholes) delete bhp.first;
+    _blackholes.clear();
+    count = in.get<uint32_t>();
+    for (uint32_t i = 0; i < count && in.ok(); ++i) {
+        Vector2 pos = in.get<Vector2>();
+        double spawned_ms = in.get<double>();
+        _blackholes.emplace_back(new_blackhole(pos), spawned_ms);
+    }
+    // events belong to the timeline we just left
+    _events.clear();
+
+    if (!in.ok() || !in.at_end()) {
+        std::cerr << "Match: snapshot is truncated or corrupt\n";
+        return false;
+    }
+    return true;
+}
+
+void Match::spawn_explosion(Vector2 position, float damage, int owner_team) {
+    _explosions.spawn(position, damage, owner_team);
+}
+
+void Match::poll_events(std::vector<MatchEvent>& out) {
+    out.insert(out.end(), _events.begin(), _events.end());
+    _events.clear();
+}
+
+void Match::step(float dt) {
+    if (_over) return;
+    _time_ms += dt * 1000.0;
+
+    update_entities(dt);
+    collide_explosions();
+    update_deaths();
+
+    {
+        // remove finished explosions
+        PROFILE_SCOPE("cleanup.explosions");
+        _explosions.release_finished();
+    }
+
+    update_blackholes();
+    collide_bullets();
+    collide_characters();
+    spawn_buffs();
+    consume_buffs();
+    rotate_guns();
+    check_winner();
+}
+
+void Match::retarget_ais() {
+    // each AI chases the closest living enemy
+    for (auto* ai : _ais) {
+        Character* self = ai->get_character();
+        Character* best = nullptr;
+        float best_d2 = 0.0f;
+        for (auto* c : _characters) {
+            if (c->get_input_set() == self->get_input_set()) continue;
+            Vector2 d = c->get_position() - self->get_position();
+            float d2 = d.length_squared();
+            if (!best || d2 < best_d2) { best = c; best_d2 = d2; }
+        }
+        ai->set_target(best);
+    }
+}
+
+void Match::update_entities(float dt) {
+    PROFILE_SCOPE("sim.update");
+    // swap / shoot presses latched since the last tick act before anything moves
+    for (auto* ih : _inputs) if (ih) ih->apply_actions(_bullets);
+    for (auto* c : _characters) c->update(dt);
+    for (auto* ih : _inputs) if (ih) ih->update(dt);
+    retarget_ais();
+    // AIs only read the world while deciding; their moves and shots land afterwards
+    // in _ais order, so bullets spawn in the same order as a serial update
+    parallel_for(_config.jobs, _ais.size(), AI_GRAIN, [this, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!_ais[i]->get_character()->is_dead()) _ais[i]->think(dt);
+        }
+    });
+    for (auto* ai : _ais) {
+        if (!ai->get_character()->is_dead()) ai->act();
+    }
+    for (auto* bi : _buffs) bi->update(dt);
+    for (auto& bhp : _blackholes) bhp.first->update(dt);
+    _bullets.update(dt, _config.jobs);
+    std::vector<Explosion*>& explosions = _explosions.get_active();
+    parallel_for(_config.jobs, explosions.size(), EXPLOSION_GRAIN, [&explosions, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) explosions[i]->update(dt);
+    });
+
+    // rebuild the dynamic broadphase now that everything has moved this step
+    _dynamic_grid.clear();
+    for (size_t i = 0; i < _bullets.size(); ++i) _dynamic_grid.insert(nullptr, _bullets.get_hitbox(i).get_bounds(), LAYER_BULLET, (uint32_t)i);
+    for (auto* c : _characters) _dynamic_grid.insert(c, LAYER_CHARACTER);
+}
+
+void Match::collide_explosions() {
+    PROFILE_SCOPE("collide.explosions");
+    // let nearby characters and bullets react to explosions
+    for (auto* ex : _explosions.get_active()) {
+        _dynamic_grid.query(SpatialHash::bounds_of(ex), LAYER_CHARACTER | LAYER_BULLET, _nearby);
+        for (uint32_t idx : _nearby) {
+            const SpatialHash::Entry& entry = _dynamic_grid.get_entry(idx);
+            if (entry.layer == LAYER_CHARACTER) entry.object->collide(ex);
+            else _bullets.collide(entry.id, ex);
+        }
+    }
+}
+
+void Match::update_deaths() {
+    PROFILE_SCOPE("sim.deaths");
+    // detect damage and deaths; dead characters leave the active list immediately
+    for (size_t r = 0; r < _roster.size(); ++r) {
+        Character* c = _roster[r];
+        if (std::find(_characters.begin(), _characters.end(), c) == _characters.end()) continue;
+        float old_h = _prev_health[r];
+        float new_h = c->get_health();
+        if (new_h < old_h && new_h > 0.0f) {
+            _events.push_back({ MatchEventType::HIT, c->get_position(), c });
+        }
+        if (old_h > 0.0f && new_h <= 0.0f) {
+            _events.push_back({ MatchEventType::DEATH, c->get_position(), c });
+            // let input handlers swap control or clear references
+            for (auto* ih : _inputs) if (ih) ih->on_character_death(c);
+            _characters.erase(std::remove(_characters.begin(), _characters.end(), c), _characters.end());
+        }
+        _prev_health[r] = new_h;
+    }
+}
+
+void Match::update_blackholes() {
+    PROFILE_SCOPE("spawn.blackholes");
+    std::uniform_real_distribution<float> distX(100.0f, WORLD_W - 100.0f);
+    std::uniform_real_distribution<float> distY(100.0f, WORLD_H - 100.0f);
+
+    // Start spawning only after precaution
+    if (_time_ms >= BLACKHOLE_PRECAUTION_MS) {
+        if (_last_bh_spawn_ms < 0.0 || _time_ms - _last_bh_spawn_ms >= BLACKHOLE_INTERVAL_MS) {
+            bool ok = false; int attempts = 0; Vector2 p;
+            while (!ok && attempts < 20) {
+                if (!_config.arena || !Arena::sample_zone(_config.arena->get_blackhole_zones(), _rng, p)) {
+                    p.x = distX(_rng);
+                    p.y = distY(_rng);
+                }
+                ok = true;
+                for (auto* c : _characters) {
+                    float dx = c->get_position().x - p.x;
+                    float dy = c->get_position().y - p.y;
+                    if (dx*dx + dy*dy < 200.0f * 200.0f) { ok = false; break; }
+                }
+                attempts++;
+            }
+            if (ok) {
+                _blackholes.emplace_back(new_blackhole(p), _time_ms);
+            }
+            _last_bh_spawn_ms = _time_ms;
+        }
+    }
+
+    // Remove expired blackholes
+    _blackholes.erase(std::remove_if(_blackholes.begin(), _blackholes.end(), [this](const std::pair<BlackHole*, double>& p) {
+        if (_time_ms - p.second >= BLACKHOLE_LIFE_MS) { delete p.first; return true; }
+        return false;
+    }), _blackholes.end());
+}
+
+void Match::collide_bullets() {
+    PROFILE_SCOPE("collide.bullets");
+    // bullets vs blackholes/walls/characters; walls are swept along the bullet's path
+    for (size_t i = 0; i < _bullets.size(); ++i) {
+        for (auto& bhp : _blackholes) _bullets.collide(i, bhp.first);
+        if (_bullets.is_destroyed(i)) continue;
+
+        // walls anywhere along this tick's path; the earliest hit wins
+        _wall_bvh.query(_bullets.get_swept_bounds(i), _nearby);
+        _wall_candidates.clear();
+        for (uint32_t idx : _nearby) _wall_candidates.push_back(_wall_bvh.get_item(idx).object);
+        _bullets.collide_walls(i, _wall_candidates);
+        if (_bullets.is_destroyed(i)) continue;
+
+        // bounds after the wall pass: a bounce may have moved the bullet
+        AABB bb = _bullets.get_hitbox(i).get_bounds();
+        _dynamic_grid.query(bb, LAYER_CHARACTER, _nearby);
+        for (uint32_t idx : _nearby) {
+            Character* c = static_cast<Character*>(_dynamic_grid.get_entry(idx).object);
+            if (c->is_dead()) continue; // died earlier this step
+            _bullets.collide(i, c);
+            if (_bullets.is_destroyed(i)) break;
+        }
+    }
+
+    // bullet vs bullet: bullets from different teams destroy each other
+    _dynamic_grid.query_pairs(LAYER_BULLET, LAYER_BULLET, _bullet_pairs, _config.jobs);
+    for (auto& pr : _bullet_pairs) {
+        _bullets.collide_bullets(_dynamic_grid.get_entry(pr.first).id, _dynamic_grid.get_entry(pr.second).id);
+    }
+
+    // remove destroyed bullets (EXPLODING ones leave an explosion)
+    _bullets.flush_destroyed(_explosions);
+}
+
+void Match::collide_characters() {
+    PROFILE_SCOPE("collide.characters");
+    for (auto& bhp : _blackholes) {
+        for (auto* c : _characters) bhp.first->collide(c);
+    }
+    // characters collide with boundary and internal walls so they cannot pass through
+    for (auto* c : _characters) {
+        _wall_bvh.query(SpatialHash::bounds_of(c), _nearby);
+        for (uint32_t idx : _nearby) _wall_bvh.get_item(idx).object->collide(c);
+    }
+}
+
+void Match::spawn_buffs() {
+    PROFILE_SCOPE("spawn.buffs");
+    if (_time_ms - _last_buff_spawn_ms < BUFF_INTERVAL_MS) return;
+    _last_buff_spawn_ms = _time_ms;
+
+    // Only spawn a bullet buff if no character currently has a bullet buff active
+    bool any_bullet_buff = false;
+    for (auto* c : _characters) {
+        if (c->get_gun_buff_type() != BulletBuffType::NONE) { any_bullet_buff = true; break; }
+    }
+
+    const int num_char_buffs = (int)CharBuffType::NUM;
+    const BulletBuffType bulletTypes[] = { BulletBuffType::BOUNCING, BulletBuffType::EXPLODING, BulletBuffType::PIERCING };
+    std::uniform_int_distribution<int> chooseType(0, 1);
+    std::uniform_int_distribution<int> chooseChar(0, num_char_buffs - 1);
+    std::uniform_int_distribution<int> chooseBullet(0, 2);
+
+    // char buff or bullet buff with equal probability; bullet buff falls back to a char buff if one is active
+    std::variant<CharBuffType, BulletBuffType> bt;
+    if (chooseType(_rng) == 0 || any_bullet_buff) {
+        bt = static_cast<CharBuffType>(chooseChar(_rng));
+    } else {
+        bt = bulletTypes[chooseBullet(_rng)];
+    }
+
+    // pick a spawn position that does not intersect any wall hitbox
+    std::uniform_real_distribution<float> posX(150.0f, WORLD_W - 150.0f);
+    std::uniform_real_distribution<float> posY(150.0f, WORLD_H - 150.0f);
+    for (int attempt = 0; attempt < 30; ++attempt) {
+        Vector2 pos;
+        if (!_config.arena || !Arena::sample_zone(_config.arena->get_buff_zones(), _rng, pos)) {
+            pos = Vector2(posX(_rng), posY(_rng));
+        }
+        OBB tmp_box(pos, Vector2(16.0f, 16.0f), 0.0f);
+        _wall_bvh.query_obb(tmp_box, _nearby);
+        if (_nearby.empty()) {
+            _buffs.push_back(new_buff(pos, bt));
+            return;
+        }
+    }
+}
+
+void Match::consume_buffs() {
+    PROFILE_SCOPE("cleanup.buffs");
+    for (auto* c : _characters) {
+        for (auto* bi : _buffs) c->collide(bi);
+    }
+
+    auto it = _buffs.begin();
+    while (it != _buffs.end()) {
+        BuffItem* bi = *it;
+        if (!bi->is_consumed()) { ++it; continue; }
+        // A bullet buff belongs to one character at a time: clear it from the others
+        auto btype = bi->get_buff_type();
+        if (std::holds_alternative<BulletBuffType>(btype)) {
+            BulletBuffType taken = std::get<BulletBuffType>(btype);
+            for (auto* c : _characters) {
+                if (c->get_gun_buff_type() != BulletBuffType::NONE && c->get_gun_buff_type() != taken) {
+                    c->clear_bullet_buff();
+                }
+            }
+        }
+        delete bi;
+        it = _buffs.erase(it);
+    }
+}
+
+void Match::rotate_guns() {
+    if (_time_ms - _last_gun_change_ms < GUN_CHANGE_MS) return;
+    _last_gun_change_ms = _time_ms;
+    // Pistol <-> AK
+    for (auto* c : _characters) {
+        c->set_gun_type(c->get_gun_type() == GunType::PISTOL ? GunType::AK : GunType::PISTOL);
+    }
+    _events.push_back({ MatchEventType::GUN_SWITCH, ZERO, nullptr });
+}
+
+void Match::check_winner() {
+    // team membership via each character's input set (team id)
+    bool red_alive = false, blue_alive = false;
+    for (auto* ch : _characters) {
+        if (ch->get_health() <= 0.0f) continue;
+        if (ch->get_input_set() == 0) red_alive = true;
+        else if (ch->get_input_set() == 1) blue_alive = true;
+    }
+    if (red_alive && blue_alive) return;
+
+    // team 1 = input_set 0 (red), team 2 = input_set 1 (blue)
+    if (red_alive) _winning_team = 1;
+    else if (blue_alive) _winning_team = 2;
+    else _winning_team = -1; // tie or all dead
+    _over = true;
+}
@@ -0,0 +1,248 @@
+#include "inc/Replay.h"
+#include "inc/Match.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+static const char REPLAY_MAGIC[4] = { 'G', 'P', 'R', 'P' };
+static const uint32_t REPLAY_VERSION = 2;
+static const size_t TRAILER_SIZE = 16;
+static const uint8_t RECORD_RUN = 0;
+static const uint8_t RECORD_SNAPSHOT = 1;
+
+static void put_u32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+static void put_u64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+// LEB128: 7 bits per byte, high bit = more bytes follow
+static void put_varint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t get_u64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static bool get_varint(const uint8_t* data, size_t end, size_t& cursor, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && cursor < end; shift += 7) {
+        uint8_t b = data[cursor++];
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+ReplayWriter::~ReplayWriter() {
+    // dropped without close(): leave whatever was written, it fails the trailer check on load
+    if (_file) std::fclose(_file);
+}
+
+bool ReplayWriter::open(const std::string& path, const ReplayInfo& info) {
+    if (_file) std::fclose(_file);
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file) {
+        std::cerr << "Replay: cannot write " << path << "\n";
+        return false;
+    }
+    _run_length = 0;
+    _ticks = 0;
+    _snapshot_interval = (uint64_t)info.tick_hz * SNAPSHOT_INTERVAL_SECONDS;
+    _next_snapshot_tick = 0;
+    _ok = true;
+
+    std::vector<uint8_t> header(REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+    put_u32(header, REPLAY_VERSION);
+    put_u32(header, info.seed);
+    put_u32(header, info.tick_hz);
+    header.push_back(info.ai_team[0] ? 1 : 0);
+    header.push_back(info.ai_team[1] ? 1 : 0);
+    uint16_t len = (uint16_t)std::min<size_t>(info.arena_path.size(), 0xFFFF);
+    header.push_back((uint8_t)len);
+    header.push_back((uint8_t)(len >> 8));
+    header.insert(header.end(), info.arena_path.begin(), info.arena_path.begin() + len);
+    _ok = std::fwrite(header.data(), 1, header.size(), _file) == header.size();
+    return _ok;
+}
+
+bool ReplayWriter::wants_snapshot() const {
+    return _file && _snapshot_interval > 0 && _ticks >= _next_snapshot_tick;
+}
+
+void ReplayWriter::write_snapshot(const std::vector<uint8_t>& state) {
+    if (!_file) return;
+    // the snapshot sits between two ticks, so the run in progress ends here
+    flush_run();
+    std::vector<uint8_t> record(1, RECORD_SNAPSHOT);
+    put_varint(record, _ticks);
+    put_varint(record, state.size());
+    record.insert(record.end(), state.begin(), state.end());
+    _ok = std::fwrite(record.data(), 1, record.size(), _file) == record.size() && _ok;
+    _next_snapshot_tick = _ticks + _snapshot_interval;
+}
+
+void ReplayWriter::record(const uint8_t states[NUM_TEAMS]) {
+    if (!_file) return;
+    if (_run_length > 0 && std::memcmp(states, _run_state, NUM_TEAMS) != 0) flush_run();
+    std::memcpy(_run_state, states, NUM_TEAMS);
+    ++_run_length;
+    ++_ticks;
+}
+
+void ReplayWriter::flush_run() {
+    if (_run_length == 0) return;
+    std::vector<uint8_t> run(1, RECORD_RUN);
+    run.insert(run.end(), _run_state, _run_state + NUM_TEAMS);
+    put_varint(run, _run_length);
+    _ok = std::fwrite(run.data(), 1, run.size(), _file) == run.size() && _ok;
+    _run_length = 0;
+}
+
+bool ReplayWriter::close(uint64_t checksum) {
+    if (!_file) return false;
+    flush_run();
+    std::vector<uint8_t> trailer;
+    put_u64(trailer, _ticks);
+    put_u64(trailer, checksum);
+    _ok = std::fwrite(trailer.data(), 1, trailer.size(), _file) == trailer.size() && _ok;
+    _ok = std::fclose(_file) == 0 && _ok;
+    _file = nullptr;
+    if (!_ok) std::cerr << "Replay: write failed\n";
+    return _ok;
+}
+
+bool ReplayReader::open(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Replay: cannot open " << path << "\n";
+        return false;
+    }
+    _data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    // magic + version + seed + tick_hz + ai_team[2] + path length
+    const size_t fixed = 4 + 4 + 4 + 4 + 2 + 2;
+    if (_data.size() < fixed + TRAILER_SIZE || std::memcmp(_data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0
+        || get_u32(&_data[4]) != REPLAY_VERSION) {
+        std::cerr << "Replay: " << path << " is not a version " << REPLAY_VERSION << " replay\n";
+        return false;
+    }
+    _info.seed = get_u32(&_data[8]);
+    _info.tick_hz = get_u32(&_data[12]);
+    _info.ai_team[0] = _data[16] != 0;
+    _info.ai_team[1] = _data[17] != 0;
+    size_t len = _data[18] | ((size_t)_data[19] << 8);
+    if (fixed + len + TRAILER_SIZE > _data.size()) {
+        std::cerr << "Replay: " << path << " is truncated\n";
+        return false;
+    }
+    _info.arena_path.assign((const char*)&_data[fixed], len);
+
+    _ticks_end = _data.size() - TRAILER_SIZE;
+    _tick_count = get_u64(&_data[_ticks_end]);
+    _checksum = get_u64(&_data[_ticks_end + 8]);
+    _cursor = fixed + len;
+    _run_left = 0;
+    _tick = 0;
+
+    // walk the records once: validates the stream and indexes the snapshots,
+    // so next() and seek() never have to bounds-check a length again
+    _snapshots.clear();
+    uint64_t ticks = 0;
+    size_t cursor = _cursor;
+    while (cursor < _ticks_end) {
+        uint8_t tag = _data[cursor++];
+        uint64_t a = 0, b = 0;
+        bool ok = false;
+        if (tag == RECORD_RUN) {
+            cursor += NUM_TEAMS;
+            ok = cursor <= _ticks_end && get_varint(_data.data(), _ticks_end, cursor, a) && a > 0;
+            ticks += a;
+        } else if (tag == RECORD_SNAPSHOT) {
+            ok = get_varint(_data.data(), _ticks_end, cursor, a) && get_varint(_data.data(), _ticks_end, cursor, b)
+                && a == ticks && b <= _ticks_end - cursor;
+            if (ok) {
+                _snapshots.push_back({ a, cursor, (size_t)b, cursor + (size_t)b });
+                cursor += (size_t)b;
+            }
+        }
+        if (!ok) {
+            std::cerr << "Replay: " << path << " is corrupt\n";
+            return false;
+        }
+    }
+    if (ticks != _tick_count) {
+        std::cerr << "Replay: " << path << " is truncated\n";
+        return false;
+    }
+    return true;
+}
+
+bool ReplayReader::next(uint8_t states[NUM_TEAMS]) {
+    if (_tick >= _tick_count) return false;
+    // open() validated the records, so only the tags need looking at here
+    while (_run_left == 0) {
+        if (_cursor >= _ticks_end) return false;
+        uint8_t tag = _data[_cursor++];
+        if (tag == RECORD_SNAPSHOT) {
+            uint64_t tick = 0, size = 0;
+            get_varint(_data.data(), _ticks_end, _cursor, tick);
+            get_varint(_data.data(), _ticks_end, _cursor, size);
+            _cursor += (size_t)size;
+            continue;
+        }
+        std::memcpy(_run_state, &_data[_cursor], NUM_TEAMS);
+        _cursor += NUM_TEAMS;
+        get_varint(_data.data(), _ticks_end, _cursor, _run_left);
+    }
+    std::memcpy(states, _run_state, NUM_TEAMS);
+    --_run_left;
+    ++_tick;
+    return true;
+}
+
+bool ReplayReader::seek(uint64_t tick, Match& match) {
+    tick = std::min(tick, _tick_count);
+    // last snapshot at or before `tick`
+    auto it = std::upper_bound(_snapshots.begin(), _snapshots.end(), tick,
+                               [](uint64_t t, const Snapshot& s) { return t < s.tick; });
+    if (it == _snapshots.begin()) {
+        std::cerr << "Replay: no snapshot at or before tick " << tick << "\n";
+        return false;
+    }
+    const Snapshot& snap = *(it - 1);
+    // a short hop forward is cheaper to simulate than to restore
+    if (_tick > tick || _tick < snap.tick) {
+        if (!match.load_state(&_data[snap.offset], snap.size)) return false;
+        _cursor = snap.next_record;
+        _run_left = 0;
+        _tick = snap.tick;
+    }
+
+    const float dt = (float)(1.0 / _info.tick_hz);
+    uint8_t states[NUM_TEAMS];
+    while (_tick < tick && next(states)) {
+        for (int t = 0; t < NUM_TEAMS; ++t) match.set_input_state(t, states[t]);
+        match.step(dt);
+    }
+    std::vector<MatchEvent> dropped;
+    match.poll_events(dropped);
+    return _tick == tick;
+}
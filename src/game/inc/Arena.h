@@ -0,0 +1,108 @@
+#pragma once
+
+#include "io/inc/MappedFile.h"
+#include "math/SimRng.h"
+#include "math/Vector2.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Hand-made arena layout for a WORLD_W x WORLD_H stage. The boundary walls are
+// always there (Match / PVE build them); an arena adds the interior walls,
+// the spawn point of each character slot and the zones buffs and black holes
+// spawn in.
+//
+// Two forms:
+//   *.arena   text source, one record per line ('#' starts a comment):
+//               wall           <cx> <cy> <w> <h>
+//               spawn          <team> <slot> <x> <y>
+//               buff_zone      <cx> <cy> <w> <h>
+//               blackhole_zone <cx> <cy> <w> <h>
+//   *.arenac  cooked binary (tools/arena_cook, `make cook-arenas`): a header
+//             followed by the record arrays exactly as they sit in memory, so
+//             loading is one mmap and a few bounds checks, no parsing.
+// Cooked files are native-endian (little-endian on every platform we ship).
+
+// Axis-aligned rectangle, center + half extents (walls and zones)
+struct ArenaRect {
+    float x, y;
+    float half_w, half_h;
+};
+
+struct ArenaSpawn {
+    float x, y;
+    int32_t team; // 0 = red, 1 = blue
+    int32_t slot; // 0 = first character of the team
+};
+
+enum class ArenaSection : uint32_t {
+    WALLS = 0,
+    SPAWNS,
+    BUFF_ZONES,
+    BLACKHOLE_ZONES,
+    NUM,
+};
+
+struct ArenaHeader {
+    char magic[4]; // "GPAR"
+    uint32_t version;
+    struct {
+        uint32_t count;
+        uint32_t offset; // bytes from the start of the file, 4-aligned
+    } sections[(size_t)ArenaSection::NUM];
+};
+
+// Read-only view over one record array of the cooked image
+template <typename T>
+struct ArenaSpan {
+    const T* data = nullptr;
+    uint32_t count = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + count; }
+    const T& operator[](size_t i) const { return data[i]; }
+    uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+class Arena {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // Picks the loader from the extension (.arenac = cooked, anything else = text).
+    // nullptr on error (reason printed to stderr).
+    static Arena* load(const std::string& path);
+    static Arena* load_text(const std::string& path);
+    static Arena* load_cooked(const std::string& path);
+
+    bool write_cooked(const std::string& path) const;
+
+    ArenaSpan<ArenaRect> get_walls() const { return section<ArenaRect>(ArenaSection::WALLS); }
+    ArenaSpan<ArenaSpawn> get_spawns() const { return section<ArenaSpawn>(ArenaSection::SPAWNS); }
+    ArenaSpan<ArenaRect> get_buff_zones() const { return section<ArenaRect>(ArenaSection::BUFF_ZONES); }
+    ArenaSpan<ArenaRect> get_blackhole_zones() const { return section<ArenaRect>(ArenaSection::BLACKHOLE_ZONES); }
+
+    // Spawn point of (team, slot); false if the arena does not define it
+    bool find_spawn(int team, int slot, Vector2& out) const;
+    // Uniform point over the union of `zones` (zones weighted by area); false if there are none
+    static bool sample_zone(ArenaSpan<ArenaRect> zones, SimRng& rng, Vector2& out);
+
+private:
+    Arena() = default;
+    bool attach(const uint8_t* data, size_t size, const std::string& path);
+
+    template <typename T>
+    ArenaSpan<T> section(ArenaSection s) const {
+        const auto& sec = _header->sections[(size_t)s];
+        return { reinterpret_cast<const T*>(_data + sec.offset), sec.count };
+    }
+
+    // exactly one of these backs _data: a mapped cooked file, or the image cooked from text
+    MappedFile _file;
+    std::vector<uint8_t> _image;
+
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+    const ArenaHeader* _header = nullptr;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class IUpdatable;
+
+// What an entity is, so systems can walk just their own kind (characters for
+// HUD/deaths, buffs for pickup) instead of filtering the mixed updatable list
+enum class EntityKind : uint8_t {
+    CHARACTER,
+    BUFF,
+    WALL,
+    CONTROLLER, // InputHandler, BasicAI
+    NUM,
+};
+
+// Stable reference to a registry entity. The slot index is reused once the
+// entity is gone, the generation is not: a handle kept past despawn simply
+// stops resolving instead of pointing at whatever took the slot.
+struct EntityHandle {
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// Read-only typed list of one kind: iterates like std::vector<T*>
+template <typename T>
+class EntityView {
+public:
+    class iterator {
+    public:
+        explicit iterator(void* const* p) : _p(p) {}
+        T* operator*() const { return static_cast<T*>(*_p); }
+        iterator& operator++() { ++_p; return *this; }
+        bool operator!=(const iterator& other) const { return _p != other._p; }
+        bool operator==(const iterator& other) const { return _p == other._p; }
+    private:
+        void* const* _p;
+    };
+
+    explicit EntityView(const std::vector<void*>& items) : _items(&items) {}
+    size_t size() const { return _items->size(); }
+    bool empty() const { return _items->empty(); }
+    T* operator[](size_t i) const { return static_cast<T*>((*_items)[i]); }
+    iterator begin() const { return iterator(_items->data()); }
+    iterator end() const { return iterator(_items->data() + _items->size()); }
+
+private:
+    const std::vector<void*>* _items; // the registry's list, so the view follows spawns
+};
+
+// Entities of a stage (PVE): one dense list of every IUpdatable plus one dense
+// list per EntityKind, both kept packed by swap-and-pop. Each entity remembers
+// where it sits in both, so removing one is O(1) instead of an erase-remove
+// scan over everything.
+//
+// despawn() only marks the entity; it stays in every list (and keeps its
+// handle valid) until flush(), which the stage calls once at the end of each
+// tick after all systems ran. So nothing disappears from under a loop that is
+// still walking a list, and despawning twice in one tick is harmless.
+// Swap-and-pop means list order is not stable across a flush.
+class EntityRegistry {
+public:
+    EntityRegistry() = default;
+    ~EntityRegistry(); // deletes the owned entities still registered
+    EntityRegistry(const EntityRegistry&) = delete;
+    EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+    // Registers `object`; with `owned` the registry deletes it when it is flushed out
+    template <typename T>
+    EntityHandle spawn(T* object, EntityKind kind, bool owned = false) {
+        return add(static_cast<IUpdatable*>(object), static_cast<void*>(object), kind, owned);
+    }
+    // Queues the entity for removal at the next flush(). false for a stale
+    // handle or an entity already queued.
+    bool despawn(EntityHandle handle);
+    void flush();
+
+    // Handle still resolves (despawned entities do until the flush)
+    bool is_valid(EntityHandle handle) const {
+        return handle.index < _slots.size() && _slots[handle.index].generation == handle.generation && _slots[handle.index].object;
+    }
+    bool is_alive(EntityHandle handle) const { return is_valid(handle) && !_slots[handle.index].pending; }
+    // nullptr for a stale handle; T must be the type it was spawned as
+    template <typename T>
+    T* get(EntityHandle handle) const { return is_valid(handle) ? static_cast<T*>(_slots[handle.index].object) : nullptr; }
+
+    const std::vector<IUpdatable*>& get_updatables() const { return _updatables; }
+    template <typename T>
+    EntityView<T> view(EntityKind kind) const { return EntityView<T>(_by_kind[(int)kind].objects); }
+    // Handle of view(kind)[i]
+    EntityHandle handle_at(EntityKind kind, size_t i) const {
+        uint32_t slot = _by_kind[(int)kind].slots[i];
+        return { slot, _slots[slot].generation };
+    }
+
+    size_t size() const { return _updatables.size(); }
+    // Upper bound of handle.index, for side arrays indexed by slot
+    size_t get_slot_count() const { return _slots.size(); }
+
+private:
+    struct Slot {
+        IUpdatable* updatable = nullptr;
+        void* object = nullptr; // same entity as spawned (T*); nullptr = free slot
+        uint32_t generation = 0;
+        uint32_t dense = 0;      // position in _updatables
+        uint32_t kind_dense = 0; // position in _by_kind[kind]
+        EntityKind kind = EntityKind::CHARACTER;
+        bool owned = false;
+        bool pending = false; // despawned, waiting for flush()
+    };
+
+    struct KindList {
+        std::vector<void*> objects;
+        std::vector<uint32_t> slots; // parallel to objects
+    };
+
+    EntityHandle add(IUpdatable* updatable, void* object, EntityKind kind, bool owned);
+    void remove(uint32_t slot);
+
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _free_slots;
+    std::vector<IUpdatable*> _updatables;
+    std::vector<uint32_t> _updatable_slots; // parallel to _updatables
+    KindList _by_kind[(int)EntityKind::NUM];
+    std::vector<uint32_t> _pending;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Constant.h"
+
+// Fixed-tick simulation clock. The game loop feeds it the real frame time,
+// runs the simulation `advance()` times with step_dt(), then renders with
+// alpha() to interpolate between the previous and the current tick.
+// Physics always sees the same dt no matter how fast the display runs.
+class FixedTimestep {
+public:
+    static constexpr int DEFAULT_MAX_STEPS = 8;
+
+    explicit FixedTimestep(int hz = SIM_TICK_HZ, int max_steps = DEFAULT_MAX_STEPS)
+        : _step(1.0 / hz), _max_steps(max_steps) {}
+
+    // Adds `frame_seconds` of real time, returns how many ticks to simulate now.
+    // After a long stall (window drag, breakpoint) at most _max_steps ticks run
+    // and the rest is dropped, so the game slows down instead of spiralling.
+    int advance(double frame_seconds) {
+        if (frame_seconds < 0.0) frame_seconds = 0.0;
+        _accumulator += frame_seconds;
+        int steps = (int)(_accumulator / _step);
+        if (steps > _max_steps) {
+            steps = _max_steps;
+            _accumulator = 0.0;
+        } else {
+            _accumulator -= steps * _step;
+        }
+        return steps;
+    }
+
+    float step_dt() const { return (float)_step; }
+    // 0..1: how far the current frame is between the last two ticks
+    float alpha() const { return (float)(_accumulator / _step); }
+
+private:
+    double _step;
+    int _max_steps;
+    double _accumulator = 0.0;
+};
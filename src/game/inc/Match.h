@@ -0,0 +1,156 @@
+#pragma once
+
+#include "components/inc/BulletSystem.h"
+#include "math/SimRng.h"
+#include "math/Vector2.h"
+#include "memory/inc/ObjectPool.h"
+#include "physics/inc/SpatialHash.h"
+#include "physics/inc/StaticBVH.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+class Character;
+class Wall;
+class Explosion;
+class BuffItem;
+class BlackHole;
+class BasicAI;
+class InputHandler;
+class Arena;
+class ICollidable;
+class JobSystem;
+struct SDL_Renderer;
+union SDL_Event;
+
+struct MatchConfig {
+    uint32_t seed = 0;
+    // true: team driven by BasicAI, false: by keyboard (InputHandler INPUT_1 / INPUT_2)
+    bool ai_team[2] = { false, false };
+    // Only handed to Explosion so it can build its animation. nullptr = headless.
+    SDL_Renderer* fx_renderer = nullptr;
+    // Hand-made layout (walls, spawns, buff/black hole zones); nullptr = random walls.
+    // Not owned, must outlive the match.
+    const Arena* arena = nullptr;
+    // Runs the independent phases (bullet integration, AI decisions, explosion
+    // ticking, bullet pair search) across threads; collisions stay serial.
+    // Not owned; nullptr = everything on the calling thread. Same result either way.
+    JobSystem* jobs = nullptr;
+};
+
+// Things presentation cares about that happened during step(): blood on hit,
+// smoke on death, banner on gun switch. The simulation itself never renders.
+enum class MatchEventType {
+    HIT,
+    DEATH,
+    GUN_SWITCH,
+};
+
+struct MatchEvent {
+    MatchEventType type;
+    Vector2 position;
+    Character* character; // nullptr for GUN_SWITCH
+};
+
+// PVP match simulation (2v2): characters, walls, bullets, explosions, buffs and
+// black holes, plus the rules that spawn/expire them. Everything is driven by
+// step(dt) and the match clock, never by SDL_GetTicks, and nothing here needs
+// the video subsystem, so a match can run headless as fast as the CPU allows.
+class Match {
+public:
+    static constexpr int NUM_TEAMS = 2;
+    static constexpr int NUM_BOUNDARY_WALLS = 4; // first entries of get_walls()
+    static constexpr float WALL_THICKNESS = 32.0f;
+    // Live explosions at once; past that the oldest one is recycled (it is a
+    // rule of the simulation, so it is fixed rather than configurable)
+    static constexpr size_t MAX_EXPLOSIONS = 128;
+
+    explicit Match(const MatchConfig& config);
+    ~Match();
+    Match(const Match&) = delete;
+    Match& operator=(const Match&) = delete;
+
+    // Keyboard input for human-controlled teams (movement, swap, shoot).
+    // Only latched here; it reaches the world at the next step().
+    void handle_event(SDL_Event& event);
+    // Per-tick InputHandler state of a keyboard team (InputBit mask, 0 for AI teams).
+    // A replay records get_input_state() before each step and feeds it back with set_input_state().
+    uint8_t get_input_state(int team) const;
+    void set_input_state(int team, uint8_t state);
+    // Hash of the outcome-relevant state (clock, characters, bullets, entity counts):
+    // two runs that diverge anywhere end up with different checksums.
+    uint64_t get_checksum() const;
+    void step(float dt);
+
+    // Snapshot of the whole simulation: characters, input/AI state, bullets,
+    // explosions, buffs, black holes, the RNG and the rule timers. Walls are not
+    // included: they come from the config, so load_state() only accepts a snapshot
+    // taken from a match built with the same MatchConfig (seed + arena).
+    // Stepping after load_state() continues bit-exactly like the original match.
+    // A false return leaves the match half-restored; rebuild it before stepping.
+    void save_state(std::vector<uint8_t>& out) const;
+    bool load_state(const uint8_t* data, size_t size);
+
+    void spawn_explosion(Vector2 position, float damage = 25.0f, int owner_team = -1);
+    // Moves the events recorded since the last call into `out`.
+    void poll_events(std::vector<MatchEvent>& out);
+
+    bool is_over() const { return _over; }
+    int get_winning_team() const { return _winning_team; } // 1 = red, 2 = blue, -1 = draw
+    double get_time_ms() const { return _time_ms; }
+
+    const std::vector<Character*>& get_roster() const { return _roster; }         // spawn order, dead included
+    const std::vector<Character*>& get_characters() const { return _characters; } // alive only
+    const std::vector<Wall*>& get_walls() const { return _walls; }
+    BulletSystem& get_bullets() { return _bullets; }
+    const std::vector<Explosion*>& get_explosions() const { return _explosions.get_active(); }
+    const std::vector<BuffItem*>& get_buffs() const { return _buffs; }
+    const std::vector<std::pair<BlackHole*, double>>& get_blackholes() const { return _blackholes; }
+
+private:
+    void build_walls();
+    void update_entities(float dt);
+    void collide_explosions();
+    void update_deaths();
+    void update_blackholes();
+    void collide_bullets();
+    void collide_characters();
+    void spawn_buffs();
+    void consume_buffs();
+    void rotate_guns();
+    void check_winner();
+    void retarget_ais();
+
+    MatchConfig _config;
+    SimRng _rng;
+    double _time_ms = 0.0;
+    bool _over = false;
+    int _winning_team = -1;
+
+    std::vector<Character*> _roster;
+    std::vector<Character*> _characters;
+    std::vector<float> _prev_health; // indexed like _roster
+    InputHandler* _inputs[NUM_TEAMS] = { nullptr, nullptr };
+    std::vector<BasicAI*> _ais;
+
+    std::vector<Wall*> _walls;
+    BulletSystem _bullets;
+    ObjectPool<Explosion> _explosions;
+    std::vector<BuffItem*> _buffs;
+    std::vector<std::pair<BlackHole*, double>> _blackholes; // (blackhole, spawn time ms)
+    std::vector<MatchEvent> _events;
+
+    // Broadphase: walls never move, so the BVH is built once per match;
+    // bullets and characters are re-binned into the grid every step
+    StaticBVH _wall_bvh;
+    SpatialHash _dynamic_grid;
+    std::vector<uint32_t> _nearby;
+    std::vector<ICollidable*> _wall_candidates;
+    std::vector<std::pair<uint32_t, uint32_t>> _bullet_pairs;
+
+    double _last_buff_spawn_ms = 0.0;
+    double _last_gun_change_ms = 0.0;
+    double _last_bh_spawn_ms = -1.0; // < 0: not spawned yet
+};
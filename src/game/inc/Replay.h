@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Replay stream of one PVP match: everything Match needs to re-run it
+// bit-exactly on the fixed timestep, i.e. the config (seed, AI teams, arena)
+// plus the InputHandler state of every team for every tick, with a
+// Match::save_state() snapshot every few seconds so playback can jump
+// anywhere without simulating from tick 0.
+//
+// File layout (little-endian):
+//   header   "GPRP", version, seed, tick rate, ai_team[2], arena path (u16 length + bytes)
+//   records  tag byte, then
+//              RUN       NUM_TEAMS state bytes + varint run length (identical ticks)
+//              SNAPSHOT  varint tick, varint size, Match state after that many ticks
+//   trailer  u64 tick count, u64 Match::get_checksum() after the last tick
+// Input barely changes between ticks, so a minute of play is a few hundred bytes
+// of runs plus ~1 KB per snapshot.
+
+class Match;
+
+struct ReplayInfo {
+    uint32_t seed = 0;
+    uint32_t tick_hz = 0;
+    bool ai_team[2] = { false, false };
+    std::string arena_path; // empty = random walls
+};
+
+class ReplayWriter {
+public:
+    static constexpr int NUM_TEAMS = 2;
+    static constexpr uint32_t SNAPSHOT_INTERVAL_SECONDS = 5;
+
+    ReplayWriter() = default;
+    ~ReplayWriter();
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    bool open(const std::string& path, const ReplayInfo& info);
+    // True every SNAPSHOT_INTERVAL_SECONDS of ticks (tick 0 included) until
+    // write_snapshot() is called for that tick
+    bool wants_snapshot() const;
+    // Match::save_state() taken before the next record()
+    void write_snapshot(const std::vector<uint8_t>& state);
+    // One call per simulated tick, before Match::step()
+    void record(const uint8_t states[NUM_TEAMS]);
+    // Flushes the last run and writes the trailer. Returns false on any write error.
+    bool close(uint64_t checksum);
+
+    bool is_open() const { return _file != nullptr; }
+    uint64_t get_tick_count() const { return _ticks; }
+
+private:
+    void flush_run();
+
+    std::FILE* _file = nullptr;
+    uint8_t _run_state[NUM_TEAMS] = {};
+    uint64_t _run_length = 0;
+    uint64_t _ticks = 0;
+    uint64_t _snapshot_interval = 0; // ticks, 0 = no snapshots
+    uint64_t _next_snapshot_tick = 0;
+    bool _ok = true;
+};
+
+class ReplayReader {
+public:
+    static constexpr int NUM_TEAMS = ReplayWriter::NUM_TEAMS;
+
+    // Reads the whole file; false if it is missing, truncated or not a replay
+    bool open(const std::string& path);
+
+    const ReplayInfo& get_info() const { return _info; }
+    uint64_t get_tick_count() const { return _tick_count; }
+    uint64_t get_checksum() const { return _checksum; }
+    uint64_t get_tick() const { return _tick; } // ticks handed out so far
+
+    // States for the next tick; false once every recorded tick has been played
+    bool next(uint8_t states[NUM_TEAMS]);
+
+    // Puts `match` (built from get_info()) at `tick`: restores the last snapshot
+    // at or before it, then steps forward feeding the recorded input. next()
+    // continues from there. Events raised on the way are dropped.
+    bool seek(uint64_t tick, Match& match);
+    size_t get_snapshot_count() const { return _snapshots.size(); }
+
+private:
+    struct Snapshot {
+        uint64_t tick;
+        size_t offset;      // state bytes in _data
+        size_t size;
+        size_t next_record; // first record after the snapshot
+    };
+    std::vector<uint8_t> _data;
+    std::vector<Snapshot> _snapshots; // in tick order
+    ReplayInfo _info;
+    uint64_t _tick_count = 0;
+    uint64_t _checksum = 0;
+
+    size_t _cursor = 0;    // next run in _data
+    size_t _ticks_end = 0; // start of the trailer
+    uint8_t _run_state[NUM_TEAMS] = {};
+    uint64_t _run_left = 0;
+    uint64_t _tick = 0;
+};
@@ -0,0 +1,103 @@
+#include "inc/MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+#ifdef _WIN32
+        std::swap(_file, other._file);
+        std::swap(_mapping, other._mapping);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    _file = file;
+    _mapping = mapping;
+    _data = static_cast<const uint8_t*>(view);
+    _size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::close() {
+    if (_data) UnmapViewOfFile(_data);
+    if (_mapping) CloseHandle((HANDLE)_mapping);
+    if (_file) CloseHandle((HANDLE)_file);
+    _data = nullptr;
+    _size = 0;
+    _mapping = nullptr;
+    _file = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    _data = static_cast<const uint8_t*>(view);
+    _size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (_data) munmap(const_cast<uint8_t*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+}
+
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Raw byte (de)serialization for in-process state such as Match snapshots.
+// Values are copied bit for bit (native-endian, little-endian on every platform
+// we ship), so a float comes back exactly as it went in; that is what keeps a
+// restored simulation bit-identical to the one that was saved.
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteWriter::put needs a trivially copyable type");
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+        _out.insert(_out.end(), p, p + sizeof(T));
+    }
+
+    size_t size() const { return _out.size(); }
+
+private:
+    std::vector<uint8_t>& _out;
+};
+
+// Reads what ByteWriter wrote. Running past the end sets a sticky error instead
+// of reading garbage; check ok() once after reading everything.
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "ByteReader::get needs a trivially copyable type");
+        if (!_ok || _size - _cursor < sizeof(T)) {
+            _ok = false;
+            return false;
+        }
+        std::memcpy(&value, _data + _cursor, sizeof(T));
+        _cursor += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    T get() {
+        T value{};
+        get(value);
+        return value;
+    }
+
+    bool ok() const { return _ok; }
+    bool at_end() const { return _cursor == _size; }
+
+private:
+    const uint8_t* _data;
+    size_t _size;
+    size_t _cursor = 0;
+    bool _ok = true;
+};
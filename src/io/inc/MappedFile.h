@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap on POSIX, MapViewOfFile on
+// Windows). The bytes stay valid until close() or destruction; the OS pages
+// them in on first touch, so "loading" a cooked file costs almost nothing.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // false if the file cannot be opened or is empty
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return _data != nullptr; }
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+#ifdef _WIN32
+    void* _file = nullptr;    // HANDLE
+    void* _mapping = nullptr; // HANDLE
+#endif
+};
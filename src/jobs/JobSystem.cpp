@@ -0,0 +1,113 @@
+#include "inc/JobSystem.h"
+
+// Which queue the current thread owns. Threads that are not workers of this
+// system (the main thread) share queue 0.
+static thread_local const JobSystem* t_system = nullptr;
+static thread_local unsigned t_queue = 0;
+
+unsigned JobSystem::default_worker_count() {
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned worker_threads) {
+    for (unsigned i = 0; i <= worker_threads; ++i) _queues.push_back(new Queue());
+    for (unsigned i = 1; i <= worker_threads; ++i) _workers.emplace_back(&JobSystem::worker_main, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+        _quit = true;
+    }
+    _wake.notify_all();
+    for (auto& t : _workers) t.join();
+    for (auto* q : _queues) delete q;
+}
+
+unsigned JobSystem::current_queue() const {
+    return t_system == this ? t_queue : 0;
+}
+
+void JobSystem::run(Counter& counter, JobFn fn, void* context, size_t begin, size_t end) {
+    Job job = { fn, context, begin, end, &counter };
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    if (!push(current_queue(), job)) {
+        execute(job); // queue full: do it now rather than allocate
+        return;
+    }
+    _queued.fetch_add(1, std::memory_order_release);
+    {
+        // a worker between its empty check and wait() holds this lock, so the notify is not lost
+        std::lock_guard<std::mutex> lock(_sleep_mutex);
+    }
+    _wake.notify_one();
+}
+
+void JobSystem::wait(Counter& counter) {
+    const unsigned self = current_queue();
+    while (counter.pending.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (find_job(self, job)) execute(job);
+        else std::this_thread::yield(); // the last chunks are running on other threads
+    }
+}
+
+bool JobSystem::push(unsigned queue, const Job& job) {
+    Queue& q = *_queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.count == QUEUE_CAPACITY) return false;
+    q.jobs[(q.head + q.count) % QUEUE_CAPACITY] = job;
+    ++q.count;
+    return true;
+}
+
+bool JobSystem::pop(unsigned queue, Job& job) {
+    Queue& q = *_queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.count == 0) return false;
+    --q.count;
+    job = q.jobs[(q.head + q.count) % QUEUE_CAPACITY];
+    return true;
+}
+
+bool JobSystem::steal(unsigned thief, Job& job) {
+    const unsigned n = (unsigned)_queues.size();
+    for (unsigned k = 1; k < n; ++k) {
+        Queue& q = *_queues[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.count == 0) continue;
+        job = q.jobs[q.head];
+        q.head = (q.head + 1) % QUEUE_CAPACITY;
+        --q.count;
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::find_job(unsigned self, Job& job) {
+    if (_queued.load(std::memory_order_acquire) == 0) return false;
+    if (!pop(self, job) && !steal(self, job)) return false;
+    _queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void JobSystem::execute(const Job& job) {
+    job.fn(job.context, job.begin, job.end);
+    job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::worker_main(unsigned index) {
+    t_system = this;
+    t_queue = index;
+    while (true) {
+        Job job;
+        if (find_job(index, job)) {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        _wake.wait(lock, [this] { return _quit || _queued.load(std::memory_order_acquire) > 0; });
+        if (_quit) return;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Small work-stealing job system for the embarrassingly parallel parts of a
+// tick (bullet integration, animation ticking, AI decisions, broadphase pairs).
+//
+// Every thread owns a job queue. A thread pushes and pops at the back of its
+// own queue (newest first, data still in cache); a thread with nothing to do
+// steals from the front of another one. The thread waiting on a Counter keeps
+// running jobs instead of sleeping, so the main thread is one more worker
+// while it waits and a JobSystem with 0 worker threads simply runs everything
+// inline.
+//
+// Jobs are a function pointer + context + [begin, end) range, stored in fixed
+// ring buffers: submitting work never allocates. A full queue runs the job on
+// the spot.
+class JobSystem {
+public:
+    using JobFn = void (*)(void* context, size_t begin, size_t end);
+
+    // Jobs still pending; wait() returns once it drops to zero
+    struct Counter {
+        std::atomic<int> pending{ 0 };
+    };
+
+    static constexpr size_t QUEUE_CAPACITY = 256;
+
+    // hardware threads minus the main thread, which works while it waits
+    static unsigned default_worker_count();
+
+    explicit JobSystem(unsigned worker_threads = default_worker_count());
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned get_worker_count() const { return (unsigned)_workers.size(); }
+
+    void run(Counter& counter, JobFn fn, void* context, size_t begin, size_t end);
+    // Helps with any queued job until `counter` is done
+    void wait(Counter& counter);
+
+    // fn(begin, end) over [0, count) in chunks of `grain` items, spread over every
+    // thread; returns when all chunks are done. Chunks run in any order on any
+    // thread, so fn may only write to its own items. count <= grain runs inline
+    // with no synchronisation at all, so small phases cost nothing extra.
+    template <typename Fn>
+    void parallel_for(size_t count, size_t grain, Fn&& fn) {
+        if (grain == 0) grain = 1;
+        if (count <= grain || _workers.empty()) {
+            if (count > 0) fn((size_t)0, count);
+            return;
+        }
+        using F = typename std::remove_reference<Fn>::type;
+        JobFn call = [](void* context, size_t begin, size_t end) { (*static_cast<F*>(context))(begin, end); };
+        Counter counter;
+        for (size_t begin = grain; begin < count; begin += grain) {
+            run(counter, call, const_cast<void*>(static_cast<const void*>(&fn)), begin, std::min(count, begin + grain));
+        }
+        fn((size_t)0, grain); // first chunk on this thread
+        wait(counter);
+    }
+
+private:
+    struct Job {
+        JobFn fn;
+        void* context;
+        size_t begin;
+        size_t end;
+        Counter* counter;
+    };
+
+    // Ring buffer; back = owner side, front = thieves' side
+    struct Queue {
+        std::mutex mutex;
+        Job jobs[QUEUE_CAPACITY];
+        size_t head = 0; // front
+        size_t count = 0;
+    };
+
+    bool push(unsigned queue, const Job& job);
+    bool pop(unsigned queue, Job& job);
+    bool steal(unsigned thief, Job& job);
+    bool find_job(unsigned self, Job& job);
+    static void execute(const Job& job);
+    void worker_main(unsigned index);
+    unsigned current_queue() const;
+
+    std::vector<Queue*> _queues; // [0] = any thread that is not a worker (main)
+    std::vector<std::thread> _workers;
+    std::atomic<int> _queued{ 0 };
+    std::atomic<bool> _quit{ false };
+    std::mutex _sleep_mutex;
+    std::condition_variable _wake;
+};
+
+// Same as JobSystem::parallel_for, inline when there is no job system
+template <typename Fn>
+void parallel_for(JobSystem* jobs, size_t count, size_t grain, Fn&& fn) {
+    if (jobs) jobs->parallel_for(count, grain, fn);
+    else if (count > 0) fn((size_t)0, count);
+}
@@ -5,6 +5,7 @@
 #include <SDL_video.h>
 #include <SDL_image.h>
 #include "ResourceManager.h"
+#include "AnimationClipCache.h"
 #include <SDL_ttf.h>
 #include <cstdlib>
 #include <iostream>
@@ -19,18 +20,256 @@
 #include "components/inc/BasicAI.h"
 #include "components/inc/OBB.h"
 #include "components/inc/InputHandler.h"
-#include "components/inc/BloodSplash.h"
-#include "components/inc/Smoke.h"
 #include <unordered_map>
 #include "components/inc/Wall.h"
 #include "components/inc/Explosion.h"
-#include "components/inc/Bullet.h"
+#include "components/inc/BulletSystem.h"
 #include "components/inc/BlackHole.h"
 #include "components/inc/BuffItem.h"
+#include "physics/inc/SpatialHash.h"
+#include "physics/inc/StaticBVH.h"
+#include "game/inc/Arena.h"
+#include "game/inc/Replay.h"
+#include "game/inc/Match.h"
+#include "game/inc/FixedTimestep.h"
+#include "game/inc/EntityRegistry.h"
+#include "ui/inc/TextRenderer.h"
+#include "components/inc/SpriteBatch.h"
+#include "debug/inc/Profiler.h"
+#include "debug/inc/AllocCounter.h"
+#include "memory/inc/FrameArena.h"
+#include "memory/inc/ObjectPool.h"
+#include "fx/inc/ParticleSystem.h"
+#include "assets/inc/AssetLoader.h"
+#include "assets/inc/AssetPack.h"
+#include "assets/inc/ImageCache.h"
+#include "jobs/inc/JobSystem.h"
+#include "ui/inc/ProfilerOverlay.h"
 #include <random>
 #include <unordered_map>
+#include <chrono>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <variant>
+
+// PVE explosions come from a pool built when the stage starts; what a full pool does is --effect-pool oldest|skip
+static const size_t PVE_EXPLOSION_POOL_SIZE = 64;
+
+// Explosions each own their AnimatedSprite, so ticking them can be split across threads
+template <typename T>
+static void update_effects(JobSystem& jobs, ObjectPool<T>& pool, float dt) {
+    std::vector<T*>& effects = pool.get_active();
+    parallel_for(&jobs, effects.size(), 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) effects[i]->update(dt);
+    });
+}
+
+// `shooter --headless --ticks N [--seed S] [--arena A] [--record R]`: AI vs AI PVP matches
+// back to back, no window/renderer and no SDL_Init. Each finished match starts the next
+// one with seed+1 until N ticks have been simulated, then prints the tally. BasicAI can get
+// stuck on walls, so a match that runs past the time cap counts as a timeout.
+// --record saves the first match as a replay.
+static int run_headless(long long ticks, uint32_t seed, const Arena* arena, const char* arena_path, const char* record_path, JobSystem* jobs) {
+    const float dt = 1.0f / SIM_TICK_HZ;
+    const long long max_match_ticks = 5 * 60 * SIM_TICK_HZ; // 5 simulated minutes
+    int matches = 0;
+    int timeouts = 0;
+    int wins[3] = { 0, 0, 0 }; // draw, team 1, team 2
+    long long step = 0;
+    uint64_t step_allocs = 0; // heap allocations made inside Match::step
+    auto t0 = std::chrono::steady_clock::now();
+
+    while (step < ticks) {
+        MatchConfig config;
+        config.seed = seed + (uint32_t)matches;
+        config.ai_team[0] = true;
+        config.ai_team[1] = true;
+        config.arena = arena;
+        config.jobs = jobs;
+        Match match(config);
+        ReplayWriter recorder;
+        if (record_path && matches == 0) {
+            ReplayInfo info;
+            info.seed = config.seed;
+            info.tick_hz = SIM_TICK_HZ;
+            info.ai_team[0] = info.ai_team[1] = true;
+            info.arena_path = arena_path ? arena_path : "";
+            recorder.open(record_path, info);
+        }
+        std::vector<MatchEvent> events;
+        std::vector<uint8_t> snapshot;
+        long long match_ticks = 0;
+        while (step < ticks && !match.is_over() && match_ticks < max_match_ticks) {
+            if (recorder.is_open()) {
+                if (recorder.wants_snapshot()) {
+                    match.save_state(snapshot);
+                    recorder.write_snapshot(snapshot);
+                }
+                // AI teams have no keyboard state; the stream still marks every tick
+                uint8_t states[ReplayWriter::NUM_TEAMS] = { match.get_input_state(0), match.get_input_state(1) };
+                recorder.record(states);
+            }
+            uint64_t allocs_before = AllocCounter::get_count();
+            match.step(dt);
+            step_allocs += AllocCounter::get_count() - allocs_before;
+            events.clear();
+            match.poll_events(events); // not rendered; drain so it does not grow
+            Profiler::instance().end_frame(); // one tick = one profiler frame
+            ++step;
+            ++match_ticks;
+        }
+        if (recorder.is_open()) recorder.close(match.get_checksum());
+        if (!match.is_over() && match_ticks < max_match_ticks) break; // ran out of ticks mid-match
+        ++matches;
+        if (!match.is_over()) { ++timeouts; continue; }
+        int winner = match.get_winning_team();
+        wins[winner == 1 || winner == 2 ? winner : 0]++;
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "headless: " << step << " ticks (" << step * dt << "s simulated) in " << secs << "s"
+              << ", " << (secs > 0.0 ? step / secs : 0.0) << " ticks/s\n"
+              << "matches: " << matches << "  team1: " << wins[1] << "  team2: " << wins[2] << "  draw: " << wins[0] << "  timeout: " << timeouts << "\n"
+              << "heap allocations in step(): " << step_allocs << " (" << (step > 0 ? (double)step_allocs / step : 0.0) << " per tick)\n";
+    return EXIT_SUCCESS;
+}
+
+// `shooter --headless --replay R [--replay R2 ...] [--seek T]`: plays recorded matches
+// back with no window as fast as the CPU allows, one summary line per file, for
+// bulk analysis. --seek jumps each replay to tick T through its snapshots first;
+// the end checksum has to match either way.
+static int run_headless_replays(const std::vector<const char*>& paths, long long seek_tick, JobSystem* jobs) {
+    const float dt = 1.0f / SIM_TICK_HZ;
+    int failures = 0;
+    for (const char* path : paths) {
+        ReplayReader replay;
+        if (!replay.open(path)) { ++failures; continue; }
+        const ReplayInfo& info = replay.get_info();
+        if (info.tick_hz != SIM_TICK_HZ) {
+            std::cerr << path << ": recorded at " << info.tick_hz << " Hz, this build ticks at " << SIM_TICK_HZ << " Hz\n";
+            ++failures;
+            continue;
+        }
+        Arena* arena = nullptr;
+        if (!info.arena_path.empty() && !(arena = Arena::load(info.arena_path))) { ++failures; continue; }
+
+        MatchConfig config;
+        config.seed = info.seed;
+        config.ai_team[0] = info.ai_team[0];
+        config.ai_team[1] = info.ai_team[1];
+        config.arena = arena;
+        config.jobs = jobs;
+        {
+            Match match(config);
+            auto t0 = std::chrono::steady_clock::now();
+            bool ok = seek_tick <= 0 || replay.seek((uint64_t)seek_tick, match);
+            uint64_t first_tick = replay.get_tick();
+            std::vector<MatchEvent> events;
+            uint8_t states[ReplayReader::NUM_TEAMS];
+            while (ok && replay.next(states)) {
+                for (int t = 0; t < ReplayReader::NUM_TEAMS; ++t) match.set_input_state(t, states[t]);
+                match.step(dt);
+                events.clear();
+                match.poll_events(events);
+                Profiler::instance().end_frame();
+            }
+            double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            uint64_t played = replay.get_tick() - first_tick;
+
+            bool finished = ok && replay.get_tick() == replay.get_tick_count();
+            bool same = finished && match.get_checksum() == replay.get_checksum();
+            if (!same) ++failures;
+            std::cout << path << ": " << replay.get_tick_count() << " ticks (" << replay.get_snapshot_count() << " snapshots)";
+            if (first_tick > 0) std::cout << ", from tick " << first_tick;
+            std::cout << ", " << played << " played in " << secs << "s (" << (secs > 0.0 ? played / secs : 0.0) << " ticks/s)"
+                      << ", winner " << match.get_winning_team()
+                      << ", " << (!finished ? "stopped early" : same ? "checksum OK" : "DIVERGED") << "\n";
+        }
+        delete arena;
+    }
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
 
 int main (int argc, char *argv[]) {
+    const auto launch_time = std::chrono::steady_clock::now();
+    // Headless simulation: parse before touching SDL so no video subsystem is needed
+    bool headless = false;
+    long long headless_ticks = 60 * SIM_TICK_HZ; // one simulated minute
+    uint32_t headless_seed = 1;
+    const char* trace_path = nullptr; // --trace out.json: Chrome trace of every profiled scope, written on exit
+    const char* arena_path = nullptr; // --arena file.arena|file.arenac: hand-made stage instead of random walls
+    const char* record_path = nullptr; // --record out.rpl: save the next PVP match (first headless match) as a replay
+    const char* replay_path = nullptr; // --replay in.rpl: play a recorded PVP match back, then quit
+    std::vector<const char*> replay_paths; // headless takes several --replay for bulk analysis
+    long long replay_seek_tick = 0; // --seek T: start the replay at tick T (snapshot + fast-forward)
+    unsigned job_threads = JobSystem::default_worker_count(); // --threads N: worker threads besides the main one, 0 = single-threaded
+    PoolPolicy effect_policy = PoolPolicy::DROP_OLDEST; // --effect-pool oldest|skip: full PVE explosion pool
+    size_t vram_budget_mb = ResourceManager::DEFAULT_BUDGET_BYTES >> 20; // --vram-budget MB: cached textures beyond this get evicted
+    const char* pack_path = nullptr; // --pack file.gpak: load assets from this pack (default: ASSET_PACK_PATH if it exists)
+    bool image_cache = true; // --no-image-cache: always decode loose images, write no IMAGE_CACHE_DIR entries
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) headless = true;
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) headless_ticks = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) headless_seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) trace_path = argv[++i];
+        else if (std::strcmp(argv[i], "--arena") == 0 && i + 1 < argc) arena_path = argv[++i];
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) record_path = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replay_paths.push_back(argv[++i]);
+        else if (std::strcmp(argv[i], "--seek") == 0 && i + 1 < argc) replay_seek_tick = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) job_threads = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--vram-budget") == 0 && i + 1 < argc) vram_budget_mb = (size_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--pack") == 0 && i + 1 < argc) pack_path = argv[++i];
+        else if (std::strcmp(argv[i], "--no-image-cache") == 0) image_cache = false;
+        else if (std::strcmp(argv[i], "--effect-pool") == 0 && i + 1 < argc) {
+            ++i;
+            if (std::strcmp(argv[i], "skip") == 0) effect_policy = PoolPolicy::SKIP;
+            else if (std::strcmp(argv[i], "oldest") == 0) effect_policy = PoolPolicy::DROP_OLDEST;
+            else std::cerr << "--effect-pool: expected oldest or skip, got " << argv[i] << "\n";
+        }
+    }
+    JobSystem jobs(job_threads);
+    if (!replay_paths.empty()) replay_path = replay_paths[0];
+    if (trace_path) {
+        Profiler::instance().set_trace_enabled(true);
+        Profiler::instance().set_enabled(true);
+    }
+    if (headless && replay_path) {
+        int rc = run_headless_replays(replay_paths, replay_seek_tick, &jobs);
+        if (trace_path) Profiler::instance().write_chrome_trace(trace_path);
+        return rc;
+    }
+    ReplayReader replay;
+    if (replay_path) {
+        if (!replay.open(replay_path)) return EXIT_FAILURE;
+        if (replay.get_info().tick_hz != SIM_TICK_HZ) {
+            std::cerr << "Replay: recorded at " << replay.get_info().tick_hz << " Hz, this build ticks at " << SIM_TICK_HZ << " Hz\n";
+            return EXIT_FAILURE;
+        }
+        // the recording decides the stage, not the command line
+        arena_path = replay.get_info().arena_path.empty() ? nullptr : replay.get_info().arena_path.c_str();
+    }
+    Arena* arena = nullptr;
+    if (arena_path) {
+        arena = Arena::load(arena_path);
+        if (!arena) return EXIT_FAILURE;
+    }
+    if (headless) {
+        int rc = run_headless(headless_ticks, headless_seed, arena, arena_path, record_path, &jobs);
+        if (trace_path) Profiler::instance().write_chrome_trace(trace_path);
+        delete arena;
+        return rc;
+    }
+
+    // Asset pack: one mmap instead of an open per image and font candidate; loose files otherwise
+    if (pack_path) {
+        if (!AssetPack::mount(pack_path)) return EXIT_FAILURE;
+    } else if (std::FILE* probe = std::fopen(ASSET_PACK_PATH, "rb")) {
+        std::fclose(probe);
+        AssetPack::mount(ASSET_PACK_PATH);
+    }
+    if (!image_cache) ImageCache::set_directory("");
+
     // SDL_Init
     if (SDL_Init(SDL_INIT_VIDEO)) {
         std::cerr << "SDL_Init failed" << SDL_GetError();
@@ -53,7 +292,7 @@ int main (int argc, char *argv[]) {
     }
 
     // Init Renderer
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (renderer == nullptr) {
         std::cerr << "Renderer Init failed" << SDL_GetError();
         SDL_DestroyWindow(window);
@@ -61,10 +300,12 @@ int main (int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    // Create resource manager
-    ResourceManager resourceManager(renderer);
-    // Load bullet texture only
-    if (!resourceManager.load_texture("bullet", "assets/pictures/bulletA.png")) {
+    // Create resource manager: one for the whole process, so a rematch finds its textures already uploaded
+    ResourceManager resourceManager(renderer, vram_budget_mb << 20);
+    // the menu's own textures (and the bullet sheet) stay referenced for as long as the menu exists
+    ResourceManager::Scope menu_scope(resourceManager);
+    // Load bullet texture only; an atlas sprite, the same one the stages use
+    if (!resourceManager.load_sprite("bullet", "assets/pictures/bulletA.png")) {
         std::cerr << "Failed to load bullet sprite!\n";
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
@@ -83,8 +324,8 @@ int main (int argc, char *argv[]) {
     if (!resourceManager.load_texture("title", "assets/pictures/title.png")) {
         resourceManager.load_texture("title", "assets/pictures/title.jpg");
     }
-    SDL_Texture* bg = resourceManager.get_texture("menu_bg");
-    SDL_Texture* title_tex = resourceManager.get_texture("title");
+    SDL_Texture* bg = resourceManager.get_texture("menu_bg").texture;
+    SDL_Texture* title_tex = resourceManager.get_texture("title").texture;
 
     const std::vector<std::string> options = { "PVP", "PVE", "Exit" };
     int selected = 0;
@@ -102,12 +343,24 @@ int main (int argc, char *argv[]) {
         "assets/fonts/arial.ttf",
         "assets/pictures/Roboto-Regular.ttf",
         "assets/pictures/arial.ttf",
+        "assets/fonts/Slabo27px-Regular.ttf", // the one we ship, so a pack always has a font
         "C:/Windows/Fonts/arial.ttf",
         "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
         "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
         "/usr/local/share/fonts/DejaVuSans.ttf"
     };
+    // packed candidates first: each probe is a table lookup, not a file open
+    if (const AssetPack* pack = AssetPack::mounted()) {
+        for (const auto& p : fontCandidates) {
+            SDL_RWops* rw = pack->open_rw(p);
+            if (rw && (font = TTF_OpenFontRW(rw, 1, 24))) {
+                std::cerr << "Loaded font: " << p << " (pack)\n";
+                break;
+            }
+        }
+    }
     for (const auto& p : fontCandidates) {
+        if (font) break;
         font = TTF_OpenFont(p.c_str(), 24);
         if (font) {
             std::cerr << "Loaded font: " << p << "\n";
@@ -120,6 +373,10 @@ int main (int argc, char *argv[]) {
         std::cerr << "Warning: Unable to load any font for menu text.\n";
         std::cerr << "Place a .ttf file in 'assets/fonts/' (e.g. Roboto-Regular.ttf) or ensure a system font (arial, DejaVuSans) is available.\n";
     }
+    // all menu/HUD text goes through the glyph atlas; nullptr when no font was found
+    TextRenderer* text = font ? new TextRenderer(renderer, font) : nullptr;
+    // P in game: per-scope frame timings
+    ProfilerOverlay profiler_overlay;
 
     auto run_placeholder_game = [&](const std::string& mode) {
         bool in_game = true;
@@ -157,36 +414,23 @@ int main (int argc, char *argv[]) {
         }
     };
 
-    // Forward-declare a real PVP runner that spawns 4 players and basic world bounds.
-    auto run_pvp_game = [&](void) {
-        // Initialize TTF if not already
-        // create small game world similar to tests/test_char.cpp
-        ResourceManager rm(renderer);
+    // PVP runner: the simulation lives in game/Match; this lambda feeds it keyboard input and draws it.
+    auto run_pvp_game = [&](ResourceManager& rm) {
 
-    // Load bullet texture (already loaded earlier but ensure available in RM)
-    rm.load_texture("bullet", "assets/pictures/bulletA.png");
-    // Load battlefield background for the world
+    // Battlefield background: full screen, drawn once, its own texture
     rm.load_texture("background", "assets/pictures/background.png");
-    // Load buff textures so spawned buff items can use proper sprites
-    rm.load_texture("health-buff", "assets/pictures/health-buff.png");
-    rm.load_texture("bounce-buff", "assets/pictures/bounce-buff.png");
-    rm.load_texture("explode-buff", "assets/pictures/explosion-buff.png");
-    rm.load_texture("piercing-buff", "assets/pictures/piercing-buff.png");
+    // Bullet sheet and buff icons go into the atlas so they batch with each other
+    rm.load_sprite("bullet", "assets/pictures/bulletA.png");
+    rm.load_sprite("health-buff", "assets/pictures/health-buff.png");
+    rm.load_sprite("bounce-buff", "assets/pictures/bounce-buff.png");
+    rm.load_sprite("explode-buff", "assets/pictures/explosion-buff.png");
+    rm.load_sprite("piercing-buff", "assets/pictures/piercing-buff.png");
     // Char speed buff texture
-    rm.load_texture("speed-buff", "assets/pictures/speed-buff.png");
+    rm.load_sprite("speed-buff", "assets/pictures/speed-buff.png");
 
-        // Create simple team textures (solid colored textures)
-        SDL_Surface* red_surface = SDL_CreateRGBSurface(0, 16, 16, 32,
-            0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
-        SDL_FillRect(red_surface, NULL, SDL_MapRGBA(red_surface->format, 255, 0, 0, 255));
-        SDL_Texture* red_texture = SDL_CreateTextureFromSurface(renderer, red_surface);
-        SDL_FreeSurface(red_surface);
-
-        SDL_Surface* blue_surface = SDL_CreateRGBSurface(0, 16, 16, 32,
-            0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
-        SDL_FillRect(blue_surface, NULL, SDL_MapRGBA(blue_surface->format, 0, 0, 255, 255));
-        SDL_Texture* blue_texture = SDL_CreateTextureFromSurface(renderer, blue_surface);
-        SDL_FreeSurface(blue_surface);
+        // Simple team sprites (solid colors, in the atlas too)
+        TextureRegion red_texture = rm.add_solid("team-red", 16, 16, { 255, 0, 0, 255 });
+        TextureRegion blue_texture = rm.add_solid("team-blue", 16, 16, { 0, 0, 255, 255 });
 
         // Animated sprites placeholders (nullptr accepted by Character constructor for sprite param)
         AnimatedSprite idle(renderer, "assets/pictures/PlayerIdle.png", 24, 16, 5, 100);
@@ -199,28 +443,51 @@ int main (int argc, char *argv[]) {
     // Black hole animation (match tests/test_char.cpp)
     AnimatedSprite blackhole_anim(renderer, "assets/pictures/output.png", 200, 200, 12, 100, 3);
 
-        // Create four characters (two per team)
-        Character p1(Vector2(100.0f, WORLD_H / 2.0f - 50.0f), red_texture, 200.0f, 100.0f);
-        Character p2(Vector2(100.0f, WORLD_H / 2.0f + 50.0f), red_texture, 200.0f, 100.0f);
-        Character p3(Vector2(WORLD_W - 100.0f, WORLD_H / 2.0f - 50.0f), blue_texture, 200.0f, 100.0f);
-        Character p4(Vector2(WORLD_W - 100.0f, WORLD_H / 2.0f + 50.0f), blue_texture, 200.0f, 100.0f);
+        // Both teams on the keyboard (INPUT_1 / INPUT_2); explosions get their animation from the renderer
+        MatchConfig config;
+        if (replay_path) {
+            config.seed = replay.get_info().seed;
+            config.ai_team[0] = replay.get_info().ai_team[0];
+            config.ai_team[1] = replay.get_info().ai_team[1];
+        } else {
+            std::random_device rd;
+            config.seed = rd();
+        }
+        config.fx_renderer = renderer;
+        config.arena = arena;
+        config.jobs = &jobs;
+        Match match(config);
+        if (replay_path && replay_seek_tick > 0 && !replay.seek((uint64_t)replay_seek_tick, match)) return;
+
+        // --record: seed + per-tick input of this match
+        ReplayWriter recorder;
+        std::vector<uint8_t> snapshot;
+        if (record_path && !replay_path) {
+            ReplayInfo info;
+            info.seed = config.seed;
+            info.tick_hz = SIM_TICK_HZ;
+            info.arena_path = arena_path ? arena_path : "";
+            recorder.open(record_path, info);
+        }
+
+        // Roster: two characters per team, red (input set 0) left, blue (input set 1) right
+        const std::vector<Character*>& roster = match.get_roster();
+        Character& p1 = *roster[0];
+        Character& p2 = *roster[1];
+        Character& p3 = *roster[2];
+        Character& p4 = *roster[3];
+        p1.set_sprite(red_texture);
+        p2.set_sprite(red_texture);
+        p3.set_sprite(blue_texture);
+        p4.set_sprite(blue_texture);
 
     p1.set_animations(&idle, &run, &shoot);
     p2.set_animations(&idle1, &run1, &shoot1);
     p3.set_animations(&idle, &run, &shoot);
     p4.set_animations(&idle1, &run1, &shoot1);
 
-    // Assign input sets / teams so bullets and collisions work correctly
-    p1.set_input_set(0);
-    p2.set_input_set(0);
-    p3.set_input_set(1);
-    p4.set_input_set(1);
-
-    // Mark active players for rendering indicator (player team left, AI team right)
-    p1.set_activate(true);
-    p3.set_activate(true);
-
-    std::vector<Character*> characters = { &p1, &p2, &p3, &p4 };
+    // living characters; dead ones drop out during Match::step
+    const std::vector<Character*>& characters = match.get_characters();
 
     // Fixed slot mapping for HUD stability: index 0=p1 (player1_1),1=p2 (player1_2),2=p3 (player2_1),3=p4 (player2_2)
     std::unordered_map<Character*, int> pvp_slot_index;
@@ -229,139 +496,42 @@ int main (int argc, char *argv[]) {
     pvp_slot_index[&p3] = 2;
     pvp_slot_index[&p4] = 3;
 
-        // Input handlers (assign two characters per input set)
-        InputHandler ih1(InputSet::INPUT_1, &p1, &p2);
-        InputHandler ih2(InputSet::INPUT_2, &p3, &p4);
-
-    // Walls: create four walls forming bounds. Make horizontal strips for top/bottom and vertical strips for left/right
-    const int wall_thickness = 32;
-    // Horizontal wall texture (width = WORLD_W, height = wall_thickness)
-    SDL_Surface* wall_surf_h = SDL_CreateRGBSurface(0, WORLD_W, wall_thickness, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-    SDL_FillRect(wall_surf_h, NULL, SDL_MapRGBA(wall_surf_h->format, 80, 80, 80, 255));
-    SDL_Texture* wall_tex_h = SDL_CreateTextureFromSurface(renderer, wall_surf_h);
-    SDL_FreeSurface(wall_surf_h);
-
-    // Vertical wall texture (width = wall_thickness, height = WORLD_H)
-    SDL_Surface* wall_surf_v = SDL_CreateRGBSurface(0, wall_thickness, WORLD_H, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-    SDL_FillRect(wall_surf_v, NULL, SDL_MapRGBA(wall_surf_v->format, 80, 80, 80, 255));
-    SDL_Texture* wall_tex_v = SDL_CreateTextureFromSurface(renderer, wall_surf_v);
-    SDL_FreeSurface(wall_surf_v);
-
-    // Create four Wall objects positioned to cover the edges
-    Wall topWall(Vector2(WORLD_W/2.0f, wall_thickness / 2.0f), wall_tex_h);
-    Wall bottomWall(Vector2(WORLD_W/2.0f, WORLD_H - wall_thickness / 2.0f), wall_tex_h);
-    Wall leftWall(Vector2(wall_thickness / 2.0f, WORLD_H/2.0f), wall_tex_v);
-    Wall rightWall(Vector2(WORLD_W - wall_thickness / 2.0f, WORLD_H/2.0f), wall_tex_v);
-
-        std::vector<IUpdatable*> updatables;
-        for (auto* c : characters) updatables.push_back(c);
-        updatables.push_back(&ih1);
-        updatables.push_back(&ih2);
-        updatables.push_back(&topWall);
-        updatables.push_back(&bottomWall);
-        updatables.push_back(&leftWall);
-        updatables.push_back(&rightWall);
-
-    std::vector<Bullet*> bullets;
-    std::vector<Explosion*> explosions;
-    std::vector<BloodSplash*> bloods;
-    std::vector<Smoke*> smokes;
-    // previous health tracking for death detection
-    std::unordered_map<Character*, float> prev_health;
-    for (auto c : characters) if (c) prev_health[c] = c->get_health();
-
-        // blackholes: pair<BlackHole*, spawn_time_ms>
-        std::vector<std::pair<BlackHole*, Uint32>> blackholes;
-
-    // Random internal walls: generate 7 walls per stage (PVP)
-    std::vector<Wall*> pvp_random_walls;
-        // RNG for random walls and other game elements
-        std::random_device rd;
-        std::mt19937 rng(rd());
-        std::uniform_real_distribution<float> wallX(150.0f, WORLD_W - 150.0f);
-        std::uniform_real_distribution<float> wallY(150.0f, WORLD_H - 150.0f);
-        std::uniform_int_distribution<int> wallW(64, 240);
-        std::uniform_int_distribution<int> wallH(16, 96);
-        for (int i = 0; i < 7; ++i) {
-            int w = wallW(rng);
-            int h = wallH(rng);
-            bool placed = false;
-            int attempts = 0;
-            Vector2 chosenPos;
-            // Try to find a position that doesn't intersect boundary walls or existing random walls
-            while (!placed && attempts < 30) {
-                Vector2 pos(wallX(rng), wallY(rng));
-                // create a temporary OBB for the candidate wall
-                OBB tmp_box(pos, Vector2(w / 2.0f, h / 2.0f), 0.0f);
-                bool intersects = false;
-                // check boundary walls
-                for (auto* hb : topWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                if (intersects) { attempts++; continue; }
-                for (auto* hb : bottomWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                if (intersects) { attempts++; continue; }
-                for (auto* hb : leftWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                if (intersects) { attempts++; continue; }
-                for (auto* hb : rightWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                if (intersects) { attempts++; continue; }
+    // Walls are one gray swatch each stretched over their hitbox; boundary strips are darker than internal walls
+    const TextureRegion boundary_wall_sprite = rm.add_solid("wall-boundary", 4, 4, { 80, 80, 80, 255 });
+    const TextureRegion wall_sprite = rm.add_solid("wall", 4, 4, { 100, 100, 100, 255 });
+    for (size_t i = 0; i < match.get_walls().size(); ++i) {
+        match.get_walls()[i]->set_sprite(i < (size_t)Match::NUM_BOUNDARY_WALLS ? boundary_wall_sprite : wall_sprite);
+    }
 
-                // check existing random walls
-                for (auto* existing : pvp_random_walls) if (existing) {
-                    for (auto* hb : existing->get_hitboxes()) {
-                        if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    }
-                    if (intersects) break;
-                }
-                // avoid spawning walls too close to player spawn positions
-                if (!intersects) {
-                    const float min_player_clearance = 150.0f; // pixels
-                    for (auto* pc : characters) if (pc) {
-                        float dx = pc->get_position().x - pos.x;
-                        float dy = pc->get_position().y - pos.y;
-                        if (dx*dx + dy*dy < min_player_clearance * min_player_clearance) { intersects = true; break; }
-                    }
-                }
-                if (!intersects) {
-                    placed = true;
-                    chosenPos = pos;
-                } else attempts++;
+    // Buff sprites are picked by type when a buff first shows up
+    auto buff_texture = [&](const std::variant<CharBuffType, BulletBuffType>& bt) {
+        TextureRegion chosen_tex;
+        if (std::holds_alternative<CharBuffType>(bt)) {
+            switch (std::get<CharBuffType>(bt)) {
+                case CharBuffType::HEALTH: chosen_tex = rm.get_texture("health-buff"); break;
+                case CharBuffType::SPEED: chosen_tex = rm.get_texture("speed-buff"); break;
+                default: chosen_tex = rm.get_texture("health-buff"); break;
             }
-
-            if (!placed) {
-                // couldn't find a free spot after attempts; skip creating this wall
-                continue;
+        } else {
+            switch (std::get<BulletBuffType>(bt)) {
+                case BulletBuffType::BOUNCING: chosen_tex = rm.get_texture("bounce-buff"); break;
+                case BulletBuffType::EXPLODING: chosen_tex = rm.get_texture("explode-buff"); break;
+                case BulletBuffType::PIERCING: chosen_tex = rm.get_texture("piercing-buff"); break;
+                default: break;
             }
-
-            // Create surface/texture only after a valid position is chosen
-            SDL_Surface* surf = SDL_CreateRGBSurface(0, w, h, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-            SDL_FillRect(surf, NULL, SDL_MapRGBA(surf->format, 100, 100, 100, 255));
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            SDL_FreeSurface(surf);
-            Wall* rw = new Wall(chosenPos, tex);
-            pvp_random_walls.push_back(rw);
-            updatables.push_back(rw);
         }
+        // fallback: an orange square if the resource is missing
+        if (!chosen_tex) chosen_tex = rm.add_solid("buff-fallback", 32, 32, { 200, 100, 0, 255 });
+        return chosen_tex;
+    };
 
-        // Buff items and timers
-        std::vector<BuffItem*> buffs;
-        const Uint32 buff_interval_ms = 10000; // spawn every 10s
-        Uint32 last_buff_spawn = SDL_GetTicks();
-
-    // Gun-change timer: rotate guns every 30s
-    const Uint32 gun_change_ms = 30000; // 30 seconds
-    Uint32 last_gun_change = SDL_GetTicks();
-
-    // RNG for blackhole spawn (reuse rng declared above)
-    std::uniform_real_distribution<float> distX(100.0f, WORLD_W - 100.0f);
-    std::uniform_real_distribution<float> distY(100.0f, WORLD_H - 100.0f);
-        const Uint32 blackhole_precaution_ms = 5000; // 5 seconds before first spawn
-        const Uint32 blackhole_interval_ms = 30000; // spawn every 30 seconds
-        const Uint32 blackhole_life_ms = 15000; // blackhole exists for 15 seconds
-        Uint32 start_time = SDL_GetTicks();
-        Uint32 last_bh_spawn = 0; // 0 indicates not spawned yet
-
-        // Mark first players as activated (for rendering active circle)
-        p1.set_activate(true);
-        p3.set_activate(true);
+    // Presentation-only effects, spawned from match events
+    // blood and smoke particles; without the effects file the game just runs without them
+    ParticleSystem particles;
+    if (particles.load(EFFECTS_PATH)) particles.load_textures(rm);
+    const int fx_blood = particles.find("blood_hit");
+    const int fx_smoke = particles.find("death_smoke");
+    std::vector<MatchEvent> match_events;
 
     // set renderer logical size so world coordinates map to window
     SDL_RenderSetLogicalSize(renderer, WORLD_W, WORLD_H);
@@ -369,12 +539,17 @@ int main (int argc, char *argv[]) {
     // game loop
     bool in_game = true;
     bool debug_hitboxes = false;
-        Uint32 last = SDL_GetTicks();
+        FixedTimestep clock;
+        SpriteBatch batch(renderer);
+        Uint64 last = SDL_GetPerformanceCounter();
+        const double counter_freq = (double)SDL_GetPerformanceFrequency();
         int winning_team = -1; // 1 = red (team 1), 2 = blue (team 2)
     // simple on-screen notifications
     struct Notify { std::string text; Uint32 expiry; };
     std::vector<Notify> notifications;
         while (in_game) {
+            // last frame's HUD strings and scratch lists die here
+            FrameArena::instance().reset();
             SDL_Event e;
             while (SDL_PollEvent(&e)) {
                 if (e.type == SDL_QUIT) { in_game = false; running = false; break; }
@@ -385,401 +560,127 @@ int main (int argc, char *argv[]) {
                     if (flags & SDL_WINDOW_FULLSCREEN) SDL_SetWindowFullscreen(window, 0);
                     else SDL_SetWindowFullscreen(window, SDL_WINDOW_FULLSCREEN_DESKTOP);
                 }
-                // Pass events to input handlers which will add bullets to bullets vector
-                ih1.handle_event(e, bullets, rm);
-                ih2.handle_event(e, bullets, rm);
+                // Pass events to the match's input handlers (movement, swap, shoot); a replay brings its own
+                if (!replay_path) match.handle_event(e);
+                if (replay_path && e.type == SDL_KEYDOWN && (e.key.keysym.sym == SDLK_LEFT || e.key.keysym.sym == SDLK_RIGHT)) {
+                    // scrub the replay 5 s back / forward
+                    long long jump = 5LL * SIM_TICK_HZ * (e.key.keysym.sym == SDLK_LEFT ? -1 : 1);
+                    replay.seek((uint64_t)std::max(0LL, (long long)replay.get_tick() + jump), match);
+                }
                 if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_b) debug_hitboxes = !debug_hitboxes;
-                if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_E) {
-                    // spawn an explosion at center for testing and a smoke
+                if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_p) profiler_overlay.toggle();
+                if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_E && !replay_path && !recorder.is_open()) {
+                    // spawn an explosion at center for testing and a smoke (not recordable, so off in replays)
                     Vector2 pos(WORLD_W/2.0f - 50.0f, WORLD_H/2.0f - 50.0f);
-                    Explosion* ex = new Explosion(renderer, "assets/pictures/rielno.png", pos, 50, 50, 9, 40, 3);
-                    explosions.push_back(ex);
-                    Smoke* s = new Smoke(renderer, "assets/pictures/khoi.png", pos, 64, 64, 8, 80, 4);
-                    smokes.push_back(s);
-                }
-            }
-
-            Uint32 now = SDL_GetTicks();
-            float dt = (now - last) / 1000.0f; last = now;
-
-            for (auto* u : updatables) u->update(dt);
-            for (auto& bhp : blackholes) if (bhp.first) bhp.first->update(dt);
-            for (auto* b : bullets) b->update(dt);
-            for (auto* ex : explosions) ex->update(dt);
-            // Explosion collisions: let characters and bullets react to explosions
-            for (auto* ex : explosions) {
-                for (auto* c : characters) if (c) c->collide(ex);
-                for (auto* bl : bullets) if (bl) ex->collide(bl);
-            }
-            for (auto* b : bloods) b->update(dt);
-            for (auto* s : smokes) s->update(dt);
-
-            // (PVE blackhole logic belongs inside the PVE runner; removed stray block)
-
-            // detect damage and deaths: spawn blood on hit, smoke on death, remove dead immediately
-            std::vector<Character*> just_died;
-            for (auto c : characters) {
-                if (!c) continue;
-                float old_h = prev_health[c];
-                float new_h = c->get_health();
-                // took damage (but still alive) -> spawn small blood splash
-                if (new_h < old_h && new_h > 0.0f) {
-                    Vector2 bpos = c->get_position();
-                    // blood sprite: 24x24 frames, 8 frames, 80ms per frame, 3 columns
-                    BloodSplash* bs = new BloodSplash(renderer, std::string("assets/pictures/blood.png"), bpos, 16, 16, 8, 80, 3);
-                    bloods.push_back(bs);
-                    
-                }
-                // just died -> spawn smoke and mark for removal
-                if (old_h > 0.0f && new_h <= 0.0f) {
-                    Vector2 spos = c->get_position();
-                    Smoke* s = new Smoke(renderer, "assets/pictures/khoi.png", spos, 24, 24, 8, 80, 3);
-                    smokes.push_back(s);
-                    
-                    just_died.push_back(c);
-                    // notify input handlers to swap control or clear references
-                    ih1.on_character_death(c);
-                    ih2.on_character_death(c);
-                }
-                prev_health[c] = new_h;
-            }
-            // remove dead characters from active lists so they immediately disappear from HUD/world
-            if (!just_died.empty()) {
-                for (auto d : just_died) {
-                    // remove from characters vector
-                    characters.erase(std::remove(characters.begin(), characters.end(), d), characters.end());
-                    // remove from updatables so they are no longer updated
-                    updatables.erase(std::remove(updatables.begin(), updatables.end(), static_cast<IUpdatable*>(d)), updatables.end());
-                    // remove prev_health entry
-                    prev_health.erase(d);
+                    match.spawn_explosion(pos);
+                    particles.start(fx_smoke, pos);
                 }
             }
 
-            // remove finished explosions
-            explosions.erase(std::remove_if(explosions.begin(), explosions.end(), [](Explosion* e){ if (e->is_finished()) { delete e; return true; } return false; }), explosions.end());
-            // remove finished bloods
-            bloods.erase(std::remove_if(bloods.begin(), bloods.end(), [](BloodSplash* b){ if (b->is_finished()) { delete b; return true; } return false; }), bloods.end());
-            // remove finished smokes
-            smokes.erase(std::remove_if(smokes.begin(), smokes.end(), [](Smoke* s){ if (s->is_finished()) { delete s; return true; } return false; }), smokes.end());
-
-            // Blackhole spawn & lifetime logic
-            Uint32 now_bh = SDL_GetTicks();
-            // Start spawning only after precaution
-            if (now_bh - start_time >= blackhole_precaution_ms) {
-                if (last_bh_spawn == 0 || now_bh - last_bh_spawn >= blackhole_interval_ms) {
-                    bool ok = false; int attempts = 0; Vector2 p;
-                    while (!ok && attempts < 20) {
-                        p.x = distX(rng);
-                        p.y = distY(rng);
-                        ok = true;
-                        for (auto* c : characters) {
-                            float dx = c->get_position().x - p.x;
-                            float dy = c->get_position().y - p.y;
-                            if (dx*dx + dy*dy < 200.0f * 200.0f) { ok = false; break; }
-                        }
-                        attempts++;
-                    }
-                    if (ok) {
-                        BlackHole* nb = new BlackHole(p, nullptr, 65.0f, 30.0f, 5.0f, 15.0f);
-                        nb->set_animation(&blackhole_anim);
-                        blackholes.emplace_back(nb, now_bh);
-                    }
-                    last_bh_spawn = now_bh;
-                }
-            }
-
-            // Remove expired blackholes
-            for (auto& bhp : blackholes) {
-                if (bhp.first && now_bh - bhp.second >= blackhole_life_ms) {
-                    delete bhp.first;
-                    bhp.first = nullptr;
-                }
-            }
-            blackholes.erase(std::remove_if(blackholes.begin(), blackholes.end(), [](const std::pair<BlackHole*,Uint32>& p){ return p.first == nullptr; }), blackholes.end());
-
-            
-            // collisions: bullets vs blackholes/walls/characters (single-sample per bullet)
-            for (auto* b : bullets) {
-                if (!b) continue;
-                // use current bullet position (Bullet::update() performs its own internal CCD if needed)
-                for (auto& bhp : blackholes) if (bhp.first) bhp.first->collide(b);
-                if (b->is_destroyed()) continue;
-
-                topWall.collide(b); if (b->is_destroyed()) continue;
-                bottomWall.collide(b); if (b->is_destroyed()) continue;
-                leftWall.collide(b); if (b->is_destroyed()) continue;
-                rightWall.collide(b); if (b->is_destroyed()) continue;
-                for (auto* rw : pvp_random_walls) if (rw) { rw->collide(b); if (b->is_destroyed()) continue; }
-                if (b->is_destroyed()) continue;
-
-                for (auto* c : characters) if (c) { c->collide(b); if (b->is_destroyed()) break; }
-            }
+            // real frame time drives the effects; the match only ever sees fixed ticks
+            Uint64 now = SDL_GetPerformanceCounter();
+            float dt = (float)((now - last) / counter_freq); last = now;
 
-            // bullet vs bullet collisions: bullets from different teams destroy each other
-            for (size_t i = 0; i < bullets.size(); ++i) {
-                Bullet* a = bullets[i];
-                if (!a || a->is_destroyed()) continue;
-                for (size_t j = i + 1; j < bullets.size(); ++j) {
-                    Bullet* b = bullets[j];
-                    if (!b || b->is_destroyed()) continue;
-                    if (a->get_team_id() == b->get_team_id()) continue;
-                    bool collided = false;
-                    for (auto* ah : a->get_hitboxes()) {
-                        for (auto* bh : b->get_hitboxes()) {
-                            if (ah->is_collide(*bh)) { collided = true; break; }
+            int steps = clock.advance(dt);
+            {
+                PROFILE_SCOPE("sim.step");
+                for (int s = 0; s < steps && !match.is_over(); ++s) {
+                    uint8_t states[ReplayWriter::NUM_TEAMS];
+                    if (replay_path) {
+                        if (!replay.next(states)) { in_game = false; break; }
+                        for (int t = 0; t < ReplayWriter::NUM_TEAMS; ++t) match.set_input_state(t, states[t]);
+                    } else if (recorder.is_open()) {
+                        if (recorder.wants_snapshot()) {
+                            match.save_state(snapshot);
+                            recorder.write_snapshot(snapshot);
                         }
-                        if (collided) break;
-                    }
-                    if (collided) {
-                        a->set_destroyed(true);
-                        b->set_destroyed(true);
+                        for (int t = 0; t < ReplayWriter::NUM_TEAMS; ++t) states[t] = match.get_input_state(t);
+                        recorder.record(states);
                     }
+                    match.step(clock.step_dt());
                 }
             }
-
-            // remove destroyed bullets (explode if necessary) - follow tests/test_char.cpp
-            bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [&](Bullet* bullet){
-                if (!bullet) return true;
-                if (bullet->is_destroyed()) {
-                    if (bullet->getBuff() == BulletBuffType::EXPLODING) {
-                        bullet->explode(explosions, renderer);
-                    }
-                    delete bullet;
-                    return true;
-                }
-                return false;
-            }), bullets.end());
-            for (auto& bhp : blackholes) if (bhp.first) {
-                for (auto* c : characters) bhp.first->collide(c);
-            }
-
-            // Ensure characters collide with boundary walls and random internal walls so they cannot pass through
-            for (auto* c : characters) {
-                if (!c) continue;
-                topWall.collide(c);
-                bottomWall.collide(c);
-                leftWall.collide(c);
-                rightWall.collide(c);
-                for (auto* rw : pvp_random_walls) if (rw) rw->collide(c);
-            }
-
-            // Buff spawn logic every 10s
-            if (SDL_GetTicks() - last_buff_spawn >= buff_interval_ms) {
-                // Choose a buff at random among all CharBuffType and BulletBuffType values.
-                std::variant<CharBuffType, BulletBuffType> bt;
-                // Only spawn a bullet buff if no character currently has a bullet buff active
-                bool any_bullet_buff = false;
-                for (auto* c : characters) if (c) {
-                    if (c->get_gun_buff_type() != BulletBuffType::NONE) { any_bullet_buff = true; break; }
-                }
-
-                // Enumerate CharBuffType and BulletBuffType ranges
-                const int num_char_buffs = (int)CharBuffType::NUM; // e.g., HEALTH, SPEED
-                // For BulletBuffType, we don't have a NUM enumerator; infer by listing known values
-                // Define an ordered array of available bullet buffs
-                std::vector<BulletBuffType> bulletTypes = { BulletBuffType::BOUNCING, BulletBuffType::EXPLODING, BulletBuffType::PIERCING };
-
-                // Decide whether to spawn a char buff or bullet buff with equal probability
-                std::uniform_int_distribution<int> chooseType(0, 1);
-                int kind = chooseType(rng);
-                if (kind == 0) {
-                    // Char buff: pick uniformly from CharBuffType values
-                    std::uniform_int_distribution<int> chooseChar(0, num_char_buffs - 1);
-                    int idx = chooseChar(rng);
-                    bt = static_cast<CharBuffType>(idx);
-                } else {
-                    // Bullet buff: only if none currently active
-                    if (any_bullet_buff) {
-                        // fallback to a random char buff
-                        std::uniform_int_distribution<int> chooseChar(0, num_char_buffs - 1);
-                        int idx = chooseChar(rng);
-                        bt = static_cast<CharBuffType>(idx);
-                    } else {
-                        std::uniform_int_distribution<int> chooseBullet(0, (int)bulletTypes.size() - 1);
-                        int idx = chooseBullet(rng);
-                        bt = bulletTypes[idx];
-                    }
-                }
-                // pick a spawn position that does not intersect any wall hitbox
-                Vector2 pos;
-                bool placed = false;
-                for (int attempt = 0; attempt < 30 && !placed; ++attempt) {
-                    pos = Vector2(wallX(rng), wallY(rng));
-                    // create a temporary OBB for the buff area (32x32)
-                    OBB tmp_box(pos, Vector2(16.0f, 16.0f), 0.0f);
-                    bool intersects = false;
-                    // check boundary walls
-                    for (auto* hb : topWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    for (auto* hb : bottomWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    for (auto* hb : leftWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    for (auto* hb : rightWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    // check random internal walls
-                    for (auto* rw : pvp_random_walls) if (rw) {
-                        for (auto* hb : rw->get_hitboxes()) {
-                            if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                        }
-                        if (intersects) break;
-                    }
-                    if (!intersects) placed = true;
-                }
-                if (placed) {
-                    // select texture based on buff type (use ResourceManager textures when available)
-                    SDL_Texture* chosen_tex = nullptr;
-                    if (std::holds_alternative<CharBuffType>(bt)) {
-                        CharBuffType cb = std::get<CharBuffType>(bt);
-                        switch (cb) {
-                            case CharBuffType::HEALTH: chosen_tex = rm.get_texture("health-buff"); break;
-                            case CharBuffType::SPEED: chosen_tex = rm.get_texture("speed-buff"); break;
-                            default: chosen_tex = rm.get_texture("health-buff"); break;
-                        }
-                    } else if (std::holds_alternative<BulletBuffType>(bt)) {
-                        BulletBuffType bb = std::get<BulletBuffType>(bt);
-                        switch (bb) {
-                            case BulletBuffType::BOUNCING: chosen_tex = rm.get_texture("bounce-buff"); break;
-                            case BulletBuffType::EXPLODING: chosen_tex = rm.get_texture("explode-buff"); break;
-                            case BulletBuffType::PIERCING: chosen_tex = rm.get_texture("piercing-buff"); break;
-                            default: chosen_tex = nullptr; break;
-                        }
-                    }
-
-                    SDL_Texture* btex = chosen_tex;
-                    // fallback: create a temporary orange texture if resource missing
-                    if (!btex) {
-                        SDL_Surface* bs = SDL_CreateRGBSurface(0, 32, 32, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-                        SDL_FillRect(bs, NULL, SDL_MapRGBA(bs->format, 200, 100, 0, 255));
-                        btex = SDL_CreateTextureFromSurface(renderer, bs);
-                        SDL_FreeSurface(bs);
-                    }
-
-                    BuffItem* bi = new BuffItem(pos, btex, bt);
-                    buffs.push_back(bi);
-                    updatables.push_back(bi);
+            const float alpha = clock.alpha();
+
+            // blood on hit, smoke on death, banner on gun switch
+            match_events.clear();
+            match.poll_events(match_events);
+            for (const MatchEvent& ev : match_events) {
+                switch (ev.type) {
+                    case MatchEventType::HIT:
+                        // blood sprite: 16x16 frames, 8 frames, 80ms per frame, 3 columns
+                        particles.start(fx_blood, ev.position);
+                        break;
+                    case MatchEventType::DEATH:
+                        particles.start(fx_smoke, ev.position);
+                        break;
+                    case MatchEventType::GUN_SWITCH:
+                        // push a global notification for 2.5s
+                        notifications.push_back({ std::string("Guns switched!"), SDL_GetTicks() + 2500 });
+                        break;
                 }
-                last_buff_spawn = SDL_GetTicks();
-            }
-
-            // Let characters check for buff collisions and remove consumed buffs (same logic as tests/test_char.cpp)
-            for (auto* c : characters) {
-                if (!c) continue;
-                for (auto* bi : buffs) if (bi) c->collide(bi);
             }
             {
-                auto it = buffs.begin();
-                while (it != buffs.end()) {
-                    BuffItem* bi = *it;
-                    if (bi->is_consumed()) {
-                        // If the consumed buff was a BulletBuff, clear bullet buffs from other characters
-                        auto btype = bi->get_buff_type();
-                        if (std::holds_alternative<BulletBuffType>(btype)) {
-                            BulletBuffType taken = std::get<BulletBuffType>(btype);
-                            // assign to the first character who overlaps (character::collide already set their buff),
-                            // but ensure others have no bullet buff
-                            for (auto* c : characters) if (c) {
-                                if (c->get_gun_buff_type() != BulletBuffType::NONE && c->get_gun_buff_type() != taken) {
-                                    c->clear_bullet_buff();
-                                }
-                            }
-                        }
-                        updatables.erase(std::remove(updatables.begin(), updatables.end(), static_cast<IUpdatable*>(bi)), updatables.end());
-                        delete bi;
-                        it = buffs.erase(it);
-                    } else {
-                        ++it;
-                    }
-                }
+                PROFILE_SCOPE("effects.update");
+                particles.update(dt, &jobs);
             }
 
-            // Rotate guns every gun_change_ms (Pistol <-> AK)
-            if (SDL_GetTicks() - last_gun_change >= gun_change_ms) {
-                last_gun_change = SDL_GetTicks();
-                // toggle and collect a message indicating new global gun
-                for (auto* c : characters) {
-                    if (!c) continue;
-                    GunType cur = c->get_gun_type();
-                    GunType next = GunType::PISTOL;
-                    if (cur == GunType::PISTOL) next = GunType::AK;
-                    else next = GunType::PISTOL;
-                    c->set_gun_type(next);
-                }
-                // push a global notification for 2.5s
-                std::string msg = "Guns switched!";
-                notifications.push_back({ msg, SDL_GetTicks() + 2500 });
-            }
-
-            // Team win detection: check team membership via each character's input set (team id)
-            bool red_alive = false, blue_alive = false;
-            for (auto* ch : characters) {
-                if (!ch) continue;
-                if (ch->get_input_set() == 0) { if (ch->get_health() > 0.0f) red_alive = true; }
-                else if (ch->get_input_set() == 1) { if (ch->get_health() > 0.0f) blue_alive = true; }
-            }
-            if (!red_alive || !blue_alive) {
-                // determine winner: team 1 = input_set 0 (red), team 2 = input_set 1 (blue)
-                if (red_alive && !blue_alive) winning_team = 1;
-                else if (blue_alive && !red_alive) winning_team = 2;
-                else winning_team = -1; // tie or all dead
+            if (match.is_over()) {
                 // exit main loop; we'll display the victory banner after the loop
+                winning_team = match.get_winning_team();
                 in_game = false;
             }
 
             // render
-            SDL_SetRenderDrawColor(renderer, 0,0,0,255);
-            SDL_RenderClear(renderer);
-
-            // draw battlefield background (if available)
-            SDL_Texture* bgtex = rm.get_texture("background");
-            if (bgtex) {
-                SDL_Rect dst = { 0, 0, WORLD_W, WORLD_H };
-                SDL_RenderCopy(renderer, bgtex, NULL, &dst);
-            }
-            // draw world boundary (visible)
-            SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
-            SDL_Rect worldRect = { 0, 0, WORLD_W, WORLD_H };
-            SDL_RenderDrawRect(renderer, &worldRect);
-
-            // render walls (they also have hitboxes)
-            topWall.render(renderer);
-            bottomWall.render(renderer);
-            leftWall.render(renderer);
-            rightWall.render(renderer);
-            // render random internal walls
-            for (auto* rw : pvp_random_walls) if (rw) rw->render(renderer);
-
-            // draw characters
-            for (auto* c : characters) {
-                c->render(renderer);
-            }
+            {
+                PROFILE_SCOPE("render.world");
+                SDL_SetRenderDrawColor(renderer, 0,0,0,255);
+                SDL_RenderClear(renderer);
 
-            for (auto* b : bullets) {
-                b->render(renderer);
-            }
+                // draw battlefield background (if available)
+                SDL_Texture* bgtex = rm.get_texture("background").texture;
+                if (bgtex) {
+                    SDL_Rect dst = { 0, 0, WORLD_W, WORLD_H };
+                    SDL_RenderCopy(renderer, bgtex, NULL, &dst);
+                }
+                // draw world boundary (visible)
+                SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
+                SDL_Rect worldRect = { 0, 0, WORLD_W, WORLD_H };
+                SDL_RenderDrawRect(renderer, &worldRect);
+
+                // world sprites go through the batch: one draw call per texture per layer
+                batch.set_layer(SpriteLayer::WALLS);
+                for (auto* w : match.get_walls()) w->render(batch);
+                batch.set_layer(SpriteLayer::CHARACTERS);
+                for (auto* c : characters) c->render(batch, alpha);
+                batch.set_layer(SpriteLayer::BULLETS);
+                match.get_bullets().render(batch, rm.get_texture("bullet"), alpha);
+                batch.set_layer(SpriteLayer::EXPLOSIONS);
+                for (auto* ex : match.get_explosions()) ex->render(batch);
+                particles.render(batch); // blood + smoke layers
+                batch.set_layer(SpriteLayer::BUFFS);
+                for (auto* bi : match.get_buffs()) {
+                    if (!bi->get_sprite()) bi->set_sprite(buff_texture(bi->get_buff_type()));
+                    bi->render(batch);
+                }
+                batch.set_layer(SpriteLayer::BLACKHOLES);
+                for (auto& bhp : match.get_blackholes()) {
+                    bhp.first->set_animation(&blackhole_anim);
+                    bhp.first->render(batch);
+                }
+                batch.flush();
 
-            // debug: draw hitboxes
-            if (debug_hitboxes) {
-                // bullet hitboxes
-                for (auto* bullet : bullets) {
-                    for (auto* hb : bullet->get_hitboxes()) hb->debug_draw(renderer, {255, 0, 0, 255});
+                // line overlays on top of the sprites: wall outlines, active-player circles, debug hitboxes
+                for (auto* w : match.get_walls()) for (auto* hb : w->get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
+                for (auto* c : characters) c->render_overlay(renderer, alpha);
+                if (debug_hitboxes) {
+                    // bullet hitboxes
+                    match.get_bullets().debug_draw(renderer, {255, 0, 0, 255});
                 }
-                // wall hitboxes
-                for (auto* rw : pvp_random_walls) if (rw) for (auto* hb : rw->get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
-                for (auto* hb : topWall.get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
-                for (auto* hb : bottomWall.get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
-                for (auto* hb : leftWall.get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
-                for (auto* hb : rightWall.get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
             }
-
-            for (auto* ex : explosions) { ex->render(renderer); }
-            for (auto* b : bloods) b->render(renderer);
-            for (auto* s : smokes) s->render(renderer);
-            for (auto* bi : buffs) if (bi) bi->render(renderer);
-            for (auto& bhp : blackholes) if (bhp.first) bhp.first->render(renderer);
-
             // UI overlay: split HUD into top-left and top-right panels
-            if (font) {
+            if (text) {
+                PROFILE_SCOPE("render.hud");
                 SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
                 // render notifications (centered on screen)
                 // compute how many valid notifications we have so we can vertically center the stack
@@ -790,14 +691,7 @@ int main (int argc, char *argv[]) {
                 for (auto it = notifications.begin(); it != notifications.end();) {
                     if ((int)it->text.size() == 0 || SDL_GetTicks() > it->expiry) { it = notifications.erase(it); continue; }
                     SDL_Color textColor = { 255, 220, 120, 255 };
-                    SDL_Surface* t = TTF_RenderText_Blended(font, it->text.c_str(), textColor);
-                    if (t) {
-                        SDL_Texture* tt = SDL_CreateTextureFromSurface(renderer, t);
-                        int tw = t->w, th = t->h;
-                        SDL_Rect td = { WORLD_W/2 - tw/2, notifY, tw, th };
-                        SDL_FreeSurface(t);
-                        if (tt) { SDL_RenderCopy(renderer, tt, NULL, &td); SDL_DestroyTexture(tt); }
-                    }
+                    text->draw(it->text, WORLD_W/2 - text->measure(it->text)/2, notifY, textColor);
                     notifY += lineH;
                     ++it;
                 }
@@ -858,19 +752,6 @@ int main (int argc, char *argv[]) {
                     }
                 }
 
-                // helper: ellipsize to pixel width
-                auto ellipsize = [&](const std::string &full, int maxW) {
-                    std::string s = full;
-                    int w = 0, h = 0;
-                    if (TTF_SizeText(font, s.c_str(), &w, &h) == 0 && w <= maxW) return s;
-                    while (!s.empty()) {
-                        s = s.substr(0, s.size() - 1);
-                        std::string t = s + "...";
-                        if (TTF_SizeText(font, t.c_str(), &w, &h) == 0 && w <= maxW) return t;
-                    }
-                    return std::string("...");
-                };
-
                 // left column entries (team 0) - fixed 2 slots
                 for (int idx = 0; idx < 2; ++idx) {
                     Character* ch = team0_slots[idx];
@@ -885,32 +766,13 @@ int main (int argc, char *argv[]) {
                     SDL_SetRenderDrawColor(renderer, 200, 60, 60, 255);
                     SDL_RenderFillRect(renderer, &sw);
 
-                    std::string basename = (idx==0?"player1_1":"player1_2");
-                    std::string fullName = basename + (ch ? (ch->get_gun_type() == GunType::AK ? " AK" : " PIS") : " (dead)");
+                    std::pmr::string fullName(idx==0?"player1_1":"player1_2", FrameArena::get());
+                    fullName += ch ? (ch->get_gun_type() == GunType::AK ? " AK" : " PIS") : " (dead)";
                     int maxTextW = panelW - 28 - 48;
-                    std::string nameToRender = ellipsize(fullName, maxTextW);
-                    SDL_Color textColor = { 230, 230, 230, 255 };
-                    int textH = 0;
-                    if (ch) {
-                        SDL_Surface* textSurf = TTF_RenderText_Blended(font, nameToRender.c_str(), textColor);
-                        if (textSurf) {
-                            textH = textSurf->h;
-                            SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                            SDL_Rect dst = { x + 28, y + 10, textSurf->w, textH };
-                            SDL_FreeSurface(textSurf);
-                            if (textTex) { SDL_RenderCopy(renderer, textTex, NULL, &dst); SDL_DestroyTexture(textTex); }
-                        }
-                    } else {
-                        // render dimmed placeholder name
-                        SDL_Surface* textSurf = TTF_RenderText_Blended(font, nameToRender.c_str(), SDL_Color{160,160,160,255});
-                        if (textSurf) {
-                            textH = textSurf->h;
-                            SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                            SDL_Rect dst = { x + 28, y + 10, textSurf->w, textH };
-                            SDL_FreeSurface(textSurf);
-                            if (textTex) { SDL_RenderCopy(renderer, textTex, NULL, &dst); SDL_DestroyTexture(textTex); }
-                        }
-                    }
+                    // dimmed placeholder name once the slot's character is dead; ellipsized to fit
+                    SDL_Color textColor = ch ? SDL_Color{ 230, 230, 230, 255 } : SDL_Color{ 160, 160, 160, 255 };
+                    text->draw(fullName, x + 28, y + 10, textColor, maxTextW);
+                    int textH = text->line_height();
 
                     float hp = ch ? std::max(0.0f, ch->get_health()) : 0.0f;
                     float hpfrac = std::min(1.0f, hp / 100.0f);
@@ -925,25 +787,25 @@ int main (int argc, char *argv[]) {
                     int ix = x + panelW - 28;
                     int iconY = y + 10;
                     if (ch) {
-                        auto cbs = ch->get_active_char_buffs();
+                        auto cbs = ch->get_active_char_buffs(FrameArena::get());
                         for (auto cb : cbs) {
-                            SDL_Texture* cbtex = nullptr;
+                            TextureRegion cbtex;
                             switch (cb) {
                                 case CharBuffType::HEALTH: cbtex = rm.get_texture("health-buff"); break;
                                 case CharBuffType::SPEED: cbtex = rm.get_texture("speed-buff"); break;
                                 default: break;
                             }
-                            if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex, NULL, &cbdst); ix -= 20 + 6; }
+                            if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex.texture, cbtex.get_src(), &cbdst); ix -= 20 + 6; }
                         }
                         BulletBuffType bb = ch->get_active_bullet_buff();
-                        SDL_Texture* btex = nullptr;
+                        TextureRegion btex;
                         switch (bb) {
                             case BulletBuffType::BOUNCING: btex = rm.get_texture("bounce-buff"); break;
                             case BulletBuffType::EXPLODING: btex = rm.get_texture("explode-buff"); break;
                             case BulletBuffType::PIERCING: btex = rm.get_texture("piercing-buff"); break;
                             default: break;
                         }
-                        if (btex) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex, NULL, &bdst); ix -= 20 + 6; }
+                        if (btex) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex.texture, btex.get_src(), &bdst); ix -= 20 + 6; }
                     }
                 }
 
@@ -961,31 +823,12 @@ int main (int argc, char *argv[]) {
                     SDL_SetRenderDrawColor(renderer, 80, 120, 220, 255);
                     SDL_RenderFillRect(renderer, &sw);
 
-                    std::string basename = (ridx==0?"player2_1":"player2_2");
-                    std::string fullName = basename + (ch ? (ch->get_gun_type() == GunType::AK ? " AK" : " PIS") : " (dead)");
+                    std::pmr::string fullName(ridx==0?"player2_1":"player2_2", FrameArena::get());
+                    fullName += ch ? (ch->get_gun_type() == GunType::AK ? " AK" : " PIS") : " (dead)";
                     int maxTextW = panelW - 28 - 48;
-                    std::string nameToRender = ellipsize(fullName, maxTextW);
-                    SDL_Color textColor = { 230, 230, 230, 255 };
-                    int textH = 0;
-                    if (ch) {
-                        SDL_Surface* textSurf = TTF_RenderText_Blended(font, nameToRender.c_str(), textColor);
-                        if (textSurf) {
-                            textH = textSurf->h;
-                            SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                            SDL_Rect dst = { x + 28, y + 10, textSurf->w, textH };
-                            SDL_FreeSurface(textSurf);
-                            if (textTex) { SDL_RenderCopy(renderer, textTex, NULL, &dst); SDL_DestroyTexture(textTex); }
-                        }
-                    } else {
-                        SDL_Surface* textSurf = TTF_RenderText_Blended(font, nameToRender.c_str(), SDL_Color{160,160,160,255});
-                        if (textSurf) {
-                            textH = textSurf->h;
-                            SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                            SDL_Rect dst = { x + 28, y + 10, textSurf->w, textH };
-                            SDL_FreeSurface(textSurf);
-                            if (textTex) { SDL_RenderCopy(renderer, textTex, NULL, &dst); SDL_DestroyTexture(textTex); }
-                        }
-                    }
+                    SDL_Color textColor = ch ? SDL_Color{ 230, 230, 230, 255 } : SDL_Color{ 160, 160, 160, 255 };
+                    text->draw(fullName, x + 28, y + 10, textColor, maxTextW);
+                    int textH = text->line_height();
 
                     float hp = ch ? std::max(0.0f, ch->get_health()) : 0.0f;
                     float hpfrac = std::min(1.0f, hp / 100.0f);
@@ -1000,33 +843,51 @@ int main (int argc, char *argv[]) {
                     int ix = x + panelW - 28;
                     int iconY = y + 10;
                     if (ch) {
-                        auto cbs2 = ch->get_active_char_buffs();
+                        auto cbs2 = ch->get_active_char_buffs(FrameArena::get());
                         for (auto cb : cbs2) {
-                            SDL_Texture* cbtex = nullptr;
+                            TextureRegion cbtex;
                             switch (cb) {
                                 case CharBuffType::HEALTH: cbtex = rm.get_texture("health-buff"); break;
                                 case CharBuffType::SPEED: cbtex = rm.get_texture("speed-buff"); break;
                                 default: break;
                             }
-                            if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex, NULL, &cbdst); ix -= 20 + 6; }
+                            if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex.texture, cbtex.get_src(), &cbdst); ix -= 20 + 6; }
                         }
                         BulletBuffType bb2 = ch->get_active_bullet_buff();
-                        SDL_Texture* btex2 = nullptr;
+                        TextureRegion btex2;
                         switch (bb2) {
                             case BulletBuffType::BOUNCING: btex2 = rm.get_texture("bounce-buff"); break;
                             case BulletBuffType::EXPLODING: btex2 = rm.get_texture("explode-buff"); break;
                             case BulletBuffType::PIERCING: btex2 = rm.get_texture("piercing-buff"); break;
                             default: break;
                         }
-                        if (btex2) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex2, NULL, &bdst); ix -= 20 + 6; }
+                        if (btex2) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex2.texture, btex2.get_src(), &bdst); ix -= 20 + 6; }
                     }
                 }
             }
 
-            SDL_RenderPresent(renderer);
-            SDL_Delay(16);
+            profiler_overlay.render(renderer, text, WORLD_W/2 - 230, 12);
+
+            // paced by vsync, no fixed SDL_Delay
+            {
+                PROFILE_SCOPE("render.present");
+                SDL_RenderPresent(renderer);
+            }
+            Profiler::instance().end_frame();
         }
 
+    if (recorder.is_open()) {
+        uint64_t ticks = recorder.get_tick_count();
+        if (recorder.close(match.get_checksum())) std::cout << "replay: recorded " << ticks << " ticks to " << record_path << "\n";
+    }
+    if (replay_path) {
+        // a finished playback must land on exactly the recorded end state
+        bool finished = replay.get_tick() == replay.get_tick_count();
+        bool same = finished && match.get_checksum() == replay.get_checksum();
+        std::cout << "replay: " << replay.get_tick() << "/" << replay.get_tick_count() << " ticks, "
+                  << (!finished ? "stopped early" : same ? "checksum OK" : "DIVERGED") << "\n";
+    }
+
     // If a winning team was determined, show a highlighted victory banner for 3 seconds
     if (winning_team == 1 || winning_team == 2) {
         Uint32 show_until = SDL_GetTicks() + 3000;
@@ -1041,20 +902,13 @@ int main (int argc, char *argv[]) {
             std::string winText = "Team " + std::to_string(winning_team) + " wins!";
             SDL_Color hl = { 255, 200, 60, 255 };
             SDL_Color textColor = { 30, 30, 30, 255 };
-            SDL_Surface* surf = TTF_RenderText_Blended(font ? font : nullptr, winText.c_str(), textColor);
-            if (surf) {
-                SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                int tw = surf->w, th = surf->h;
-                SDL_FreeSurface(surf);
+            if (text) {
+                int tw = text->measure(winText), th = text->line_height();
                 // draw highlighted box behind text
                 SDL_Rect box = { WORLD_W/2 - (tw+40)/2, WORLD_H/2 - (th+30)/2, tw+40, th+30 };
                 SDL_SetRenderDrawColor(renderer, hl.r, hl.g, hl.b, hl.a);
                 SDL_RenderFillRect(renderer, &box);
-                if (tex) {
-                    SDL_Rect dst = { box.x + 20, box.y + 12, tw, th };
-                    SDL_RenderCopy(renderer, tex, NULL, &dst);
-                    SDL_DestroyTexture(tex);
-                }
+                text->draw(winText, box.x + 20, box.y + 12, textColor);
             }
             SDL_RenderPresent(renderer);
             SDL_Delay(16);
@@ -1064,50 +918,24 @@ int main (int argc, char *argv[]) {
     // restore renderer logical size back to window for menu
     SDL_RenderSetLogicalSize(renderer, WINDOW_W, WINDOW_H);
 
-    // cleanup textures we created
-        SDL_DestroyTexture(red_texture);
-        SDL_DestroyTexture(blue_texture);
-    SDL_DestroyTexture(wall_tex_h);
-    SDL_DestroyTexture(wall_tex_v);
-    // cleanup random walls (PVP)
-    for (auto* rw : pvp_random_walls) {
-        if (rw) delete rw;
-    }
-    pvp_random_walls.clear();
-    // cleanup buffs
-    for (auto* bi : buffs) if (bi) delete bi;
-    buffs.clear();
-    // cleanup blackholes
-    for (auto& bhp : blackholes) if (bhp.first) delete bhp.first;
-    blackholes.clear();
-        rm.unload_all();
+    // textures belong to rm, the match owns and deletes the world objects
     };
 
     // PVE runner: one player vs simple AI enemies
-    auto run_pve_game = [&](void) {
-        ResourceManager rm(renderer);
-        rm.load_texture("bullet", "assets/pictures/bulletA.png");
+    auto run_pve_game = [&](ResourceManager& rm) {
         // battlefield background
         rm.load_texture("background", "assets/pictures/background.png");
+        rm.load_sprite("bullet", "assets/pictures/bulletA.png");
         // PVE: preload buff textures so spawned buffs are visible
-        rm.load_texture("health-buff", "assets/pictures/health-buff.png");
-        rm.load_texture("speed-buff", "assets/pictures/speed-buff.png");
-        rm.load_texture("bounce-buff", "assets/pictures/bounce-buff.png");
-        rm.load_texture("explode-buff", "assets/pictures/explosion-buff.png");
-        rm.load_texture("piercing-buff", "assets/pictures/piercing-buff.png");
+        rm.load_sprite("health-buff", "assets/pictures/health-buff.png");
+        rm.load_sprite("speed-buff", "assets/pictures/speed-buff.png");
+        rm.load_sprite("bounce-buff", "assets/pictures/bounce-buff.png");
+        rm.load_sprite("explode-buff", "assets/pictures/explosion-buff.png");
+        rm.load_sprite("piercing-buff", "assets/pictures/piercing-buff.png");
 
         // Create four characters (two per team) so PVE mirrors PVP but with AI for the other team
-        SDL_Surface* green_surface = SDL_CreateRGBSurface(0, 16, 16, 32,
-            0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
-        SDL_FillRect(green_surface, NULL, SDL_MapRGBA(green_surface->format, 0, 255, 0, 255));
-        SDL_Texture* green_texture = SDL_CreateTextureFromSurface(renderer, green_surface);
-        SDL_FreeSurface(green_surface);
-
-        SDL_Surface* red_surface = SDL_CreateRGBSurface(0, 16, 16, 32,
-            0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
-        SDL_FillRect(red_surface, NULL, SDL_MapRGBA(red_surface->format, 255, 0, 0, 255));
-        SDL_Texture* red_texture = SDL_CreateTextureFromSurface(renderer, red_surface);
-        SDL_FreeSurface(red_surface);
+        TextureRegion green_texture = rm.add_solid("team-green", 16, 16, { 0, 255, 0, 255 });
+        TextureRegion red_texture = rm.add_solid("team-red", 16, 16, { 255, 0, 0, 255 });
 
         AnimatedSprite idle(renderer, "assets/pictures/PlayerIdle.png", 24, 16, 5, 100);
         AnimatedSprite run(renderer,  "assets/pictures/PlayerRunning.png", 24, 16, 5, 100);
@@ -1116,36 +944,47 @@ int main (int argc, char *argv[]) {
         AnimatedSprite run1(renderer,  "assets/pictures/tocvangchay.png", 24, 16, 5, 100);
         AnimatedSprite shoot1(renderer,"assets/pictures/tocvangban.png", 24, 16, 5, 100);
 
-        // 1v1 PVE: one human player (p1) vs one AI (p3)
-        Character p1(Vector2(WORLD_W/2.0f - 160.0f, WORLD_H - 120.0f), green_texture, 200.0f, 200.0f);
+        // 1v1 PVE: one human player (p1) vs one AI (p3); an arena may move them to its team 0 / team 1 first slots
+        Vector2 p1_spawn(WORLD_W/2.0f - 160.0f, WORLD_H - 120.0f);
+        Vector2 p3_spawn(WORLD_W/2.0f + 160.0f - 40.0f, 120.0f);
+        if (arena) {
+            arena->find_spawn(0, 0, p1_spawn);
+            arena->find_spawn(1, 0, p3_spawn);
+        }
+        Character p1(p1_spawn, green_texture, 200.0f, 200.0f);
         // make AI slower: lower speed from 140 -> 90; give bot 200 health per request
-        Character p3(Vector2(WORLD_W/2.0f + 160.0f - 40.0f, 120.0f), red_texture, 90.0f, 200.0f);
+        Character p3(p3_spawn, red_texture, 90.0f, 200.0f);
 
         p1.set_animations(&idle, &run, &shoot);
         p3.set_animations(&idle1, &run1, &shoot1);
 
-    std::vector<Character*> characters = { &p1, &p3 };
+    // Every PVE entity lives in the registry; removals are queued and applied once per tick
+    EntityRegistry registry;
+    registry.spawn(&p1, EntityKind::CHARACTER);
+    registry.spawn(&p3, EntityKind::CHARACTER);
+    const EntityView<Character> characters = registry.view<Character>(EntityKind::CHARACTER);
+    const EntityView<BuffItem> buffs = registry.view<BuffItem>(EntityKind::BUFF);
 
     // Fixed slot mapping for HUD stability in PVE (1v1)
     std::unordered_map<Character*, int> pve_slot_index;
     pve_slot_index[&p1] = 0;
     pve_slot_index[&p3] = 1;
 
-    std::vector<Bullet*> bullets;
+    BulletSystem bullets;
     // PVE: local random walls container (pve_random_walls)
     std::vector<Wall*> pve_random_walls;
     // PVE blackholes container is declared later as pve_blackholes_local
-    std::vector<Explosion*> explosions;
-    std::vector<BloodSplash*> bloods;
-    std::vector<Smoke*> smokes;
-    // Buff items for PVE
-    std::vector<BuffItem*> buffs;
+    ObjectPool<Explosion> explosions(PVE_EXPLOSION_POOL_SIZE, effect_policy, renderer, EXPLOSION_TEXTURE_PATH, Vector2(), 50, 50, 9, 40, 3);
+    ParticleSystem particles;
+    if (particles.load(EFFECTS_PATH)) particles.load_textures(rm);
+    const int fx_blood = particles.find("blood_hit");
+    const int fx_smoke = particles.find("death_smoke");
     const Uint32 buff_interval_ms_pve = 10000; // spawn every 10s in PVE
-    // force a first immediate spawn
-    Uint32 last_buff_spawn_pve = SDL_GetTicks() - buff_interval_ms_pve;
-    // previous health tracking for death detection
-    std::unordered_map<Character*, float> prev_health;
-    for (auto c : characters) if (c) prev_health[c] = c->get_health();
+    // force a first immediate spawn (PVE rule timers run on the simulation clock pve_time_ms)
+    double last_buff_spawn_pve = -(double)buff_interval_ms_pve;
+    // previous health tracking for death detection, indexed by registry slot (grown in sim.deaths for later spawns)
+    std::vector<float> prev_health(registry.get_slot_count(), 0.0f);
+    for (size_t i = 0; i < characters.size(); ++i) prev_health[registry.handle_at(EntityKind::CHARACTER, i).index] = characters[i]->get_health();
 
     // Ensure distinct teams/input sets so bullets are treated as enemies
     p1.set_input_set((int)InputSet::INPUT_1);
@@ -1154,45 +993,46 @@ int main (int argc, char *argv[]) {
     p3.set_activate(false);
 
     // BasicAI controller will control the enemy (p3), human controls p1
-    BasicAI ai1(&p3, &p1, &bullets, &rm); // ai targets player
+    BasicAI ai1(&p3, &p1, &bullets); // ai targets player
 
     // Input handler for the human player controlling p1 only
     InputHandler ih_player(InputSet::INPUT_1, &p1, nullptr);
 
-    // Simple updatables list (player, enemy, input handler, AI)
-    std::vector<IUpdatable*> updatables;
-    updatables.push_back(&p1);
-    updatables.push_back(&p3);
-    updatables.push_back(&ih_player);
-    updatables.push_back(&ai1);
+    registry.spawn(&ih_player, EntityKind::CONTROLLER);
+    registry.spawn(&ai1, EntityKind::CONTROLLER);
 
         // Gun-change timer for PVE: rotate guns every 30s
         const Uint32 gun_change_ms = 30000;
-        Uint32 last_gun_change = SDL_GetTicks();
+        double last_gun_change = 0.0;
 
-        // Walls (reuse same wall creation as PVP for bounds)
+        // Walls (reuse same wall creation as PVP for bounds): gray swatches stretched over each hitbox
         const int wall_thickness = 32;
-        SDL_Surface* wall_surf_h = SDL_CreateRGBSurface(0, WORLD_W, wall_thickness, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-        SDL_FillRect(wall_surf_h, NULL, SDL_MapRGBA(wall_surf_h->format, 80, 80, 80, 255));
-        SDL_Texture* wall_tex_h = SDL_CreateTextureFromSurface(renderer, wall_surf_h);
-        SDL_FreeSurface(wall_surf_h);
-        SDL_Surface* wall_surf_v = SDL_CreateRGBSurface(0, wall_thickness, WORLD_H, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-        SDL_FillRect(wall_surf_v, NULL, SDL_MapRGBA(wall_surf_v->format, 80, 80, 80, 255));
-        SDL_Texture* wall_tex_v = SDL_CreateTextureFromSurface(renderer, wall_surf_v);
-        SDL_FreeSurface(wall_surf_v);
-        Wall topWall(Vector2(WORLD_W/2.0f, wall_thickness / 2.0f), wall_tex_h);
-        Wall bottomWall(Vector2(WORLD_W/2.0f, WORLD_H - wall_thickness / 2.0f), wall_tex_h);
-        Wall leftWall(Vector2(wall_thickness / 2.0f, WORLD_H/2.0f), wall_tex_v);
-        Wall rightWall(Vector2(WORLD_W - wall_thickness / 2.0f, WORLD_H/2.0f), wall_tex_v);
+        const TextureRegion boundary_wall_sprite = rm.add_solid("wall-boundary", 4, 4, { 80, 80, 80, 255 });
+        const TextureRegion wall_sprite = rm.add_solid("wall", 4, 4, { 100, 100, 100, 255 });
+        const Vector2 wall_half_h(WORLD_W / 2.0f, wall_thickness / 2.0f);
+        const Vector2 wall_half_v(wall_thickness / 2.0f, WORLD_H / 2.0f);
+        Wall topWall(Vector2(WORLD_W/2.0f, wall_thickness / 2.0f), wall_half_h, boundary_wall_sprite);
+        Wall bottomWall(Vector2(WORLD_W/2.0f, WORLD_H - wall_thickness / 2.0f), wall_half_h, boundary_wall_sprite);
+        Wall leftWall(Vector2(wall_thickness / 2.0f, WORLD_H/2.0f), wall_half_v, boundary_wall_sprite);
+        Wall rightWall(Vector2(WORLD_W - wall_thickness / 2.0f, WORLD_H/2.0f), wall_half_v, boundary_wall_sprite);
 
     // RNG and random internal walls for PVE (mirror PVP behavior)
     std::random_device rd_pve;
-    std::mt19937 rng_pve(rd_pve());
+    SimRng rng_pve(rd_pve());
     std::uniform_real_distribution<float> wallX_pve(150.0f, WORLD_W - 150.0f);
     std::uniform_real_distribution<float> wallY_pve(150.0f, WORLD_H - 150.0f);
     std::uniform_int_distribution<int> wallW_pve(64, 240);
     std::uniform_int_distribution<int> wallH_pve(16, 96);
-    for (int i = 0; i < 7; ++i) {
+    // hand-made arena: its walls replace both random passes below
+    const int pve_random_wall_count = arena ? 0 : 7;
+    if (arena) {
+        for (const ArenaRect& r : arena->get_walls()) {
+            Wall* rw = new Wall(Vector2(r.x, r.y), Vector2(r.half_w, r.half_h), wall_sprite);
+            pve_random_walls.push_back(rw);
+            registry.spawn(rw, EntityKind::WALL);
+        }
+    }
+    for (int i = 0; i < pve_random_wall_count; ++i) {
         int w = wallW_pve(rng_pve);
         int h = wallH_pve(rng_pve);
         bool placed = false;
@@ -1227,35 +1067,34 @@ int main (int argc, char *argv[]) {
             if (!intersects) { placed = true; chosenPos = pos; } else attempts++;
         }
         if (!placed) continue;
-        SDL_Surface* surf = SDL_CreateRGBSurface(0, w, h, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-        SDL_FillRect(surf, NULL, SDL_MapRGBA(surf->format, 100, 100, 100, 255));
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-        SDL_FreeSurface(surf);
-        Wall* rw = new Wall(chosenPos, tex);
+        Wall* rw = new Wall(chosenPos, Vector2(w / 2.0f, h / 2.0f), wall_sprite);
         pve_random_walls.push_back(rw);
-        updatables.push_back(rw);
+        registry.spawn(rw, EntityKind::WALL);
     }
 
     // game loop simple
     SDL_RenderSetLogicalSize(renderer, WORLD_W, WORLD_H);
     bool in_game = true;
-    Uint32 last = SDL_GetTicks();
+    FixedTimestep clock;
+    SpriteBatch batch(renderer);
+    double pve_time_ms = 0.0; // advanced by fixed ticks only
+    Uint64 last = SDL_GetPerformanceCounter();
+    const double counter_freq = (double)SDL_GetPerformanceFrequency();
     struct Notify { std::string text; Uint32 expiry; };
     std::vector<Notify> notifications;
     // pve_result: 1 = player win, -1 = player lose, 0 = none
     int pve_result = 0;
     // Blackhole RNG + timing for PVE
     std::random_device pve_rd_bh;
-    std::mt19937 pve_rng_bh(pve_rd_bh());
+    SimRng pve_rng_bh(pve_rd_bh());
     std::uniform_real_distribution<float> pve_distX(100.0f, WORLD_W - 100.0f);
     std::uniform_real_distribution<float> pve_distY(100.0f, WORLD_H - 100.0f);
     const Uint32 pve_blackhole_precaution_ms = 5000;
     const Uint32 pve_blackhole_interval_ms = 30000;
     const Uint32 pve_blackhole_life_ms = 15000;
-    Uint32 pve_start_time = SDL_GetTicks();
-    Uint32 pve_last_bh_spawn = 0;
-    // PVE blackholes container
-    std::vector<std::pair<BlackHole*, Uint32>> pve_blackholes_local;
+    double pve_last_bh_spawn = -1.0; // < 0: not spawned yet
+    // PVE blackholes container: (blackhole, spawn time on pve_time_ms)
+    std::vector<std::pair<BlackHole*, double>> pve_blackholes_local;
     // Generate random internal walls for PVE (similar to PVP)
     {
         std::random_device rdp;
@@ -1264,7 +1103,7 @@ int main (int argc, char *argv[]) {
         std::uniform_real_distribution<float> wallYp(150.0f, WORLD_H - 150.0f);
         std::uniform_int_distribution<int> wallWp(64, 240);
         std::uniform_int_distribution<int> wallHp(16, 96);
-        for (int i = 0; i < 7; ++i) {
+        for (int i = 0; i < pve_random_wall_count; ++i) {
             int w = wallWp(rngp);
             int h = wallHp(rngp);
             bool placed = false;
@@ -1297,188 +1136,208 @@ int main (int argc, char *argv[]) {
                 if (!intersects) { placed = true; chosenPos = pos; } else attempts++;
             }
             if (!placed) continue;
-            SDL_Surface* surf = SDL_CreateRGBSurface(0, w, h, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-            SDL_FillRect(surf, NULL, SDL_MapRGBA(surf->format, 100, 100, 100, 255));
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-            SDL_FreeSurface(surf);
-            Wall* rw = new Wall(chosenPos, tex);
+            Wall* rw = new Wall(chosenPos, Vector2(w / 2.0f, h / 2.0f), wall_sprite);
             pve_random_walls.push_back(rw);
-            updatables.push_back(rw);
+            registry.spawn(rw, EntityKind::WALL);
         }
     }
+    // Broadphase: wall BVH built once for this stage, dynamic grid rebuilt every frame
+    StaticBVH wall_bvh;
+    wall_bvh.add(&topWall);
+    wall_bvh.add(&bottomWall);
+    wall_bvh.add(&leftWall);
+    wall_bvh.add(&rightWall);
+    for (auto* rw : pve_random_walls) if (rw) wall_bvh.add(rw);
+    wall_bvh.build();
+    SpatialHash dynamic_grid;
+    std::vector<uint32_t> nearby;
+    std::vector<ICollidable*> wall_candidates;
+    std::vector<std::pair<uint32_t, uint32_t>> bullet_pairs;
     AnimatedSprite pve_blackhole_anim(renderer, "assets/pictures/output.png", 200, 200, 12, 100, 3);
         while (in_game) {
+            FrameArena::instance().reset();
             SDL_Event e;
             while (SDL_PollEvent(&e)) {
                 if (e.type == SDL_QUIT) { in_game = false; break; }
                 if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_ESCAPE) { in_game = false; break; }
+                if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_p) profiler_overlay.toggle();
                 if (e.type == SDL_KEYDOWN && e.key.keysym.scancode == SDL_SCANCODE_E) {
-                    Vector2 pos(WORLD_W/2.0f - 32.0f, WORLD_H/2.0f - 32.0f);
-                    Smoke* s = new Smoke(renderer, "assets/pictures/khoi.png", pos, 24, 24, 8, 80, 3);
-                    smokes.push_back(s);
+                    particles.start(fx_smoke, Vector2(WORLD_W/2.0f - 32.0f, WORLD_H/2.0f - 32.0f));
                 }
                 // forward events to player input handler
-                ih_player.handle_event(e, bullets, rm);
+                ih_player.handle_event(e);
             }
-            Uint32 now = SDL_GetTicks();
-            float dt = (now - last) / 1000.0f; last = now;
-
-            // update
-            for (auto* u : updatables) u->update(dt);
-            for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->update(dt);
-            // Update PVE blackholes (local container)
-            for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->update(dt);
-            for (auto* b : bullets) b->update(dt);
-            for (auto* ex : explosions) ex->update(dt);
-            // Explosion collisions in PVE: characters/bullets
-            for (auto* ex : explosions) {
-                for (auto c : characters) if (c) c->collide(ex);
-                for (auto* bl : bullets) if (bl) ex->collide(bl);
-            }
-            for (auto* b : bloods) b->update(dt);
-            for (auto* s : smokes) s->update(dt);
-
-            // Rotate guns every gun_change_ms in PVE (toggle all characters, same as PVP)
-            if (SDL_GetTicks() - last_gun_change >= gun_change_ms) {
-                last_gun_change = SDL_GetTicks();
-                for (auto* c : characters) {
-                    if (!c) continue;
-                    GunType cur = c->get_gun_type();
-                    GunType next = GunType::PISTOL;
-                    if (cur == GunType::PISTOL) next = GunType::AK;
-                    else next = GunType::PISTOL;
-                    c->set_gun_type(next);
+            Uint64 now = SDL_GetPerformanceCounter();
+            double frame_seconds = (now - last) / counter_freq; last = now;
+
+            int steps = clock.advance(frame_seconds);
+            for (int s = 0; s < steps && in_game; ++s) {
+                const float dt = clock.step_dt();
+                pve_time_ms += dt * 1000.0;
+
+                {
+                    PROFILE_SCOPE("sim.update");
+                    // update (key presses since the last tick act first)
+                    ih_player.apply_actions(bullets);
+                    for (auto* u : registry.get_updatables()) u->update(dt);
+                    for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->update(dt);
+                    // Update PVE blackholes (local container)
+                    for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->update(dt);
+                    bullets.update(dt, &jobs);
+                    update_effects(jobs, explosions, dt);
+
+                    // rebuild the dynamic broadphase now that everything has moved this frame
+                    dynamic_grid.clear();
+                    for (size_t i = 0; i < bullets.size(); ++i) dynamic_grid.insert(nullptr, bullets.get_hitbox(i).get_bounds(), LAYER_BULLET, (uint32_t)i);
+                    for (auto* c : characters) if (c) dynamic_grid.insert(c, LAYER_CHARACTER);
                 }
-                notifications.push_back({ std::string("Guns switched!"), SDL_GetTicks() + 2500 });
-            }
 
-            // Buff spawn logic for PVE (every buff_interval_ms_pve)
-            if (SDL_GetTicks() - last_buff_spawn_pve >= buff_interval_ms_pve) {
-                // pick a random buff type (char buff or bullet buff) - reuse simple selection
-                std::variant<CharBuffType, BulletBuffType> bt;
-                // check if any player currently has a bullet buff
-                bool any_bullet_buff = false;
-                for (auto* c : characters) if (c) if (c->get_gun_buff_type() != BulletBuffType::NONE) { any_bullet_buff = true; break; }
-                std::uniform_int_distribution<int> chooseType(0, 1);
-                int kind = chooseType(rng_pve);
-                if (kind == 0) {
-                    std::uniform_int_distribution<int> chooseChar(0, (int)CharBuffType::NUM - 1);
-                    bt = static_cast<CharBuffType>(chooseChar(rng_pve));
-                } else {
-                    if (any_bullet_buff) {
-                        std::uniform_int_distribution<int> chooseChar(0, (int)CharBuffType::NUM - 1);
-                        bt = static_cast<CharBuffType>(chooseChar(rng_pve));
-                    } else {
-                        std::vector<BulletBuffType> bulletTypes = { BulletBuffType::BOUNCING, BulletBuffType::EXPLODING, BulletBuffType::PIERCING };
-                        std::uniform_int_distribution<int> chooseBullet(0, (int)bulletTypes.size() - 1);
-                        bt = bulletTypes[chooseBullet(rng_pve)];
+                {
+                    PROFILE_SCOPE("collide.explosions");
+                    // Explosion collisions in PVE: nearby characters/bullets
+                    for (auto* ex : explosions.get_active()) {
+                        dynamic_grid.query(SpatialHash::bounds_of(ex), LAYER_CHARACTER | LAYER_BULLET, nearby);
+                        for (uint32_t idx : nearby) {
+                            const SpatialHash::Entry& entry = dynamic_grid.get_entry(idx);
+                            if (entry.layer == LAYER_CHARACTER) entry.object->collide(ex);
+                            else bullets.collide(entry.id, ex);
+                        }
                     }
                 }
-                // pick a spawn position avoiding walls and players
-                Vector2 pos;
-                bool placed = false;
-                for (int attempt = 0; attempt < 30 && !placed; ++attempt) {
-                    pos = Vector2(wallX_pve(rng_pve), wallY_pve(rng_pve));
-                    OBB tmp_box(pos, Vector2(16.0f, 16.0f), 0.0f);
-                    bool intersects = false;
-                    for (auto* hb : topWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    for (auto* hb : bottomWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    for (auto* hb : leftWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    for (auto* hb : rightWall.get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                    if (intersects) continue;
-                    for (auto* rw : pve_random_walls) if (rw) {
-                        for (auto* hb : rw->get_hitboxes()) if (hb->is_collide(tmp_box)) { intersects = true; break; }
-                        if (intersects) break;
-                    }
-                    if (intersects) continue;
-                    // avoid players
-                    const float min_clear = 120.0f;
-                    for (auto* pc : characters) if (pc) {
-                        float dx = pc->get_position().x - pos.x;
-                        float dy = pc->get_position().y - pos.y;
-                        if (dx*dx + dy*dy < min_clear * min_clear) { intersects = true; break; }
+
+                // Rotate guns every gun_change_ms in PVE (toggle all characters, same as PVP)
+                if (pve_time_ms - last_gun_change >= gun_change_ms) {
+                    last_gun_change = pve_time_ms;
+                    for (auto* c : characters) {
+                        if (!c) continue;
+                        GunType cur = c->get_gun_type();
+                        GunType next = GunType::PISTOL;
+                        if (cur == GunType::PISTOL) next = GunType::AK;
+                        else next = GunType::PISTOL;
+                        c->set_gun_type(next);
                     }
-                    if (!intersects) placed = true;
+                    notifications.push_back({ std::string("Guns switched!"), SDL_GetTicks() + 2500 });
                 }
-                if (placed) {
-                    SDL_Texture* chosen_tex = nullptr;
-                    if (std::holds_alternative<CharBuffType>(bt)) {
-                        CharBuffType cb = std::get<CharBuffType>(bt);
-                        switch (cb) {
-                            case CharBuffType::HEALTH: chosen_tex = rm.get_texture("health-buff"); break;
-                            case CharBuffType::SPEED: chosen_tex = rm.get_texture("speed-buff"); break;
-                            default: chosen_tex = rm.get_texture("health-buff"); break;
+
+                {
+                    PROFILE_SCOPE("spawn.buffs");
+                    // Buff spawn logic for PVE (every buff_interval_ms_pve)
+                    if (pve_time_ms - last_buff_spawn_pve >= buff_interval_ms_pve) {
+                        // pick a random buff type (char buff or bullet buff) - reuse simple selection
+                        std::variant<CharBuffType, BulletBuffType> bt;
+                        // check if any player currently has a bullet buff
+                        bool any_bullet_buff = false;
+                        for (auto* c : characters) if (c) if (c->get_gun_buff_type() != BulletBuffType::NONE) { any_bullet_buff = true; break; }
+                        std::uniform_int_distribution<int> chooseType(0, 1);
+                        int kind = chooseType(rng_pve);
+                        if (kind == 0) {
+                            std::uniform_int_distribution<int> chooseChar(0, (int)CharBuffType::NUM - 1);
+                            bt = static_cast<CharBuffType>(chooseChar(rng_pve));
+                        } else {
+                            if (any_bullet_buff) {
+                                std::uniform_int_distribution<int> chooseChar(0, (int)CharBuffType::NUM - 1);
+                                bt = static_cast<CharBuffType>(chooseChar(rng_pve));
+                            } else {
+                                const BulletBuffType bulletTypes[] = { BulletBuffType::BOUNCING, BulletBuffType::EXPLODING, BulletBuffType::PIERCING };
+                                std::uniform_int_distribution<int> chooseBullet(0, (int)std::size(bulletTypes) - 1);
+                                bt = bulletTypes[chooseBullet(rng_pve)];
+                            }
                         }
-                    } else {
-                        BulletBuffType bb = std::get<BulletBuffType>(bt);
-                        switch (bb) {
-                            case BulletBuffType::BOUNCING: chosen_tex = rm.get_texture("bounce-buff"); break;
-                            case BulletBuffType::EXPLODING: chosen_tex = rm.get_texture("explode-buff"); break;
-                            case BulletBuffType::PIERCING: chosen_tex = rm.get_texture("piercing-buff"); break;
-                            default: chosen_tex = nullptr; break;
+                        // pick a spawn position avoiding walls and players
+                        Vector2 pos;
+                        bool placed = false;
+                        for (int attempt = 0; attempt < 30 && !placed; ++attempt) {
+                            if (!arena || !Arena::sample_zone(arena->get_buff_zones(), rng_pve, pos))
+                                pos = Vector2(wallX_pve(rng_pve), wallY_pve(rng_pve));
+                            OBB tmp_box(pos, Vector2(16.0f, 16.0f), 0.0f);
+                            wall_bvh.query_obb(tmp_box, nearby);
+                            if (!nearby.empty()) continue;
+                            bool intersects = false;
+                            // avoid players
+                            const float min_clear = 120.0f;
+                            for (auto* pc : characters) if (pc) {
+                                float dx = pc->get_position().x - pos.x;
+                                float dy = pc->get_position().y - pos.y;
+                                if (dx*dx + dy*dy < min_clear * min_clear) { intersects = true; break; }
+                            }
+                            if (!intersects) placed = true;
                         }
+                        if (placed) {
+                            TextureRegion chosen_tex;
+                            if (std::holds_alternative<CharBuffType>(bt)) {
+                                CharBuffType cb = std::get<CharBuffType>(bt);
+                                switch (cb) {
+                                    case CharBuffType::HEALTH: chosen_tex = rm.get_texture("health-buff"); break;
+                                    case CharBuffType::SPEED: chosen_tex = rm.get_texture("speed-buff"); break;
+                                    default: chosen_tex = rm.get_texture("health-buff"); break;
+                                }
+                            } else {
+                                BulletBuffType bb = std::get<BulletBuffType>(bt);
+                                switch (bb) {
+                                    case BulletBuffType::BOUNCING: chosen_tex = rm.get_texture("bounce-buff"); break;
+                                    case BulletBuffType::EXPLODING: chosen_tex = rm.get_texture("explode-buff"); break;
+                                    case BulletBuffType::PIERCING: chosen_tex = rm.get_texture("piercing-buff"); break;
+                                    default: break;
+                                }
+                            }
+                            // fallback: an orange square if the resource is missing
+                            if (!chosen_tex) chosen_tex = rm.add_solid("buff-fallback", 32, 32, { 200, 100, 0, 255 });
+                            BuffItem* bi = new BuffItem(pos, chosen_tex, bt);
+                            registry.spawn(bi, EntityKind::BUFF, true);
+                        }
+                        last_buff_spawn_pve = pve_time_ms;
                     }
-                    SDL_Texture* btex = chosen_tex;
-                    if (!btex) {
-                        SDL_Surface* bs = SDL_CreateRGBSurface(0, 32, 32, 32, 0x00FF0000,0x0000FF00,0x000000FF,0xFF000000);
-                        SDL_FillRect(bs, NULL, SDL_MapRGBA(bs->format, 200, 100, 0, 255));
-                        btex = SDL_CreateTextureFromSurface(renderer, bs);
-                        SDL_FreeSurface(bs);
-                    }
-                    BuffItem* bi = new BuffItem(pos, btex, bt);
-                    buffs.push_back(bi);
-                    updatables.push_back(bi);
                 }
-                last_buff_spawn_pve = SDL_GetTicks();
-            }
 
-            // PVE Blackhole spawn & lifetime logic (mirrors PVP)
-            
-            Uint32 now_pve_bh = SDL_GetTicks();
-            if (now_pve_bh - pve_start_time >= pve_blackhole_precaution_ms) {
-                if (pve_last_bh_spawn == 0 || now_pve_bh - pve_last_bh_spawn >= pve_blackhole_interval_ms) {
-                    bool ok = false; int attempts = 0; Vector2 p;
-                    while (!ok && attempts < 20) {
-                        p.x = pve_distX(pve_rng_bh);
-                        p.y = pve_distY(pve_rng_bh);
-                        ok = true;
-                        for (auto* c : characters) {
-                            float dx = c->get_position().x - p.x;
-                            float dy = c->get_position().y - p.y;
-                            if (dx*dx + dy*dy < 200.0f * 200.0f) { ok = false; break; }
+                {
+                    PROFILE_SCOPE("spawn.blackholes");
+                    // PVE Blackhole spawn & lifetime logic (mirrors PVP)
+                
+                    double now_pve_bh = pve_time_ms;
+                    if (now_pve_bh >= pve_blackhole_precaution_ms) {
+                        if (pve_last_bh_spawn < 0.0 || now_pve_bh - pve_last_bh_spawn >= pve_blackhole_interval_ms) {
+                            bool ok = false; int attempts = 0; Vector2 p;
+                            while (!ok && attempts < 20) {
+                                if (!arena || !Arena::sample_zone(arena->get_blackhole_zones(), pve_rng_bh, p)) {
+                                    p.x = pve_distX(pve_rng_bh);
+                                    p.y = pve_distY(pve_rng_bh);
+                                }
+                                ok = true;
+                                for (auto* c : characters) {
+                                    float dx = c->get_position().x - p.x;
+                                    float dy = c->get_position().y - p.y;
+                                    if (dx*dx + dy*dy < 200.0f * 200.0f) { ok = false; break; }
+                                }
+                                attempts++;
+                            }
+                            if (ok) {
+                                BlackHole* nb = new BlackHole(p, nullptr, 65.0f, 30.0f, 5.0f, 15.0f);
+                            
+                                nb->set_animation(&pve_blackhole_anim);
+                                pve_blackholes_local.emplace_back(nb, now_pve_bh);
+                            }
+                            pve_last_bh_spawn = now_pve_bh;
                         }
-                        attempts++;
-                    }
-                    if (ok) {
-                        BlackHole* nb = new BlackHole(p, nullptr, 65.0f, 30.0f, 5.0f, 15.0f);
-                        
-                        nb->set_animation(&pve_blackhole_anim);
-                        pve_blackholes_local.emplace_back(nb, now_pve_bh);
                     }
-                    pve_last_bh_spawn = now_pve_bh;
-                }
-            }
 
-            // Remove expired PVE blackholes
-            for (auto& bhp : pve_blackholes_local) {
-                if (bhp.first && now_pve_bh - bhp.second >= pve_blackhole_life_ms) {
-                    delete bhp.first;
-                    bhp.first = nullptr;
+                    // Remove expired PVE blackholes
+                    for (auto& bhp : pve_blackholes_local) {
+                        if (bhp.first && now_pve_bh - bhp.second >= pve_blackhole_life_ms) {
+                            delete bhp.first;
+                            bhp.first = nullptr;
+                        }
+                    }
+                    pve_blackholes_local.erase(std::remove_if(pve_blackholes_local.begin(), pve_blackholes_local.end(), [](const std::pair<BlackHole*,double>& p){ return p.first == nullptr; }), pve_blackholes_local.end());
                 }
-            }
-            pve_blackholes_local.erase(std::remove_if(pve_blackholes_local.begin(), pve_blackholes_local.end(), [](const std::pair<BlackHole*,Uint32>& p){ return p.first == nullptr; }), pve_blackholes_local.end());
 
-            // let characters pick up buffs
-            for (auto* c : characters) if (c) for (auto* bi : buffs) if (bi) c->collide(bi);
-            // remove consumed buffs
-            {
-                auto it = buffs.begin();
-                while (it != buffs.end()) {
-                    BuffItem* bi = *it;
-                    if (bi->is_consumed()) {
+                {
+                    PROFILE_SCOPE("cleanup.buffs");
+                    // let characters pick up buffs
+                    for (auto* c : characters) if (c) for (auto* bi : buffs) if (bi) c->collide(bi);
+                    // despawn consumed buffs (the registry owns and deletes them at the end of the tick)
+                    for (size_t i = 0; i < buffs.size(); ++i) {
+                        BuffItem* bi = buffs[i];
+                        if (!bi->is_consumed() || !registry.despawn(registry.handle_at(EntityKind::BUFF, i))) continue;
                         // If the consumed buff was a BulletBuff, clear bullet buffs from other characters
                         auto btype = bi->get_buff_type();
                         if (std::holds_alternative<BulletBuffType>(btype)) {
@@ -1489,147 +1348,152 @@ int main (int argc, char *argv[]) {
                                 }
                             }
                         }
-                        updatables.erase(std::remove(updatables.begin(), updatables.end(), static_cast<IUpdatable*>(bi)), updatables.end());
-                        delete bi;
-                        it = buffs.erase(it);
-                    } else ++it;
+                    }
                 }
-            }
 
-            // detect damage and deaths in PVE: spawn blood on hit, smoke on death, remove dead
-            std::vector<Character*> pve_just_died;
-            for (auto c : characters) {
-                if (!c) continue;
-                float old_h = prev_health[c];
-                float new_h = c->get_health();
-                if (new_h < old_h && new_h > 0.0f) {
-                    Vector2 bpos = c->get_position();
-                    BloodSplash* bs = new BloodSplash(renderer, std::string("assets/pictures/blood.png"), bpos, 24, 24, 8, 80, 3);
-                    bloods.push_back(bs);
-                }
-                if (old_h > 0.0f && new_h <= 0.0f) {
-                    Vector2 spos = c->get_position();
-                    Smoke* s = new Smoke(renderer, "assets/pictures/khoi.png", spos, 24, 24, 8, 80, 3);
-                    smokes.push_back(s);
-                    SDL_Log("PVE Spawned Smoke at %.1f, %.1f", spos.x, spos.y);
-                    pve_just_died.push_back(c);
-                    ih_player.on_character_death(c);
-                }
-                prev_health[c] = new_h;
-            }
-            if (!pve_just_died.empty()) {
-                bool ai_died = false;
-                for (auto d : pve_just_died) {
-                    if (d == &p3) ai_died = true;
-                    characters.erase(std::remove(characters.begin(), characters.end(), d), characters.end());
-                    updatables.erase(std::remove(updatables.begin(), updatables.end(), static_cast<IUpdatable*>(d)), updatables.end());
-                    prev_health.erase(d);
+                {
+                    PROFILE_SCOPE("sim.deaths");
+                    // detect damage and deaths in PVE: spawn blood on hit, smoke on death, remove dead
+                    std::pmr::vector<Character*> pve_just_died(FrameArena::get());
+                    for (size_t i = 0; i < characters.size(); ++i) {
+                        Character* c = characters[i];
+                        EntityHandle handle = registry.handle_at(EntityKind::CHARACTER, i);
+                        if (!registry.is_alive(handle)) continue;
+                        if (handle.index >= prev_health.size()) {
+                            // spawned into a slot past the setup-time size: grow with the registry, start from its current health
+                            prev_health.resize(registry.get_slot_count(), 0.0f);
+                            prev_health[handle.index] = c->get_health();
+                        }
+                        float old_h = prev_health[handle.index];
+                        float new_h = c->get_health();
+                        if (new_h < old_h && new_h > 0.0f) {
+                            particles.start(fx_blood, c->get_position());
+                        }
+                        if (old_h > 0.0f && new_h <= 0.0f) {
+                            Vector2 spos = c->get_position();
+                            particles.start(fx_smoke, spos);
+                            SDL_Log("PVE Spawned Smoke at %.1f, %.1f", spos.x, spos.y);
+                            pve_just_died.push_back(c);
+                            ih_player.on_character_death(c);
+                            registry.despawn(handle);
+                        }
+                        prev_health[handle.index] = new_h;
+                    }
+                    if (!pve_just_died.empty()) {
+                        bool ai_died = false;
+                        for (auto d : pve_just_died) {
+                            if (d == &p3) ai_died = true;
+                        }
+                        // End the PVE match when any character dies. Notify the player of win/lose.
+                        if (ai_died) {
+                            notifications.push_back({ std::string("You win"), SDL_GetTicks() + 3000 });
+                            pve_result = 1;
+                        } else {
+                            notifications.push_back({ std::string("You lose"), SDL_GetTicks() + 3000 });
+                            pve_result = -1;
+                        }
+                        in_game = false;
+                    }
                 }
-                // End the PVE match when any character dies. Notify the player of win/lose.
-                if (ai_died) {
-                    notifications.push_back({ std::string("You win"), SDL_GetTicks() + 3000 });
-                    pve_result = 1;
-                } else {
-                    notifications.push_back({ std::string("You lose"), SDL_GetTicks() + 3000 });
-                    pve_result = -1;
+
+                {
+                    PROFILE_SCOPE("cleanup.explosions");
+                    // finished explosions go back to the pool
+                    explosions.release_finished();
                 }
-                in_game = false;
-            }
 
-            // cleanup finished explosions
-            explosions.erase(std::remove_if(explosions.begin(), explosions.end(), [](Explosion* ex){ if (ex->is_finished()) { delete ex; return true; } return false; }), explosions.end());
-            // cleanup finished bloods
-            bloods.erase(std::remove_if(bloods.begin(), bloods.end(), [](BloodSplash* b){ if (b->is_finished()) { delete b; return true; } return false; }), bloods.end());
-            // cleanup finished smokes
-            smokes.erase(std::remove_if(smokes.begin(), smokes.end(), [](Smoke* s){ if (s->is_finished()) { delete s; return true; } return false; }), smokes.end());
-
-            // collisions: bullets vs blackholes/characters/walls
-            for (auto* b : bullets) {
-                if (!b) continue;
-                // blackholes first
-                for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->collide(b);
-                // PVE blackholes collide with bullets
-                for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->collide(b);
-                if (b->is_destroyed()) continue;
-                // Characters absorb bullet collisions
-                for (auto* ch : characters) if (ch) ch->collide(b);
-                topWall.collide(b); if (b->is_destroyed()) continue;
-                bottomWall.collide(b); if (b->is_destroyed()) continue;
-                leftWall.collide(b); if (b->is_destroyed()) continue;
-                rightWall.collide(b); if (b->is_destroyed()) continue;
-                for (auto* rw : pve_random_walls) if (rw) { rw->collide(b); if (b->is_destroyed()) break; }
-            }
-            // bullet vs bullet collisions in PVE: bullets from different teams (if any) destroy each other
-            for (size_t i = 0; i < bullets.size(); ++i) {
-                Bullet* a = bullets[i];
-                if (!a || a->is_destroyed()) continue;
-                for (size_t j = i + 1; j < bullets.size(); ++j) {
-                    Bullet* b = bullets[j];
-                    if (!b || b->is_destroyed()) continue;
-                    if (a->get_team_id() == b->get_team_id()) continue;
-                    bool collided = false;
-                    for (auto* ah : a->get_hitboxes()) {
-                        for (auto* bh : b->get_hitboxes()) {
-                            if (ah->is_collide(*bh)) { collided = true; break; }
+                {
+                    PROFILE_SCOPE("collide.bullets");
+                    // collisions: bullets vs blackholes/characters/walls
+                    for (size_t i = 0; i < bullets.size(); ++i) {
+                        // blackholes first
+                        for (auto& bhp : pve_blackholes_local) if (bhp.first) bullets.collide(i, bhp.first);
+                        // PVE blackholes collide with bullets
+                        for (auto& bhp : pve_blackholes_local) if (bhp.first) bullets.collide(i, bhp.first);
+                        if (bullets.is_destroyed(i)) continue;
+                        AABB bb = bullets.get_hitbox(i).get_bounds();
+                        // Characters absorb bullet collisions
+                        dynamic_grid.query(bb, LAYER_CHARACTER, nearby);
+                        for (uint32_t idx : nearby) {
+                            Character* ch = static_cast<Character*>(dynamic_grid.get_entry(idx).object);
+                            if (!ch->is_dead()) bullets.collide(i, ch);
                         }
-                        if (collided) break;
+                        if (bullets.is_destroyed(i)) continue;
+                        // swept against walls along the whole path of this tick
+                        wall_bvh.query(bullets.get_swept_bounds(i), nearby);
+                        wall_candidates.clear();
+                        for (uint32_t idx : nearby) wall_candidates.push_back(wall_bvh.get_item(idx).object);
+                        bullets.collide_walls(i, wall_candidates);
                     }
-                    if (collided) {
-                        a->set_destroyed(true);
-                        b->set_destroyed(true);
+                    // bullet vs bullet collisions in PVE: bullets from different teams (if any) destroy each other
+                    dynamic_grid.query_pairs(LAYER_BULLET, LAYER_BULLET, bullet_pairs, &jobs);
+                    for (auto& pr : bullet_pairs) {
+                        bullets.collide_bullets(dynamic_grid.get_entry(pr.first).id, dynamic_grid.get_entry(pr.second).id);
                     }
+                    // remove destroyed bullets
+                    bullets.flush_destroyed(explosions);
                 }
-            }
-            // remove destroyed bullets
-            bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [&](Bullet* bullet){
-                if (!bullet) return true;
-                if (bullet->is_destroyed()) {
-                    if (bullet->getBuff() == BulletBuffType::EXPLODING) {
-                        bullet->explode(explosions, renderer);
+
+                {
+                    PROFILE_SCOPE("collide.characters");
+                    // Ensure characters collide with boundary walls, blackholes and random internal walls so they cannot pass through
+                    for (auto* c : characters) {
+                        if (!c) continue;
+                        wall_bvh.query(SpatialHash::bounds_of(c), nearby);
+                        for (uint32_t idx : nearby) wall_bvh.get_item(idx).object->collide(c);
+                        for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->collide(c);
+                        // PVE blackholes collide with characters
+                        for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->collide(c);
                     }
-                    delete bullet;
-                    return true;
                 }
-                return false;
-            }), bullets.end());
-
-            // Ensure characters collide with boundary walls, blackholes and random internal walls so they cannot pass through
-            for (auto* c : characters) {
-                if (!c) continue;
-                topWall.collide(c);
-                bottomWall.collide(c);
-                leftWall.collide(c);
-                rightWall.collide(c);
-                for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->collide(c);
-                // PVE blackholes collide with characters
-                for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->collide(c);
-                for (auto* rw : pve_random_walls) if (rw) rw->collide(c);
+
+                // dead characters and consumed buffs leave the lists only now, after every system ran
+                registry.flush();
             }
+            // particles are visual only: once per rendered frame, like PVP
+            {
+                PROFILE_SCOPE("effects.update");
+                particles.update((float)frame_seconds, &jobs);
+            }
+            const float alpha = clock.alpha();
 
             // render
-            SDL_SetRenderDrawColor(renderer, 0,0,0,255);
-            SDL_RenderClear(renderer);
-            // draw battlefield background (if available)
-            SDL_Texture* bgtex = rm.get_texture("background");
-            if (bgtex) {
-                SDL_Rect dst = { 0, 0, WORLD_W, WORLD_H };
-                SDL_RenderCopy(renderer, bgtex, NULL, &dst);
+            {
+                PROFILE_SCOPE("render.world");
+                SDL_SetRenderDrawColor(renderer, 0,0,0,255);
+                SDL_RenderClear(renderer);
+                // draw battlefield background (if available)
+                SDL_Texture* bgtex = rm.get_texture("background").texture;
+                if (bgtex) {
+                    SDL_Rect dst = { 0, 0, WORLD_W, WORLD_H };
+                    SDL_RenderCopy(renderer, bgtex, NULL, &dst);
+                }
+                SDL_Rect worldRect = {0,0,WORLD_W,WORLD_H};
+                SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
+                SDL_RenderDrawRect(renderer, &worldRect);
+                batch.set_layer(SpriteLayer::WALLS);
+                topWall.render(batch); bottomWall.render(batch); leftWall.render(batch); rightWall.render(batch);
+                for (auto* rw : pve_random_walls) if (rw) rw->render(batch);
+                batch.set_layer(SpriteLayer::CHARACTERS);
+                for (auto* ch : characters) if (ch) ch->render(batch, alpha);
+                batch.set_layer(SpriteLayer::BULLETS);
+                bullets.render(batch, rm.get_texture("bullet"), alpha);
+                batch.set_layer(SpriteLayer::EXPLOSIONS);
+                for (auto* ex : explosions.get_active()) ex->render(batch);
+                batch.set_layer(SpriteLayer::BUFFS);
+                for (auto* bi : buffs) if (bi) bi->render(batch);
+                particles.render(batch);
+                batch.set_layer(SpriteLayer::BLACKHOLES);
+                for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->render(batch);
+                for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->render(batch);
+                batch.flush();
+                for (Wall* w : { &topWall, &bottomWall, &leftWall, &rightWall }) for (auto* hb : w->get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
+                for (auto* rw : pve_random_walls) if (rw) for (auto* hb : rw->get_hitboxes()) hb->debug_draw(renderer, {0,255,0,255});
+                for (auto* ch : characters) if (ch) ch->render_overlay(renderer, alpha);
             }
-            SDL_Rect worldRect = {0,0,WORLD_W,WORLD_H};
-            SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
-            SDL_RenderDrawRect(renderer, &worldRect);
-            topWall.render(renderer); bottomWall.render(renderer); leftWall.render(renderer); rightWall.render(renderer);
-            for (auto* rw : pve_random_walls) if (rw) rw->render(renderer);
-            for (auto* ch : characters) if (ch) ch->render(renderer);
-            for (auto* b : bullets) b->render(renderer);
-            for (auto* ex : explosions) { ex->render(renderer); }
-            for (auto* bi : buffs) if (bi) bi->render(renderer);
-            for (auto* bl : bloods) bl->render(renderer);
-            for (auto* s : smokes) s->render(renderer);
-            for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->render(renderer);
-            for (auto& bhp : pve_blackholes_local) if (bhp.first) bhp.first->render(renderer);
             // simple HUD for PVE: show player health + bullet buff icon
-            if (font) {
+            if (text) {
+                PROFILE_SCOPE("render.hud");
                 SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
                 // render notifications (centered on screen)
                 int validCount = 0;
@@ -1639,14 +1503,7 @@ int main (int argc, char *argv[]) {
                 for (auto it = notifications.begin(); it != notifications.end();) {
                     if ((int)it->text.size() == 0 || SDL_GetTicks() > it->expiry) { it = notifications.erase(it); continue; }
                     SDL_Color textColor = { 255, 220, 120, 255 };
-                    SDL_Surface* t = TTF_RenderText_Blended(font, it->text.c_str(), textColor);
-                    if (t) {
-                        SDL_Texture* tt = SDL_CreateTextureFromSurface(renderer, t);
-                        int tw = t->w, th = t->h;
-                        SDL_Rect td = { WORLD_W/2 - tw/2, notifY, tw, th };
-                        SDL_FreeSurface(t);
-                        if (tt) { SDL_RenderCopy(renderer, tt, NULL, &td); SDL_DestroyTexture(tt); }
-                    }
+                    text->draw(it->text, WORLD_W/2 - text->measure(it->text)/2, notifY, textColor);
                     notifY += lineH;
                     ++it;
                 }
@@ -1673,19 +1530,6 @@ int main (int argc, char *argv[]) {
                 SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
                 SDL_RenderFillRect(renderer, &panelRightBg);
 
-                // helper: ellipsize to pixel width
-                auto ellipsize = [&](const std::string &full, int maxW) {
-                    std::string s = full;
-                    int w = 0, h = 0;
-                    if (TTF_SizeText(font, s.c_str(), &w, &h) == 0 && w <= maxW) return s;
-                    while (!s.empty()) {
-                        s = s.substr(0, s.size() - 1);
-                        std::string t = s + "...";
-                        if (TTF_SizeText(font, t.c_str(), &w, &h) == 0 && w <= maxW) return t;
-                    }
-                    return std::string("...");
-                };
-
                 // left column entries
                 for (int idx = 0; idx < left_count; ++idx) {
                     int i = idx;
@@ -1702,21 +1546,16 @@ int main (int argc, char *argv[]) {
                     if (i < 2) SDL_SetRenderDrawColor(renderer, 200, 60, 60, 255); else SDL_SetRenderDrawColor(renderer, 80, 120, 220, 255);
                     SDL_RenderFillRect(renderer, &sw);
 
-                    std::string basename = (i==0?"player1_1":(i==1?"player1_2":(i==2?"player2_1":(i==3?"player2_2":"player"+std::to_string(i+1)))));
+                    char basename[32]; // "player" + two full ints + '_' + NUL
+                    if (i < 4) std::snprintf(basename, sizeof(basename), "player%d_%d", i / 2 + 1, i % 2 + 1);
+                    else std::snprintf(basename, sizeof(basename), "player%d", i + 1);
                     GunType gt = ch->get_gun_type();
-                    std::string fullName = basename + (gt == GunType::AK ? " AK" : " PIS");
+                    std::pmr::string fullName(basename, FrameArena::get());
+                    fullName += gt == GunType::AK ? " AK" : " PIS";
                     int maxTextW = panelW - 28 - 48;
-                    std::string nameToRender = ellipsize(fullName, maxTextW);
                     SDL_Color textColor = { 230, 230, 230, 255 };
-                    int textH = 0;
-                    SDL_Surface* textSurf = TTF_RenderText_Blended(font, nameToRender.c_str(), textColor);
-                    if (textSurf) {
-                        textH = textSurf->h;
-                        SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                        SDL_Rect dst = { x + 28, y + 10, textSurf->w, textH };
-                        SDL_FreeSurface(textSurf);
-                        if (textTex) { SDL_RenderCopy(renderer, textTex, NULL, &dst); SDL_DestroyTexture(textTex); }
-                    }
+                    text->draw(fullName, x + 28, y + 10, textColor, maxTextW);
+                    int textH = text->line_height();
 
                     float hp = std::max(0.0f, ch->get_health());
                     float hpfrac = std::min(1.0f, hp / 100.0f);
@@ -1730,25 +1569,25 @@ int main (int argc, char *argv[]) {
 
                     int ix = x + panelW - 28;
                     int iconY = y + 10;
-                    auto cbs = ch->get_active_char_buffs();
+                    auto cbs = ch->get_active_char_buffs(FrameArena::get());
                     for (auto cb : cbs) {
-                        SDL_Texture* cbtex = nullptr;
+                        TextureRegion cbtex;
                         switch (cb) {
                             case CharBuffType::HEALTH: cbtex = rm.get_texture("health-buff"); break;
                             case CharBuffType::SPEED: cbtex = rm.get_texture("speed-buff"); break;
                             default: break;
                         }
-                        if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex, NULL, &cbdst); ix -= 20 + 6; }
+                        if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex.texture, cbtex.get_src(), &cbdst); ix -= 20 + 6; }
                     }
                     BulletBuffType bb = ch->get_active_bullet_buff();
-                    SDL_Texture* btex = nullptr;
+                    TextureRegion btex;
                     switch (bb) {
                         case BulletBuffType::BOUNCING: btex = rm.get_texture("bounce-buff"); break;
                         case BulletBuffType::EXPLODING: btex = rm.get_texture("explode-buff"); break;
                         case BulletBuffType::PIERCING: btex = rm.get_texture("piercing-buff"); break;
                         default: break;
                     }
-                    if (btex) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex, NULL, &bdst); ix -= 20 + 6; }
+                    if (btex) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex.texture, btex.get_src(), &bdst); ix -= 20 + 6; }
                 }
 
                 // right column entries
@@ -1767,21 +1606,16 @@ int main (int argc, char *argv[]) {
                     if (i < 2) SDL_SetRenderDrawColor(renderer, 200, 60, 60, 255); else SDL_SetRenderDrawColor(renderer, 80, 120, 220, 255);
                     SDL_RenderFillRect(renderer, &sw);
 
-                    std::string basename = (i==0?"player1_1":(i==1?"player1_2":(i==2?"player2_1":(i==3?"player2_2":"player"+std::to_string(i+1)))));
+                    char basename[32]; // "player" + two full ints + '_' + NUL
+                    if (i < 4) std::snprintf(basename, sizeof(basename), "player%d_%d", i / 2 + 1, i % 2 + 1);
+                    else std::snprintf(basename, sizeof(basename), "player%d", i + 1);
                     GunType gt = ch->get_gun_type();
-                    std::string fullName = basename + (gt == GunType::AK ? " AK" : " PIS");
+                    std::pmr::string fullName(basename, FrameArena::get());
+                    fullName += gt == GunType::AK ? " AK" : " PIS";
                     int maxTextW = panelW - 28 - 48;
-                    std::string nameToRender = ellipsize(fullName, maxTextW);
                     SDL_Color textColor = { 230, 230, 230, 255 };
-                    int textH = 0;
-                    SDL_Surface* textSurf = TTF_RenderText_Blended(font, nameToRender.c_str(), textColor);
-                    if (textSurf) {
-                        textH = textSurf->h;
-                        SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                        SDL_Rect dst = { x + 28, y + 10, textSurf->w, textH };
-                        SDL_FreeSurface(textSurf);
-                        if (textTex) { SDL_RenderCopy(renderer, textTex, NULL, &dst); SDL_DestroyTexture(textTex); }
-                    }
+                    text->draw(fullName, x + 28, y + 10, textColor, maxTextW);
+                    int textH = text->line_height();
 
                     float hp = std::max(0.0f, ch->get_health());
                     float hpfrac = std::min(1.0f, hp / 100.0f);
@@ -1795,29 +1629,33 @@ int main (int argc, char *argv[]) {
 
                     int ix = x + panelW - 28;
                     int iconY = y + 10;
-                    auto cbs2 = ch->get_active_char_buffs();
+                    auto cbs2 = ch->get_active_char_buffs(FrameArena::get());
                     for (auto cb : cbs2) {
-                        SDL_Texture* cbtex = nullptr;
+                        TextureRegion cbtex;
                         switch (cb) {
                             case CharBuffType::HEALTH: cbtex = rm.get_texture("health-buff"); break;
                             case CharBuffType::SPEED: cbtex = rm.get_texture("speed-buff"); break;
                             default: break;
                         }
-                        if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex, NULL, &cbdst); ix -= 20 + 6; }
+                        if (cbtex) { SDL_Rect cbdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, cbtex.texture, cbtex.get_src(), &cbdst); ix -= 20 + 6; }
                     }
                     BulletBuffType bb2 = ch->get_active_bullet_buff();
-                    SDL_Texture* btex2 = nullptr;
+                    TextureRegion btex2;
                     switch (bb2) {
                         case BulletBuffType::BOUNCING: btex2 = rm.get_texture("bounce-buff"); break;
                         case BulletBuffType::EXPLODING: btex2 = rm.get_texture("explode-buff"); break;
                         case BulletBuffType::PIERCING: btex2 = rm.get_texture("piercing-buff"); break;
                         default: break;
                     }
-                    if (btex2) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex2, NULL, &bdst); ix -= 20 + 6; }
+                    if (btex2) { SDL_Rect bdst = { ix - 20 + 1, iconY, 20, 20 }; SDL_RenderCopy(renderer, btex2.texture, btex2.get_src(), &bdst); ix -= 20 + 6; }
                 }
             }
-            SDL_RenderPresent(renderer);
-            SDL_Delay(16);
+            profiler_overlay.render(renderer, text, WORLD_W/2 - 230, 12);
+            {
+                PROFILE_SCOPE("render.present");
+                SDL_RenderPresent(renderer);
+            }
+            Profiler::instance().end_frame();
         }
 
         SDL_RenderSetLogicalSize(renderer, WINDOW_W, WINDOW_H);
@@ -1834,42 +1672,74 @@ int main (int argc, char *argv[]) {
                 SDL_RenderClear(renderer);
                 SDL_Color hl = { 255, 200, 60, 255 };
                 SDL_Color textColor = { 30, 30, 30, 255 };
-                if (font) {
-                    SDL_Surface* surf = TTF_RenderText_Blended(font, msg.c_str(), textColor);
-                    if (surf) {
-                        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-                        int tw = surf->w, th = surf->h;
-                        SDL_FreeSurface(surf);
-                        SDL_Rect box = { WORLD_W/2 - (tw+40)/2, WORLD_H/2 - (th+30)/2, tw+40, th+30 };
-                        SDL_SetRenderDrawColor(renderer, hl.r, hl.g, hl.b, hl.a);
-                        SDL_RenderFillRect(renderer, &box);
-                        if (tex) {
-                            SDL_Rect dst = { box.x + 20, box.y + 12, tw, th };
-                            SDL_RenderCopy(renderer, tex, NULL, &dst);
-                            SDL_DestroyTexture(tex);
-                        }
-                    }
+                if (text) {
+                    int tw = text->measure(msg), th = text->line_height();
+                    SDL_Rect box = { WORLD_W/2 - (tw+40)/2, WORLD_H/2 - (th+30)/2, tw+40, th+30 };
+                    SDL_SetRenderDrawColor(renderer, hl.r, hl.g, hl.b, hl.a);
+                    SDL_RenderFillRect(renderer, &box);
+                    text->draw(msg, box.x + 20, box.y + 12, textColor);
                 }
                 SDL_RenderPresent(renderer);
                 SDL_Delay(16);
             }
         }
-        SDL_DestroyTexture(green_texture);
-        SDL_DestroyTexture(red_texture);
-        SDL_DestroyTexture(wall_tex_h);
-        SDL_DestroyTexture(wall_tex_v);
         // cleanup random walls created for PVE
         for (auto* rw : pve_random_walls) if (rw) delete rw;
         pve_random_walls.clear();
     // cleanup blackholes (PVE)
     for (auto& bhp : pve_blackholes_local) if (bhp.first) delete bhp.first;
     pve_blackholes_local.clear();
-        rm.unload_all();
+    };
+
+    // Images both stages load up front. Picking a mode streams them in (decode
+    // on background threads, upload a few ms per frame) while the menu keeps
+    // drawing a progress bar; the stage's own load calls then only look them up.
+    auto queue_stage_assets = [&](AssetLoader& loader) {
+        loader.queue_texture("background", "assets/pictures/background.png");
+        loader.queue_sprite("bullet", "assets/pictures/bulletA.png");
+        loader.queue_sprite("health-buff", "assets/pictures/health-buff.png");
+        loader.queue_sprite("speed-buff", "assets/pictures/speed-buff.png");
+        loader.queue_sprite("bounce-buff", "assets/pictures/bounce-buff.png");
+        loader.queue_sprite("explode-buff", "assets/pictures/explosion-buff.png");
+        loader.queue_sprite("piercing-buff", "assets/pictures/piercing-buff.png");
+        for (const char* sheet : { "assets/pictures/PlayerIdle.png", "assets/pictures/PlayerRunning.png",
+                                   "assets/pictures/PlayerShooting.png", "assets/pictures/tocvangdung.png",
+                                   "assets/pictures/tocvangchay.png", "assets/pictures/tocvangban.png",
+                                   "assets/pictures/output.png", EXPLOSION_TEXTURE_PATH }) {
+            loader.queue_sheet(sheet);
+        }
+    };
+
+    // Stage being loaded from the menu. A resource scope opens with the loader and
+    // closes when the stage returns (or loading is cancelled): the stage's
+    // textures are referenced while it runs and only cached afterwards, so the
+    // next match queues nothing the last one already uploaded.
+    std::string stage_mode;
+    std::unique_ptr<AssetLoader> stage_loader;
+    auto start_stage = [&](const std::string& mode) {
+        if (stage_loader) return; // already loading one
+        stage_mode = mode;
+        resourceManager.begin_scope();
+        stage_loader = std::make_unique<AssetLoader>(renderer, resourceManager);
+        queue_stage_assets(*stage_loader);
+    };
+    auto select_option = [&](const std::string& option) {
+        if (option == "Exit") running = false;
+        else if (option == "PVP" || option == "PVE") start_stage(option);
+        else run_placeholder_game(option);
     };
 
     // Show system cursor for menu interactivity
     SDL_ShowCursor(SDL_ENABLE);
 
+    // --replay: straight into the recorded match, no menu
+    if (replay_path) {
+        ResourceManager::Scope stage_scope(resourceManager);
+        run_pvp_game(resourceManager);
+        running = false;
+    }
+
+    bool menu_shown = false; // first menu frame: report time-to-menu once
     while (running) {
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) {
@@ -1893,14 +1763,13 @@ int main (int argc, char *argv[]) {
                         break;
                     case SDL_SCANCODE_RETURN:
                     case SDL_SCANCODE_KP_ENTER:
-                        if (options[selected] == "Exit") {
-                            running = false;
-                        } else if (options[selected] == "PVP") {
-                            run_pvp_game();
-                        } else if (options[selected] == "PVE") {
-                            run_pve_game();
-                        } else {
-                            run_placeholder_game(options[selected]);
+                        select_option(options[selected]);
+                        break;
+                    case SDL_SCANCODE_ESCAPE:
+                        // cancel a stage that is still loading; what already arrived stays cached
+                        if (stage_loader) {
+                            stage_loader.reset();
+                            resourceManager.end_scope();
                         }
                         break;
                     default:
@@ -1921,23 +1790,24 @@ int main (int argc, char *argv[]) {
                     SDL_Rect opt = { WINDOW_W/2 - 100, baseY + (int)i * 70, 200, 50 };
                     if (mx >= opt.x && mx <= opt.x + opt.w && my >= opt.y && my <= opt.y + opt.h) {
                         selected = (int)i;
-                        if (clicked) {
-                            if (options[selected] == "Exit") {
-                                running = false;
-                            } else if (options[selected] == "PVP") {
-                                run_pvp_game();
-                            } else if (options[selected] == "PVE") {
-                                run_pve_game();
-                            } else {
-                                run_placeholder_game(options[selected]);
-                            }
-                        }
+                        if (clicked) select_option(options[selected]);
                         break;
                     }
                 }
             }
         }
 
+        // Streaming a stage in: upload what the decoders have finished, enter the stage once all of it is there
+        if (stage_loader && running && stage_loader->pump()) {
+            if (stage_loader->get_failed_count() > 0) {
+                std::cerr << stage_loader->get_failed_count() << " asset(s) failed to load for " << stage_mode << "\n";
+            }
+            stage_loader.reset();
+            if (stage_mode == "PVP") run_pvp_game(resourceManager);
+            else run_pve_game(resourceManager);
+            resourceManager.end_scope();
+        }
+
         // Render menu
         if (bg) {
             // draw background stretched
@@ -1971,7 +1841,7 @@ int main (int argc, char *argv[]) {
             if (!resourceManager.load_texture("title", "assets/pictures/title.png")) {
                 resourceManager.load_texture("title", "assets/pictures/title.jpg");
             }
-            title_tex = resourceManager.get_texture("title");
+            title_tex = resourceManager.get_texture("title").texture;
             if (title_tex) {
                 int tw, th; SDL_QueryTexture(title_tex, NULL, NULL, &tw, &th);
                 const float scale = 1.4f;
@@ -2001,33 +1871,61 @@ int main (int argc, char *argv[]) {
             }
             SDL_RenderFillRect(renderer, &opt);
             // Draw option text if font available
-            if (font) {
+            if (text) {
                 SDL_Color textColor = { 255, 255, 255, 255 };
-                SDL_Surface* textSurf = TTF_RenderText_Blended(font, options[i].c_str(), textColor);
-                if (textSurf) {
-                    SDL_Texture* textTex = SDL_CreateTextureFromSurface(renderer, textSurf);
-                    int tw = textSurf->w, th = textSurf->h;
-                    SDL_FreeSurface(textSurf);
-                    if (textTex) {
-                        SDL_Rect tdst = { opt.x + (opt.w - tw)/2, opt.y + (opt.h - th)/2, tw, th };
-                        SDL_RenderCopy(renderer, textTex, NULL, &tdst);
-                        SDL_DestroyTexture(textTex);
-                    }
-                }
+                int tw = text->measure(options[i]), th = text->line_height();
+                text->draw(options[i], opt.x + (opt.w - tw)/2, opt.y + (opt.h - th)/2, textColor);
+            }
+        }
+
+        // Loading progress under the options
+        if (stage_loader) {
+            float progress = stage_loader->get_progress();
+            SDL_Rect barBg = { WINDOW_W/2 - 150, baseY + (int)options.size() * 70 + 10, 300, 12 };
+            SDL_SetRenderDrawColor(renderer, 0x22, 0x22, 0x22, 0xFF);
+            SDL_RenderFillRect(renderer, &barBg);
+            SDL_Rect barFg = { barBg.x, barBg.y, (int)(barBg.w * progress), barBg.h };
+            SDL_SetRenderDrawColor(renderer, 0xFF, 0xAA, 0x00, 0xFF);
+            SDL_RenderFillRect(renderer, &barFg);
+            if (text) {
+                char label[64];
+                std::snprintf(label, sizeof(label), "Loading %s... %d%%", stage_mode.c_str(), (int)(progress * 100.0f));
+                int tw = text->measure(label);
+                text->draw(label, WINDOW_W/2 - tw/2, barBg.y + barBg.h + 6, SDL_Color{ 230, 230, 230, 255 });
             }
         }
 
         SDL_RenderPresent(renderer);
+        if (!menu_shown) {
+            menu_shown = true;
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launch_time).count();
+            std::cerr << "Menu ready in " << ms << " ms (image cache: " << ImageCache::get_hit_count() << " hits, "
+                      << ImageCache::get_miss_count() << " decoded)\n";
+        }
         SDL_Delay(16);
     }
+    // window closed while a stage was still streaming in: drop it and close its scope,
+    // so menu_scope is the one left to end
+    if (stage_loader) {
+        stage_loader.reset();
+        resourceManager.end_scope();
+    }
+
+    if (trace_path) Profiler::instance().write_chrome_trace(trace_path);
+    delete arena;
 
     // Quit SDL
-    // ResourceManager will clean up textures automatically
+    // textures go before the renderer that owns them
+    resourceManager.unload_all();
+    AnimationClipCache::clear();
+    delete text;
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     if (font) TTF_CloseFont(font);
     TTF_Quit();
     SDL_Quit();
+    // last: the font read its glyphs straight out of the pack
+    AssetPack::unmount();
     return EXIT_SUCCESS;
 }
 
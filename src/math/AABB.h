@@ -0,0 +1,32 @@
+#pragma once
+#include "math/Vector2.h"
+#include <algorithm>
+
+// Axis-aligned bounding box in world space, used by the broadphase.
+class AABB {
+public:
+    Vector2 min;
+    Vector2 max;
+
+    constexpr AABB(Vector2 min = ZERO, Vector2 max = ZERO) : min(min), max(max) {}
+
+    static AABB from_center(const Vector2& center, const Vector2& half_extents) {
+        return AABB(center - half_extents, center + half_extents);
+    }
+
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y;
+    }
+
+    AABB& merge(const AABB& other) {
+        min.x = std::min(min.x, other.min.x);
+        min.y = std::min(min.y, other.min.y);
+        max.x = std::max(max.x, other.max.x);
+        max.y = std::max(max.y, other.max.y);
+        return *this;
+    }
+
+    Vector2 center() const { return (min + max) * 0.5f; }
+    Vector2 half_extents() const { return (max - min) * 0.5f; }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+// std::mt19937 that counts how many numbers it has handed out. The engine's
+// own state is 2.5 KB, but (seed, draws) pins it down just as well, so a
+// snapshot stores 12 bytes and restore() replays the draws with discard().
+// Drop-in for the std distributions (UniformRandomBitGenerator).
+class SimRng {
+public:
+    using result_type = std::mt19937::result_type;
+
+    explicit SimRng(result_type seed = std::mt19937::default_seed) : _engine(seed), _seed(seed) {}
+
+    static constexpr result_type min() { return std::mt19937::min(); }
+    static constexpr result_type max() { return std::mt19937::max(); }
+
+    result_type operator()() {
+        ++_draws;
+        return _engine();
+    }
+
+    void seed(result_type seed) {
+        _engine.seed(seed);
+        _seed = seed;
+        _draws = 0;
+    }
+
+    result_type get_seed() const { return _seed; }
+    uint64_t get_draws() const { return _draws; }
+
+    // Puts the engine back to where it was after `draws` numbers from `seed`
+    void restore(result_type seed, uint64_t draws) {
+        this->seed(seed);
+        _engine.discard(draws);
+        _draws = draws;
+    }
+
+private:
+    std::mt19937 _engine;
+    result_type _seed;
+    uint64_t _draws = 0;
+};
@@ -0,0 +1,40 @@
+#include "inc/FrameArena.h"
+#include <iostream>
+
+FrameArena& FrameArena::instance() {
+    static FrameArena arena;
+    return arena;
+}
+
+FrameArena::FrameArena(size_t capacity)
+    : _buffer(static_cast<std::byte*>(::operator new(capacity))), _capacity(capacity) {}
+
+FrameArena::~FrameArena() {
+    ::operator delete(_buffer);
+}
+
+void FrameArena::reset() {
+    if (_used > _peak) _peak = _used;
+    _used = 0;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(_buffer);
+    uintptr_t start = (base + _used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t offset = (size_t)(start - base);
+    if (offset + bytes > _capacity) {
+        // bigger frame than planned: stay correct, just slower
+        if (_overflows++ == 0) {
+            std::cerr << "FrameArena: " << _capacity << " bytes exceeded, falling back to the heap\n";
+        }
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    _used = offset + bytes;
+    return _buffer + offset;
+}
+
+void FrameArena::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    std::byte* b = static_cast<std::byte*>(p);
+    if (b >= _buffer && b < _buffer + _capacity) return; // freed all at once by reset()
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
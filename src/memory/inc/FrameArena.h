@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Bump allocator for data that only lives until the end of the frame: the
+// list of characters that just died, HUD label strings, buff lists read for
+// the HUD. Containers take it through std::pmr,
+//     std::pmr::vector<Character*> died(FrameArena::get());
+// allocate() moves a cursor forward, deallocate() does nothing, and reset() at
+// the top of the game loop releases the whole frame at once. The buffer is
+// allocated once at start-up, so a frame that fits in it never reaches malloc.
+//
+// Anything allocated here is garbage after the next reset(): never store a
+// pointer into the arena in an object that outlives the frame.
+// Game loop thread only (no locking); job threads must not allocate from it.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    static FrameArena& instance();
+    static std::pmr::memory_resource* get() { return &instance(); }
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena() override;
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Start of a frame: everything handed out before is released
+    void reset();
+
+    size_t get_capacity() const { return _capacity; }
+    size_t get_used() const { return _used; }
+    size_t get_peak() const { return _peak; } // highest get_used() seen at a reset
+    // Requests that did not fit and went to the heap instead: time to raise the capacity
+    uint64_t get_overflow_count() const { return _overflows; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    std::byte* _buffer;
+    size_t _capacity;
+    size_t _used = 0;
+    size_t _peak = 0;
+    uint64_t _overflows = 0;
+};
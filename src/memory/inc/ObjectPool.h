@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// What spawn() does when every object of the pool is in use
+enum class PoolPolicy {
+    DROP_OLDEST, // recycle the object spawned longest ago (it is usually almost done)
+    SKIP,        // return nullptr; the new object is simply not created
+};
+
+// Fixed-capacity pool for short-lived objects that come and go many times per
+// second (explosions, blood, smoke). All `capacity` objects are constructed up
+// front from the same arguments (renderer, sprite sheet, ...), so spawning one
+// is T::reset(...) on an idle object: no new/delete, and whatever the object
+// owns (animation, hitbox list) is built once and reused.
+//
+// T needs reset(args...) to put a recycled object back to its just-spawned
+// state, and is_finished() so release_finished() knows when to take it back.
+// get_active() lists live objects oldest first, which is also the draw order.
+template <typename T>
+class ObjectPool {
+public:
+    template <typename... Args>
+    explicit ObjectPool(size_t capacity, PoolPolicy policy, Args&&... args) : _policy(policy) {
+        _objects.reserve(capacity);
+        _free.reserve(capacity);
+        _active.reserve(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            _objects.push_back(new T(args...));
+            _free.push_back(_objects.back());
+        }
+        std::reverse(_free.begin(), _free.end()); // hand out in construction order
+    }
+
+    ~ObjectPool() {
+        for (T* obj : _objects) delete obj;
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Live object reset with `args`, or nullptr when the pool is full and the policy is SKIP
+    template <typename... Args>
+    T* spawn(Args&&... args) {
+        T* obj = nullptr;
+        if (!_free.empty()) {
+            obj = _free.back();
+            _free.pop_back();
+        } else if (_policy == PoolPolicy::DROP_OLDEST && !_active.empty()) {
+            obj = _active.front();
+            _active.erase(_active.begin()); // keeps the rest oldest-first
+            ++_dropped;
+        } else {
+            ++_skipped;
+            return nullptr;
+        }
+        obj->reset(std::forward<Args>(args)...);
+        _active.push_back(obj);
+        return obj;
+    }
+
+    // Finished objects go back to the free list; the rest keep their order
+    void release_finished() {
+        size_t kept = 0;
+        for (T* obj : _active) {
+            if (obj->is_finished()) _free.push_back(obj);
+            else _active[kept++] = obj;
+        }
+        _active.resize(kept);
+    }
+
+    void clear() {
+        for (T* obj : _active) _free.push_back(obj);
+        _active.clear();
+    }
+
+    // Non-const so callers can update the live objects in place (e.g. across jobs)
+    std::vector<T*>& get_active() { return _active; }
+    const std::vector<T*>& get_active() const { return _active; }
+
+    size_t size() const { return _active.size(); }
+    size_t capacity() const { return _objects.size(); }
+    void set_policy(PoolPolicy policy) { _policy = policy; }
+    PoolPolicy get_policy() const { return _policy; }
+    // spawns that recycled a live object (DROP_OLDEST) / were refused (SKIP)
+    uint64_t get_dropped() const { return _dropped; }
+    uint64_t get_skipped() const { return _skipped; }
+
+private:
+    PoolPolicy _policy;
+    std::vector<T*> _objects; // owned, every object of the pool
+    std::vector<T*> _free;
+    std::vector<T*> _active;  // spawn order
+    uint64_t _dropped = 0;
+    uint64_t _skipped = 0;
+};
@@ -0,0 +1,124 @@
+#include "inc/SpatialHash.h"
+#include "components/inc/ICollidable.h"
+#include "jobs/inc/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float world_w, float world_h, float cell_size)
+    : _cell_size(cell_size), _inv_cell_size(1.0f / cell_size) {
+    _cols = std::max(1, (int)std::ceil(world_w / cell_size));
+    _rows = std::max(1, (int)std::ceil(world_h / cell_size));
+    _cells.resize((size_t)_cols * _rows);
+}
+
+int SpatialHash::cell_x(float x) const {
+    int cx = (int)std::floor(x * _inv_cell_size);
+    return std::clamp(cx, 0, _cols - 1);
+}
+
+int SpatialHash::cell_y(float y) const {
+    int cy = (int)std::floor(y * _inv_cell_size);
+    return std::clamp(cy, 0, _rows - 1);
+}
+
+void SpatialHash::clear() {
+    for (int c : _used_cells) _cells[c].clear();
+    _used_cells.clear();
+    _entries.clear();
+    _stamps.clear();
+}
+
+AABB SpatialHash::bounds_of(ICollidable* object) {
+    const std::vector<HitBox*>& hitboxes = object->get_hitboxes();
+    if (hitboxes.empty()) return AABB();
+    AABB bounds = hitboxes[0]->get_bounds();
+    for (size_t i = 1; i < hitboxes.size(); ++i) bounds.merge(hitboxes[i]->get_bounds());
+    return bounds;
+}
+
+uint32_t SpatialHash::insert(ICollidable* object, uint32_t layer, uint32_t id) {
+    return insert(object, bounds_of(object), layer, id);
+}
+
+uint32_t SpatialHash::insert(ICollidable* object, const AABB& bounds, uint32_t layer, uint32_t id) {
+    uint32_t index = (uint32_t)_entries.size();
+    _entries.push_back({ object, id, layer, bounds });
+    _stamps.push_back(0);
+
+    int x0 = cell_x(bounds.min.x), x1 = cell_x(bounds.max.x);
+    int y0 = cell_y(bounds.min.y), y1 = cell_y(bounds.max.y);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int c = y * _cols + x;
+            if (_cells[c].empty()) _used_cells.push_back(c);
+            _cells[c].push_back(index);
+        }
+    }
+    return index;
+}
+
+void SpatialHash::query(const AABB& bounds, uint32_t layer_mask, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (++_query_stamp == 0) {
+        // stamp counter wrapped: reset so stale stamps cannot match
+        std::fill(_stamps.begin(), _stamps.end(), 0);
+        _query_stamp = 1;
+    }
+
+    int x0 = cell_x(bounds.min.x), x1 = cell_x(bounds.max.x);
+    int y0 = cell_y(bounds.min.y), y1 = cell_y(bounds.max.y);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            for (uint32_t index : _cells[y * _cols + x]) {
+                if (_stamps[index] == _query_stamp) continue;
+                _stamps[index] = _query_stamp;
+                const Entry& e = _entries[index];
+                if ((e.layer & layer_mask) && e.bounds.overlaps(bounds)) out.push_back(index);
+            }
+        }
+    }
+    // keep results in insertion order so collision response stays deterministic
+    std::sort(out.begin(), out.end());
+}
+
+void SpatialHash::query_pairs(uint32_t mask_a, uint32_t mask_b, std::vector<std::pair<uint32_t, uint32_t>>& out, JobSystem* jobs) const {
+    out.clear();
+    if (!jobs || _used_cells.size() <= PAIR_GRAIN) {
+        collect_pairs(0, _used_cells.size(), mask_a, mask_b, out);
+    } else {
+        // each job fills its own list, merged in cell order below
+        size_t chunks = (_used_cells.size() + PAIR_GRAIN - 1) / PAIR_GRAIN;
+        if (_pair_chunks.size() < chunks) _pair_chunks.resize(chunks);
+        jobs->parallel_for(_used_cells.size(), PAIR_GRAIN, [&](size_t begin, size_t end) {
+            std::vector<std::pair<uint32_t, uint32_t>>& part = _pair_chunks[begin / PAIR_GRAIN];
+            part.clear();
+            collect_pairs(begin, end, mask_a, mask_b, part);
+        });
+        for (size_t c = 0; c < chunks; ++c) out.insert(out.end(), _pair_chunks[c].begin(), _pair_chunks[c].end());
+    }
+    std::sort(out.begin(), out.end());
+}
+
+void SpatialHash::collect_pairs(size_t first, size_t last, uint32_t mask_a, uint32_t mask_b, std::vector<std::pair<uint32_t, uint32_t>>& out) const {
+    for (size_t u = first; u < last; ++u) {
+        int c = _used_cells[u];
+        const std::vector<uint32_t>& cell = _cells[c];
+        int cx = c % _cols;
+        int cy = c / _cols;
+        for (size_t i = 0; i < cell.size(); ++i) {
+            const Entry& a = _entries[cell[i]];
+            for (size_t j = i + 1; j < cell.size(); ++j) {
+                const Entry& b = _entries[cell[j]];
+                bool match = ((a.layer & mask_a) && (b.layer & mask_b)) ||
+                             ((a.layer & mask_b) && (b.layer & mask_a));
+                if (!match || !a.bounds.overlaps(b.bounds)) continue;
+                // Two entries can share several cells: only report the pair from the
+                // cell holding the top-left corner of their overlap.
+                float ox = std::max(a.bounds.min.x, b.bounds.min.x);
+                float oy = std::max(a.bounds.min.y, b.bounds.min.y);
+                if (cell_x(ox) != cx || cell_y(oy) != cy) continue;
+                out.emplace_back(std::min(cell[i], cell[j]), std::max(cell[i], cell[j]));
+            }
+        }
+    }
+}
@@ -0,0 +1,199 @@
+#include "inc/StaticBVH.h"
+#include "inc/SpatialHash.h"
+#include "components/inc/Circle.h"
+#include "components/inc/ICollidable.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Tree depth with median splits is ~log2(n / MAX_LEAF_ITEMS), 64 covers any arena
+static const int MAX_STACK = 64;
+
+// Slab test của đoạn origin + delta * t (t = 0..max_t) với AABB. t_enter = thời điểm đi vào hộp.
+static bool segment_hits_aabb(const AABB& box, const Vector2& origin, const Vector2& delta, float max_t, float& t_enter) {
+    float t0 = 0.0f, t1 = max_t;
+    const float o[2] = { origin.x, origin.y };
+    const float d[2] = { delta.x, delta.y };
+    const float lo[2] = { box.min.x, box.min.y };
+    const float hi[2] = { box.max.x, box.max.y };
+    for (int k = 0; k < 2; ++k) {
+        if (d[k] == 0.0f) {
+            if (o[k] < lo[k] || o[k] > hi[k]) return false;
+            continue;
+        }
+        float inv = 1.0f / d[k];
+        float ta = (lo[k] - o[k]) * inv;
+        float tb = (hi[k] - o[k]) * inv;
+        if (ta > tb) std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1) return false;
+    }
+    t_enter = t0;
+    return true;
+}
+
+void StaticBVH::clear() {
+    _items.clear();
+    _order.clear();
+    _nodes.clear();
+}
+
+uint32_t StaticBVH::add(ICollidable* object, uint32_t id) {
+    _items.push_back({ object, id, SpatialHash::bounds_of(object) });
+    return (uint32_t)_items.size() - 1;
+}
+
+void StaticBVH::build() {
+    _nodes.clear();
+    _order.resize(_items.size());
+    for (uint32_t i = 0; i < _order.size(); ++i) _order[i] = i;
+    if (_items.empty()) return;
+    _nodes.reserve(2 * _items.size());
+    build_node(0, (uint32_t)_items.size());
+}
+
+uint32_t StaticBVH::build_node(uint32_t first, uint32_t count) {
+    uint32_t index = (uint32_t)_nodes.size();
+    _nodes.push_back({});
+
+    AABB bounds = _items[_order[first]].bounds;
+    AABB centers(bounds.center(), bounds.center());
+    for (uint32_t i = first + 1; i < first + count; ++i) {
+        const AABB& b = _items[_order[i]].bounds;
+        bounds.merge(b);
+        centers.merge(AABB(b.center(), b.center()));
+    }
+    _nodes[index].bounds = bounds;
+
+    if (count <= MAX_LEAF_ITEMS) {
+        _nodes[index].first = first;
+        _nodes[index].count = count;
+        _nodes[index].right = 0;
+        return index;
+    }
+
+    // chia đôi theo median tâm hộp trên trục dài nhất
+    Vector2 extent = centers.max - centers.min;
+    bool split_x = extent.x >= extent.y;
+    uint32_t half = count / 2;
+    auto begin = _order.begin() + first;
+    std::nth_element(begin, begin + half, begin + count, [&](uint32_t a, uint32_t b) {
+        Vector2 ca = _items[a].bounds.center(), cb = _items[b].bounds.center();
+        float ka = split_x ? ca.x : ca.y, kb = split_x ? cb.x : cb.y;
+        // tie-break by index so the tree is identical on every platform
+        return ka < kb || (ka == kb && a < b);
+    });
+
+    build_node(first, half);
+    uint32_t right = build_node(first + half, count - half);
+    _nodes[index].first = first;
+    _nodes[index].count = 0;
+    _nodes[index].right = right;
+    return index;
+}
+
+void StaticBVH::query(const AABB& bounds, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (_nodes.empty()) return;
+
+    uint32_t stack[MAX_STACK];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = _nodes[stack[--top]];
+        if (!node.bounds.overlaps(bounds)) continue;
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if (_items[_order[i]].bounds.overlaps(bounds)) out.push_back(_order[i]);
+            }
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = (uint32_t)(&node - _nodes.data()) + 1;
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+void StaticBVH::query_segment(const Vector2& origin, const Vector2& delta, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (_nodes.empty()) return;
+
+    uint32_t stack[MAX_STACK];
+    int top = 0;
+    stack[top++] = 0;
+    float t;
+    while (top > 0) {
+        const Node& node = _nodes[stack[--top]];
+        if (!segment_hits_aabb(node.bounds, origin, delta, 1.0f, t)) continue;
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if (segment_hits_aabb(_items[_order[i]].bounds, origin, delta, 1.0f, t)) out.push_back(_order[i]);
+            }
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = (uint32_t)(&node - _nodes.data()) + 1;
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+void StaticBVH::query_hitbox(HitBox& shape, std::vector<uint32_t>& out) const {
+    query(shape.get_bounds(), out);
+    // giữ lại những item có hitbox thật sự chạm vào shape
+    size_t kept = 0;
+    for (uint32_t index : out) {
+        for (auto* hb : _items[index].object->get_hitboxes()) {
+            if (hb->is_collide(shape)) {
+                out[kept++] = index;
+                break;
+            }
+        }
+    }
+    out.resize(kept);
+}
+
+void StaticBVH::query_obb(OBB& box, std::vector<uint32_t>& out) const {
+    query_hitbox(box, out);
+}
+
+void StaticBVH::query_circle(Circle& circle, std::vector<uint32_t>& out) const {
+    query_hitbox(circle, out);
+}
+
+bool StaticBVH::raycast(const Vector2& origin, const Vector2& delta, RayHit& result) const {
+    if (_nodes.empty()) return false;
+
+    bool found = false;
+    float best = 1.0f;
+    uint32_t stack[MAX_STACK];
+    int top = 0;
+    stack[top++] = 0;
+    float t;
+    while (top > 0) {
+        const Node& node = _nodes[stack[--top]];
+        // node starts beyond the nearest hit so far -> nothing inside can be closer
+        if (!segment_hits_aabb(node.bounds, origin, delta, best, t)) continue;
+        if (node.count == 0) {
+            stack[top++] = node.right;
+            stack[top++] = (uint32_t)(&node - _nodes.data()) + 1;
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            uint32_t index = _order[i];
+            for (auto* hb : _items[index].object->get_hitboxes()) {
+                if (hb->get_kind() != ShapeKind::OBB) continue;
+                SweepHit hit;
+                if (!static_cast<OBB*>(hb)->raycast(origin, delta, hit)) continue;
+                // equal toi: lower index wins, independent of traversal order
+                if (!found || hit.toi < best || (hit.toi == best && index < result.item)) {
+                    best = hit.toi;
+                    result.item = index;
+                    result.hit = hit;
+                    found = true;
+                }
+            }
+        }
+    }
+    return found;
+}
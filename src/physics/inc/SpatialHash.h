@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Constant.h"
+#include "math/AABB.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+class ICollidable;
+class JobSystem;
+
+// Layers let one grid hold several kinds of objects; queries filter by mask.
+enum CollisionLayer : uint32_t {
+    LAYER_WALL      = 1u << 0,
+    LAYER_CHARACTER = 1u << 1,
+    LAYER_BULLET    = 1u << 2,
+    LAYER_BLACKHOLE = 1u << 3,
+    LAYER_BUFF      = 1u << 4,
+    LAYER_EXPLOSION = 1u << 5,
+    LAYER_ALL       = 0xFFFFFFFFu,
+};
+
+// Uniform-grid broadphase. Objects are binned by their AABB into fixed-size
+// cells covering the world, so the narrowphase (HitBox::is_collide) only runs
+// on objects that share at least one cell. Anything outside the world is
+// clamped into the border cells.
+class SpatialHash {
+public:
+    struct Entry {
+        ICollidable* object;
+        uint32_t id;    // caller-defined payload (e.g. an index into its own array)
+        uint32_t layer;
+        AABB bounds;
+    };
+
+    static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+    // occupied cells per job in query_pairs()
+    static constexpr size_t PAIR_GRAIN = 32;
+
+    SpatialHash(float world_w = WORLD_W, float world_h = WORLD_H, float cell_size = DEFAULT_CELL_SIZE);
+
+    // Empties every cell but keeps their capacity, so rebuilding each frame does not allocate.
+    void clear();
+
+    // Inserts using the union of the object's hitbox bounds. Returns the entry index.
+    uint32_t insert(ICollidable* object, uint32_t layer, uint32_t id = 0);
+    uint32_t insert(ICollidable* object, const AABB& bounds, uint32_t layer, uint32_t id = 0);
+
+    const Entry& get_entry(uint32_t index) const { return _entries[index]; }
+    size_t size() const { return _entries.size(); }
+
+    // Entry indices overlapping `bounds` whose layer is in `layer_mask`, in insertion order.
+    void query(const AABB& bounds, uint32_t layer_mask, std::vector<uint32_t>& out) const;
+
+    // Every overlapping pair (a, b) with a in mask_a and b in mask_b, reported once,
+    // as entry indices with first < second, sorted. With `jobs` the cells are
+    // scanned in parallel; the sorted result is the same either way.
+    void query_pairs(uint32_t mask_a, uint32_t mask_b, std::vector<std::pair<uint32_t, uint32_t>>& out, JobSystem* jobs = nullptr) const;
+
+    // Union of all hitbox bounds of an object
+    static AABB bounds_of(ICollidable* object);
+
+private:
+    float _cell_size;
+    float _inv_cell_size;
+    int _cols;
+    int _rows;
+    std::vector<Entry> _entries;
+    std::vector<std::vector<uint32_t>> _cells;
+    std::vector<int> _used_cells; // cells that received at least one entry since clear()
+
+    // per-entry stamp used to de-duplicate entries spanning several cells in query()
+    mutable std::vector<uint32_t> _stamps;
+    mutable uint32_t _query_stamp = 0;
+    // per-job output of a parallel query_pairs(), kept for its capacity
+    mutable std::vector<std::vector<std::pair<uint32_t, uint32_t>>> _pair_chunks;
+
+    int cell_x(float x) const;
+    int cell_y(float y) const;
+    // pairs from _used_cells[first, last), appended to out unsorted
+    void collect_pairs(size_t first, size_t last, uint32_t mask_a, uint32_t mask_b, std::vector<std::pair<uint32_t, uint32_t>>& out) const;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "components/inc/OBB.h"
+#include "math/AABB.h"
+#include "math/Vector2.h"
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class ICollidable;
+class Circle;
+
+// Bounding-volume hierarchy for objects that never move (walls). Built once
+// when a stage's wall list is final, then every query only descends into the
+// branches its shape touches, so a query costs O(log n) instead of scanning
+// every wall. Query results are item indices in insertion order (same contract
+// as SpatialHash::query), so resolution order does not depend on the tree shape.
+class StaticBVH {
+public:
+    struct Item {
+        ICollidable* object;
+        uint32_t id;    // caller-defined payload
+        AABB bounds;    // union of the object's hitbox bounds
+    };
+
+    // nearest hit of raycast(): item index, time of impact along delta, surface normal
+    struct RayHit {
+        uint32_t item = 0;
+        SweepHit hit;
+    };
+
+    static constexpr uint32_t MAX_LEAF_ITEMS = 2;
+
+    // Drops items and nodes; capacity is kept for the next stage.
+    void clear();
+    // Items added after build() are not visible to queries until the next build().
+    uint32_t add(ICollidable* object, uint32_t id = 0);
+    void build();
+
+    const Item& get_item(uint32_t index) const { return _items[index]; }
+    size_t size() const { return _items.size(); }
+
+    // Items whose bounds overlap `bounds` (broadphase only)
+    void query(const AABB& bounds, std::vector<uint32_t>& out) const;
+    // Items whose bounds the segment origin -> origin + delta crosses (broadphase only)
+    void query_segment(const Vector2& origin, const Vector2& delta, std::vector<uint32_t>& out) const;
+    // Items with at least one hitbox actually touching the shape (narrowphase included)
+    void query_obb(OBB& box, std::vector<uint32_t>& out) const;
+    void query_circle(Circle& circle, std::vector<uint32_t>& out) const;
+
+    // Nearest OBB hitbox along origin -> origin + delta. Branches farther than
+    // the best hit so far are skipped.
+    bool raycast(const Vector2& origin, const Vector2& delta, RayHit& result) const;
+
+private:
+    // Leaf: count > 0, items _order[first .. first + count).
+    // Inner: count == 0, left child is the next node, right child at `right`.
+    struct Node {
+        AABB bounds;
+        uint32_t first;
+        uint32_t count;
+        uint32_t right;
+    };
+
+    uint32_t build_node(uint32_t first, uint32_t count);
+    // overlap + exact test shared by query_obb / query_circle
+    void query_hitbox(HitBox& shape, std::vector<uint32_t>& out) const;
+
+    std::vector<Item> _items;
+    std::vector<uint32_t> _order; // item indices, grouped by leaf
+    std::vector<Node> _nodes;
+};
@@ -0,0 +1,60 @@
+#include "inc/ProfilerOverlay.h"
+#include "inc/TextRenderer.h"
+#include <cstdio>
+
+void ProfilerOverlay::toggle() {
+    _visible = !_visible;
+    _next_refresh = 0;
+    Profiler& profiler = Profiler::instance();
+    profiler.set_enabled(_visible || profiler.is_trace_enabled());
+}
+
+void ProfilerOverlay::render(SDL_Renderer* renderer, TextRenderer* text, int x, int y) {
+    if (!_visible || !text) return;
+
+    Uint32 now = SDL_GetTicks();
+    if (now >= _next_refresh) {
+        _next_refresh = now + REFRESH_MS;
+        Profiler::instance().get_stats(_stats);
+        // cells are overwritten in place: assign() keeps each string's buffer, so a
+        // refresh does not show up in the allocation row it displays
+        _cells.resize((_stats.size() + 2) * 4);
+        size_t cell = 0;
+        auto put = [&](const char* value) { _cells[cell++].assign(value); };
+        char buf[32];
+        for (const char* header : { "scope (ms)", "min", "avg", "max" }) put(header);
+        for (const auto& st : _stats) {
+            put(st.name);
+            for (double v : { st.min_ms, st.avg_ms, st.max_ms }) {
+                std::snprintf(buf, sizeof(buf), "%.2f", v);
+                put(buf);
+            }
+        }
+        Profiler::AllocStats allocs = Profiler::instance().get_alloc_stats();
+        put("heap allocs/frame");
+        std::snprintf(buf, sizeof(buf), "%llu", (unsigned long long)allocs.min);
+        put(buf);
+        std::snprintf(buf, sizeof(buf), "%.1f", allocs.avg);
+        put(buf);
+        std::snprintf(buf, sizeof(buf), "%llu", (unsigned long long)allocs.max);
+        put(buf);
+    }
+
+    // fixed columns: the font is proportional, so padding with spaces would not line up
+    const int rows = (int)_cells.size() / 4;
+    const int line_h = text->line_height();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_Rect bg = { x - 6, y - 4, NAME_COLUMN_W + 3 * NUMBER_COLUMN_W + 12, rows * line_h + 8 };
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 190);
+    SDL_RenderFillRect(renderer, &bg);
+    const SDL_Color header = { 255, 220, 120, 255 };
+    const SDL_Color row = { 200, 255, 200, 255 };
+    for (int r = 0; r < rows; ++r) {
+        SDL_Color color = r == 0 ? header : row;
+        int ry = y + r * line_h;
+        text->draw(_cells[r * 4], x, ry, color, NAME_COLUMN_W - 8);
+        for (int c = 1; c < 4; ++c) {
+            text->draw(_cells[r * 4 + c], x + NAME_COLUMN_W + (c - 1) * NUMBER_COLUMN_W, ry, color);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include "inc/TextRenderer.h"
+#include <algorithm>
+
+static const char* ELLIPSIS = "...";
+
+TextRenderer::TextRenderer(SDL_Renderer* renderer, TTF_Font* font) : _renderer(renderer), _font(font) {
+    if (_font) build_atlas();
+}
+
+TextRenderer::~TextRenderer() {
+    if (_atlas) SDL_DestroyTexture(_atlas);
+}
+
+void TextRenderer::build_atlas() {
+    _line_height = TTF_FontHeight(_font);
+    const SDL_Color white = { 255, 255, 255, 255 };
+    const int count = LAST_GLYPH - FIRST_GLYPH + 1;
+
+    // Rasterize every glyph, then shelf-pack them into rows of ATLAS_WIDTH
+    std::vector<SDL_Surface*> surfaces(count, nullptr);
+    int pen_x = 0, pen_y = 0, row_h = 0;
+    for (int i = 0; i < count; ++i) {
+        Uint16 ch = (Uint16)(FIRST_GLYPH + i);
+        int minx, maxx, miny, maxy, advance = 0;
+        if (TTF_GlyphMetrics(_font, ch, &minx, &maxx, &miny, &maxy, &advance) != 0) advance = 0;
+        _glyphs[i].advance = advance;
+
+        SDL_Surface* s = TTF_RenderGlyph_Blended(_font, ch, white);
+        surfaces[i] = s;
+        if (!s) { _glyphs[i].src = { 0, 0, 0, 0 }; continue; }
+        if (pen_x + s->w > ATLAS_WIDTH) { pen_x = 0; pen_y += row_h + 1; row_h = 0; }
+        _glyphs[i].src = { pen_x, pen_y, s->w, s->h };
+        pen_x += s->w + 1; // 1px gap so linear filtering does not bleed
+        row_h = std::max(row_h, s->h);
+    }
+    _atlas_w = ATLAS_WIDTH;
+    _atlas_h = pen_y + row_h;
+
+    SDL_Surface* atlas = SDL_CreateRGBSurfaceWithFormat(0, _atlas_w, std::max(_atlas_h, 1), 32, SDL_PIXELFORMAT_ARGB8888);
+    if (atlas) {
+        SDL_FillRect(atlas, NULL, SDL_MapRGBA(atlas->format, 255, 255, 255, 0));
+        for (int i = 0; i < count; ++i) {
+            if (!surfaces[i]) continue;
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE); // copy alpha as-is
+            SDL_Rect dst = _glyphs[i].src;
+            SDL_BlitSurface(surfaces[i], NULL, atlas, &dst);
+        }
+        _atlas = SDL_CreateTextureFromSurface(_renderer, atlas);
+        if (_atlas) SDL_SetTextureBlendMode(_atlas, SDL_BLENDMODE_BLEND);
+        SDL_FreeSurface(atlas);
+    }
+    for (auto* s : surfaces) if (s) SDL_FreeSurface(s);
+    if (!_atlas) SDL_Log("TextRenderer: failed to build glyph atlas: %s", SDL_GetError());
+}
+
+int TextRenderer::advance_of(char c) const {
+    if (c < FIRST_GLYPH || c > LAST_GLYPH) c = '?';
+    return _glyphs[c - FIRST_GLYPH].advance;
+}
+
+const TextRenderer::Layout& TextRenderer::layout(std::string_view text, int max_width) {
+    if (max_width < 0) max_width = 0;
+    auto& by_text = _layouts[max_width];
+    _key.assign(text.data(), text.size());
+    auto it = by_text.find(_key);
+    if (it != by_text.end()) return it->second;
+
+    // labels built with changing numbers would grow this forever; start over past the cap
+    if (_layout_count >= MAX_CACHED_LAYOUTS) {
+        for (auto& pair : _layouts) if (&pair.second != &by_text) pair.second.clear();
+        by_text.clear();
+        _layout_count = 0;
+    }
+
+    Layout result;
+    int width = 0;
+    for (char c : text) width += advance_of(c);
+    if (max_width == 0 || width <= max_width) {
+        result = { _key, width };
+    } else {
+        // one pass over prefix widths instead of re-measuring every shorter candidate
+        int ellipsis_w = 0;
+        for (const char* p = ELLIPSIS; *p; ++p) ellipsis_w += advance_of(*p);
+        size_t keep = 0;
+        int prefix_w = 0;
+        while (keep < text.size() && prefix_w + advance_of(text[keep]) + ellipsis_w <= max_width) {
+            prefix_w += advance_of(text[keep]);
+            ++keep;
+        }
+        result = { _key.substr(0, keep) + ELLIPSIS, prefix_w + ellipsis_w };
+    }
+    ++_layout_count;
+    return by_text.emplace(_key, std::move(result)).first->second;
+}
+
+int TextRenderer::measure(std::string_view text) {
+    return layout(text, 0).width;
+}
+
+const std::string& TextRenderer::ellipsize(std::string_view text, int max_width) {
+    return layout(text, max_width).text;
+}
+
+int TextRenderer::draw(std::string_view text, int x, int y, SDL_Color color, int max_width) {
+    if (!_atlas) return 0;
+    const Layout& l = layout(text, max_width);
+
+    _vertices.clear();
+    _indices.clear();
+    const float inv_w = 1.0f / _atlas_w, inv_h = 1.0f / _atlas_h;
+    int pen_x = x;
+    for (char c : l.text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) c = '?';
+        const Glyph& g = _glyphs[c - FIRST_GLYPH];
+        if (g.src.w > 0 && c != ' ') {
+            float x0 = (float)pen_x, y0 = (float)y;
+            float x1 = x0 + g.src.w, y1 = y0 + g.src.h;
+            float u0 = g.src.x * inv_w, v0 = g.src.y * inv_h;
+            float u1 = (g.src.x + g.src.w) * inv_w, v1 = (g.src.y + g.src.h) * inv_h;
+            int base = (int)_vertices.size();
+            _vertices.push_back({ { x0, y0 }, color, { u0, v0 } });
+            _vertices.push_back({ { x1, y0 }, color, { u1, v0 } });
+            _vertices.push_back({ { x1, y1 }, color, { u1, v1 } });
+            _vertices.push_back({ { x0, y1 }, color, { u0, v1 } });
+            _indices.insert(_indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+        pen_x += g.advance;
+    }
+    if (!_vertices.empty()) {
+        SDL_RenderGeometry(_renderer, _atlas, _vertices.data(), (int)_vertices.size(), _indices.data(), (int)_indices.size());
+    }
+    return l.width;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "debug/inc/Profiler.h"
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+class TextRenderer;
+
+// On-screen table of the Profiler scopes: rolling min / avg / max in ms over
+// the last Profiler::HISTORY frames, plus heap allocations per frame. The rows are re-formatted a few times per
+// second only, so the numbers stay readable and the text cache stays warm.
+class ProfilerOverlay {
+public:
+    static constexpr Uint32 REFRESH_MS = 500;
+    static constexpr int NAME_COLUMN_W = 220;
+    static constexpr int NUMBER_COLUMN_W = 80;
+
+    // Showing the overlay switches the Profiler on (it stays on while a trace is recorded).
+    void toggle();
+    bool is_visible() const { return _visible; }
+
+    void render(SDL_Renderer* renderer, TextRenderer* text, int x, int y);
+
+private:
+    bool _visible = false;
+    Uint32 _next_refresh = 0;
+    std::vector<Profiler::Stats> _stats;
+    std::vector<std::string> _cells; // 4 per row: name, min, avg, max (row 0 = header)
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Text drawn from a glyph atlas instead of TTF_RenderText + a texture per label
+// per frame. The printable ASCII glyphs of the font are rasterized once (white,
+// tinted per draw through the vertex color); a string becomes one
+// SDL_RenderGeometry call with a quad per glyph. Measured / ellipsized layouts
+// are cached by (string, max width), so the HUD re-measures nothing per frame.
+class TextRenderer {
+public:
+    static constexpr char FIRST_GLYPH = 32;  // ' '
+    static constexpr char LAST_GLYPH = 126;  // '~'
+    static constexpr int ATLAS_WIDTH = 512;
+    static constexpr size_t MAX_CACHED_LAYOUTS = 512;
+
+    TextRenderer(SDL_Renderer* renderer, TTF_Font* font);
+    ~TextRenderer();
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    // Draws `text` with its top-left corner at (x, y). max_width > 0 shortens it
+    // with "..." to fit. Returns the drawn width in pixels. Takes a view so labels
+    // built in the frame arena (std::pmr::string) or a char buffer need no copy;
+    // a cached layout is found without allocating.
+    int draw(std::string_view text, int x, int y, SDL_Color color, int max_width = 0);
+
+    int measure(std::string_view text);
+    // `text` itself if it fits in max_width, otherwise the longest prefix + "..." that does.
+    const std::string& ellipsize(std::string_view text, int max_width);
+    int line_height() const { return _line_height; }
+    bool is_ready() const { return _atlas != nullptr; }
+
+private:
+    struct Glyph {
+        SDL_Rect src;    // in the atlas
+        int advance;
+    };
+    struct Layout {
+        std::string text; // possibly ellipsized
+        int width;
+    };
+
+    void build_atlas();
+    const Layout& layout(std::string_view text, int max_width);
+    int advance_of(char c) const;
+
+    SDL_Renderer* _renderer;
+    TTF_Font* _font;
+    SDL_Texture* _atlas = nullptr;
+    int _atlas_w = 0, _atlas_h = 0;
+    int _line_height = 0;
+    Glyph _glyphs[LAST_GLYPH - FIRST_GLYPH + 1] = {};
+
+    // max_width (0 = unlimited) -> text -> layout; looked up without building a combined key
+    std::unordered_map<int, std::unordered_map<std::string, Layout>> _layouts;
+    size_t _layout_count = 0;
+    std::string _key; // lookup key, reused so its capacity sticks
+
+    // scratch geometry reused between draws
+    std::vector<SDL_Vertex> _vertices;
+    std::vector<int> _indices;
+};
@@ -10,17 +10,19 @@
 #include <vector>
 #include "Constant.h"
 #include "ResourceManager.h"
+#include "AnimationClipCache.h"
 #include "math/Vector2.h"
 #include "components/inc/Character.h"
 #include "components/inc/IRenderable.h"
 #include "components/inc/IUpdatable.h"
 #include "components/inc/InputHandler.h"
-#include "components/inc/Bullet.h"
+#include "components/inc/BulletSystem.h"
 #include "components/inc/BlackHole.h"
 #include "components/inc/AnimatedSprite.h"
 #include "components/inc/BuffItem.h"
 #include "components/inc/Explosion.h"
 #include "components/inc/Wall.h"
+#include "memory/inc/ObjectPool.h"
 #include <string>
 #include <sstream>
 
@@ -166,10 +168,10 @@ int main (int argc, char *argv[]) {
                     5.0f, 15.0f);  // outer dps, inner dps
     blackhole.set_animation(&blackhole_anim);
 
-    SDL_Texture* health_buff_texture = resource_manager.load_texture("health-buff", "assets/pictures/health-buff.png");
-    SDL_Texture* bounce_tex = resource_manager.load_texture("bounce-buff", "assets/pictures/bounce-buff.png");
-    SDL_Texture* explode_tex = resource_manager.load_texture("explode-buff", "assets/pictures/explode-buff.png");
-    SDL_Texture* piercing_tex = resource_manager.load_texture("piercing-buff", "assets/pictures/piercing-buff.png");
+    SDL_Texture* health_buff_texture = resource_manager.load_texture("health-buff", "assets/pictures/health-buff.png").texture;
+    SDL_Texture* bounce_tex = resource_manager.load_texture("bounce-buff", "assets/pictures/bounce-buff.png").texture;
+    SDL_Texture* explode_tex = resource_manager.load_texture("explode-buff", "assets/pictures/explode-buff.png").texture;
+    SDL_Texture* piercing_tex = resource_manager.load_texture("piercing-buff", "assets/pictures/piercing-buff.png").texture;
 
     BuffItem* health_buff = new BuffItem(Vector2(100, WORLD_H - 100.0f), health_buff_texture ? health_buff_texture : green_texture, CharBuffType::HEALTH);
 
@@ -178,9 +180,9 @@ int main (int argc, char *argv[]) {
 
     std::vector<BuffItem*> buff_items {health_buff, bounce_buff, explode_buff};
 
-    std::vector<Bullet*> bullet_list;
+    BulletSystem bullet_list;
     // Explosions for testing (150x150 frames, 12 frames, 3 columns)
-    std::vector<Explosion*> explosions;
+    ObjectPool<Explosion> explosions(32, PoolPolicy::DROP_OLDEST, renderer, EXPLOSION_TEXTURE_PATH, Vector2(), 50, 50, 9, 40, 3);
     
 
     std::vector<IUpdatable*> updatable_list;
@@ -205,13 +207,12 @@ int main (int argc, char *argv[]) {
                 running = false;
             }
             else {
-                input_handler.handle_event(event, bullet_list, resource_manager);
-                input_handler2.handle_event(event, bullet_list, resource_manager);
+                input_handler.handle_event(event);
+                input_handler2.handle_event(event);
                 // Spawn explosion on E key press
                 if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_E) {
                     Vector2 pos = blackhole.get_position() - Vector2(50, 50); 
-                    Explosion* e = new Explosion(renderer, "assets/pictures/rielno.png", pos, 50, 50, 9, 40, 3, 10.0f);
-                    explosions.push_back(e);
+                    explosions.spawn(pos, 10.0f);
                 }
             }
         }
@@ -222,21 +223,21 @@ int main (int argc, char *argv[]) {
         float delta_time = (current_time - last_time) / 1000.0f;
         last_time = current_time;
 
+        input_handler.apply_actions(bullet_list);
+        input_handler2.apply_actions(bullet_list);
         for (auto updatable : updatable_list) {
             updatable->update(delta_time);
         }
 
-        for (Bullet* bullet : bullet_list) {
-            bullet->update(delta_time);
-        }
+        bullet_list.update(delta_time);
 
         // check for collision
-        for (auto& bullet : bullet_list) {
-            blackhole.collide(bullet);
-            far_wall.collide(bullet);
-            right_wall.collide(bullet);
+        for (size_t i = 0; i < bullet_list.size(); ++i) {
+            bullet_list.collide(i, &blackhole);
+            bullet_list.collide(i, &far_wall);
+            bullet_list.collide(i, &right_wall);
             for (auto& character : characters) {
-                character->collide(bullet);
+                bullet_list.collide(i, character);
             }
         }
 
@@ -251,7 +252,7 @@ int main (int argc, char *argv[]) {
             }
 
         // Explosion collision with characters
-        for (auto* explosion : explosions) {
+        for (auto* explosion : explosions.get_active()) {
             for (auto& character : characters) {
                 character->collide(explosion);
             }
@@ -273,26 +274,12 @@ int main (int argc, char *argv[]) {
         }
 
         // Handle destroyed bullets
-        bullet_list.erase(std::remove_if(bullet_list.begin(), bullet_list.end(),
-            [&explosions, renderer](Bullet* bullet) {
-                if (bullet->is_destroyed()) {
-                    if (bullet->getBuff() == BulletBuffType::EXPLODING) {
-                        bullet->explode(explosions, renderer);
-                    }
-                    delete bullet;
-                    return true;
-                }
-                return false;
-            }),
-            bullet_list.end());
+        bullet_list.flush_destroyed(explosions);
 
         // Update explosions and remove finished ones
-        for (auto* e : explosions) e->update(delta_time);
-        // remove finished
-        explosions.erase(std::remove_if(explosions.begin(), explosions.end(), [](Explosion* e){
-            if (e->is_finished()) { delete e; return true; }
-            return false;
-        }), explosions.end());
+        for (auto* e : explosions.get_active()) e->update(delta_time);
+        // finished ones go back to the pool
+        explosions.release_finished();
 
 
         // --- Rendering ---
@@ -301,16 +288,13 @@ int main (int argc, char *argv[]) {
 
         // Render character sprites
         // render bullets
-        for (Bullet* bullet : bullet_list) {
-            IRenderable* obj = dynamic_cast<IRenderable*>(bullet);
-            obj->render(renderer);
-        }
+        bullet_list.render(renderer, resource_manager.get_texture("bullet"));
         // render black hole animation/sprite
     blackhole.render(renderer);
     far_wall.render(renderer);
     right_wall.render(renderer);
     // render explosions
-    for (auto* e : explosions) 
+    for (auto* e : explosions.get_active()) 
     {
         e->render(renderer);
         for (auto* hb : e->get_hitboxes()) {
@@ -375,9 +359,6 @@ int main (int argc, char *argv[]) {
         SDL_RenderPresent(renderer);                          // Update the screen
     }
 
-    for (Bullet* bullet : bullet_list) {
-        delete bullet;
-    }
     bullet_list.clear();
 
     for (BuffItem* buff : buff_items) {
@@ -391,6 +372,7 @@ int main (int argc, char *argv[]) {
     SDL_DestroyTexture(red_texture);
     SDL_DestroyTexture(blue_texture);
     SDL_DestroyTexture(green_texture);
+    AnimationClipCache::clear();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     TTF_CloseFont(font);
@@ -12,7 +12,7 @@
 #include "components/inc/IRenderable.h"
 #include "components/inc/IUpdatable.h"
 #include "components/inc/InputHandler.h"
-#include "components/inc/Bullet.h"
+#include "components/inc/BulletSystem.h"
 #include "math/Vector2.h"
 
 
@@ -98,7 +98,7 @@ int main (int argc, char *argv[]) {
     InputHandler input_handler(InputSet::INPUT_1, &player1_1, &player1_2);
     InputHandler input_handler2(InputSet::INPUT_2, &player2_1, &player2_2);
 
-    std::vector<Bullet*> bullet_list;
+    BulletSystem bullet_list;
 
     std::vector<IUpdatable*> updatable_list;
     for (Character* ch : characters) {
@@ -118,8 +118,8 @@ int main (int argc, char *argv[]) {
                 running = false;
             }
             else {
-                input_handler.handle_event(event, bullet_list, resource_manager);
-                input_handler2.handle_event(event, bullet_list, resource_manager);
+                input_handler.handle_event(event);
+                input_handler2.handle_event(event);
             }
         }
 
@@ -128,19 +128,19 @@ int main (int argc, char *argv[]) {
         float delta_time = (current_time - last_time) / 1000.0f;
         last_time = current_time;
 
+        input_handler.apply_actions(bullet_list);
+        input_handler2.apply_actions(bullet_list);
         for (auto updatable : updatable_list) {
             updatable->update(delta_time);
         }
 
-        for (Bullet* bullet : bullet_list) {
-            bullet->update(delta_time);
-        }
+        bullet_list.update(delta_time);
 
 
         // check for collision
-        for (auto& bullet : bullet_list) {
+        for (size_t i = 0; i < bullet_list.size(); ++i) {
             for (auto& character : characters) {
-                character->collide(*bullet);
+                bullet_list.collide(i, character);
             }
         }
 
@@ -151,19 +151,16 @@ int main (int argc, char *argv[]) {
         // Render characters
         for (auto& character : characters) {
             Vector2 pos = character->get_position();
-            const SDL_Texture* tex = character->get_sprite();
+            const TextureRegion& tex = character->get_sprite();
             if (tex) {
                 SDL_Rect dstRect = { (int)pos.x - 8, (int)pos.y - 8, 16, 16 };
-                SDL_RenderCopy(renderer, const_cast<SDL_Texture*>(tex), NULL, &dstRect);
+                SDL_RenderCopy(renderer, tex.texture, tex.get_src(), &dstRect);
             }
             character->render(renderer);
         }
 
         // render bullets
-        for (Bullet* bullet : bullet_list) {
-            IRenderable* obj = dynamic_cast<IRenderable*>(bullet);
-            obj->render(renderer);
-        }
+        bullet_list.render(renderer, resource_manager.get_texture("bullet"));
 
 
         SDL_RenderPresent(renderer);                          // Update the screen
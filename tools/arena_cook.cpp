@@ -0,0 +1,22 @@
+// arena_cook <in.arena> <out.arenac>
+// Parses a text arena and writes the cooked image the game mmaps at stage load.
+#include "game/inc/Arena.h"
+#include <cstdlib>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <in.arena> <out.arenac>\n";
+        return EXIT_FAILURE;
+    }
+    Arena* arena = Arena::load_text(argv[1]);
+    if (!arena) return EXIT_FAILURE;
+
+    bool ok = arena->write_cooked(argv[2]);
+    if (ok) {
+        std::cout << argv[2] << ": " << arena->get_walls().size() << " walls, " << arena->get_spawns().size() << " spawns, "
+                  << arena->get_buff_zones().size() << " buff zones, " << arena->get_blackhole_zones().size() << " black hole zones\n";
+    }
+    delete arena;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
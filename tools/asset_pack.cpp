@@ -0,0 +1,92 @@
+// asset_pack [--decode] <out.gpak> <file>...
+// Packs the given files into one AssetPack, each under the path it was given
+// ("assets/pictures/bulletA.png"). With --decode, images are stored as
+// ARGB8888 pixels instead of PNG/JPG bytes: bigger on disk, no inflate at load.
+#include "assets/inc/AssetPack.h"
+#include <SDL.h>
+#include <SDL_image.h>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static bool is_image(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return false;
+    std::string ext = path.substr(dot + 1);
+    for (char& c : ext) c = (char)std::tolower((unsigned char)c);
+    return ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp";
+}
+
+// Same spelling the game uses: forward slashes, no leading "./"
+static std::string pack_name(std::string path) {
+    for (char& c : path) if (c == '\\') c = '/';
+    while (path.compare(0, 2, "./") == 0) path.erase(0, 2);
+    return path;
+}
+
+static bool read_bytes(const std::string& path, AssetPack::Source& src) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    src.kind = AssetPackKind::FILE;
+    src.bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static bool decode_pixels(const std::string& path, AssetPack::Source& src) {
+    SDL_Surface* loaded = IMG_Load(path.c_str());
+    if (!loaded) return false;
+    SDL_Surface* argb = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(loaded);
+    if (!argb) return false;
+    // tightly packed rows, whatever pitch SDL picked
+    src.kind = AssetPackKind::PIXELS;
+    src.format = SDL_PIXELFORMAT_ARGB8888;
+    src.width = argb->w;
+    src.height = argb->h;
+    src.pitch = argb->w * 4;
+    src.bytes.resize((size_t)src.pitch * argb->h);
+    SDL_LockSurface(argb);
+    for (int y = 0; y < argb->h; ++y) {
+        std::memcpy(src.bytes.data() + (size_t)y * src.pitch, static_cast<const uint8_t*>(argb->pixels) + (size_t)y * argb->pitch, (size_t)src.pitch);
+    }
+    SDL_UnlockSurface(argb);
+    SDL_FreeSurface(argb);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int first = 1;
+    bool decode = false;
+    if (argc > 1 && std::strcmp(argv[1], "--decode") == 0) {
+        decode = true;
+        ++first;
+    }
+    if (argc - first < 2) {
+        std::cerr << "usage: " << argv[0] << " [--decode] <out.gpak> <file>...\n";
+        return EXIT_FAILURE;
+    }
+    const char* out_path = argv[first];
+
+    std::vector<AssetPack::Source> sources;
+    size_t decoded = 0;
+    for (int i = first + 1; i < argc; ++i) {
+        AssetPack::Source src;
+        src.name = pack_name(argv[i]);
+        bool ok = (decode && is_image(src.name)) ? decode_pixels(argv[i], src) : read_bytes(argv[i], src);
+        if (!ok) {
+            std::cerr << "asset_pack: cannot read " << argv[i] << (decode ? std::string(": ") + IMG_GetError() : "") << "\n";
+            return EXIT_FAILURE;
+        }
+        if (src.kind == AssetPackKind::PIXELS) ++decoded;
+        sources.push_back(std::move(src));
+    }
+
+    if (!AssetPack::write(out_path, sources)) return EXIT_FAILURE;
+    std::cout << out_path << ": " << sources.size() << " files, " << decoded << " pre-decoded\n";
+    return EXIT_SUCCESS;
+}